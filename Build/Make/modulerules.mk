@@ -73,7 +73,8 @@ CPPFLAGS += \
 	$(WARNINGS) \
 
 CPPFLAGS += \
-    -std=c++11
+    -std=c++11 \
+    -pthread
 
 # Macros
 # Mkdir=if not exist @1 mkdir @1
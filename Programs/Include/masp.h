@@ -29,3 +29,8 @@
 #include "masp/Window.h"
 #include "masp/Resampler.h"
 #include "masp/Ft.h"
+#include "masp/Stft.h"
+#include "masp/Spectrum.h"
+#include "masp/Welch.h"
+#include "masp/SlidingDft.h"
+#include "masp/Correlation.h"
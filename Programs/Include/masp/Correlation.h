@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "types.h"
+#include "mcon.h"
+
+namespace masp {
+namespace corr {
+
+// How the correlation is evaluated. Method_Auto compares the number of
+// the multiplications of the direct sums with the cost of the FFTs and
+// takes the cheaper.
+enum Method
+{
+    Method_Auto,
+    Method_Direct,
+    Method_Fft,
+};
+
+// c[l - minLag] = sum_k x[k] y[k + l] for the lags l in [minLag,
+// maxLag], where the samples out of the signals are zeros. A negative
+// lag means y precedes x. The FFT is of the blocks of x with the zero
+// padding, the size of which is chosen by the cost.
+status_t CrossCorrelate(double c[], const double x[], size_t xLength, const double y[], size_t yLength, int minLag, int maxLag, Method method = Method_Auto);
+status_t CrossCorrelate(mcon::Vector<double>& c, const mcon::VectordBase& x, const mcon::VectordBase& y, int minLag, int maxLag, Method method = Method_Auto);
+// All the Nx + Ny - 1 lags [-(Nx - 1), Ny - 1].
+status_t CrossCorrelate(mcon::Vector<double>& c, const mcon::VectordBase& x, const mcon::VectordBase& y, Method method = Method_Auto);
+
+// r[l] = sum_k x[k] x[k + l] for the lags l in [0, maxLag], which is
+// r[-l] for the negative ones.
+status_t AutoCorrelate(double r[], const double x[], size_t length, size_t maxLag, Method method = Method_Auto);
+status_t AutoCorrelate(mcon::Vector<double>& r, const mcon::VectordBase& x, size_t maxLag, Method method = Method_Auto);
+
+} // namespace corr {
+} // namespace masp {
@@ -0,0 +1,139 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "types.h"
+#include "mcon.h"
+
+namespace masp {
+namespace spectrum {
+
+/*--------------------------------------------------------------------
+ * Goertzel
+ *
+ * The DFT at a few bins k of the length N, X(k) = sum_n x[n]
+ * e^(-j 2 pi k n / N), of a block of any number of samples, which are
+ * fed in chunks. k may be fractional. Each sample costs 1 multiply and
+ * 2 adds per bin by the second-order recursion, with the bins in the
+ * lanes of AVX.
+ *--------------------------------------------------------------------*/
+class Goertzel
+{
+public:
+    Goertzel(const double bins[], size_t binCount, size_t length);
+    ~Goertzel();
+
+    // Starts a new block.
+    void Reset(void);
+    // Feeds count samples following the previous ones of the block.
+    void Process(const double samples[], size_t count);
+    // The DFT of the samples fed since Reset(), GetBinCount() each.
+    void GetSpectrum(double real[], double imag[]) const;
+
+    inline size_t GetBinCount(void) const { return m_BinCount; }
+    inline size_t GetLength(void) const { return m_Length; }
+    inline size_t GetSampleCount(void) const { return m_SampleCount; }
+    inline bool IsNull(void) const { return 0 == m_BinCount || 0 == m_Length; }
+
+private:
+    Goertzel(const Goertzel&);
+    Goertzel& operator=(const Goertzel&);
+
+    size_t m_BinCount;
+    size_t m_Length;
+    size_t m_SampleCount;
+    mcon::Vector<double> m_Bins;
+    // 2 cos(w), cos(w) and sin(w) of w = 2 pi k / N, and the two latest
+    // states of the recursion, padded to the lanes.
+    mcon::Vector<double> m_Coefficients;
+    mcon::Vector<double> m_Cos;
+    mcon::Vector<double> m_Sin;
+    mcon::Vector<double> m_State1;
+    mcon::Vector<double> m_State2;
+};
+
+/*--------------------------------------------------------------------
+ * SlidingDft
+ *
+ * The DFT of the latest N samples at a few integer bins k, updated for
+ * every sample by X(k) <- (X(k) - x[n - N] + x[n]) e^(j 2 pi k / N) at
+ * the cost of one complex multiplication per bin, with the bins in the
+ * lanes of AVX. The oldest sample is at n = 0 of the DFT, as a frame
+ * of Stft. The rounding of the twiddles would make the recursion grow
+ * or decay without limit, so that the bins are recomputed from the
+ * ring buffer by Goertzel's each time N samples have been fed, which
+ * keeps the cost O(K) per sample on average.
+ *--------------------------------------------------------------------*/
+class SlidingDft
+{
+public:
+    // The real and the imaginary parts of GetBinCount() bins after the
+    // sample of sampleIndex, counted from 0 since Reset().
+    typedef void (*Callback)(const double real[], const double imag[], size_t sampleIndex, void* context);
+
+    // bins in [0, N).
+    SlidingDft(const size_t bins[], size_t binCount, size_t length);
+    ~SlidingDft();
+
+    // Starts a new stream as if N zeros preceded it.
+    void Reset(void);
+    // Feeds count samples, after which GetReal() and GetImag() are of
+    // the latest N samples.
+    void Process(const double samples[], size_t count);
+    // The same, calling callback for each sample.
+    void Process(const double samples[], size_t count, Callback callback, void* context);
+
+    inline const double* GetReal(void) const { return m_Real; }
+    inline const double* GetImag(void) const { return m_Imag; }
+    inline size_t GetBinCount(void) const { return m_BinCount; }
+    inline size_t GetLength(void) const { return m_Ring.GetLength(); }
+    // The number of the samples since Reset().
+    inline size_t GetSampleCount(void) const { return m_SampleCount; }
+    inline bool IsNull(void) const { return 0 == m_BinCount || 0 == GetLength(); }
+
+private:
+    SlidingDft(const SlidingDft&);
+    SlidingDft& operator=(const SlidingDft&);
+
+    void Update(double sample);
+    void Refresh(void);
+
+    size_t m_BinCount;
+    size_t m_SampleCount;
+    // cos and sin of 2 pi k / N, padded to the lanes.
+    mcon::Vector<double> m_Cos;
+    mcon::Vector<double> m_Sin;
+    mcon::Vector<double> m_Real;
+    mcon::Vector<double> m_Imag;
+    // The latest N samples, the oldest of which is at m_Position.
+    mcon::Vector<double> m_Ring;
+    size_t m_Position;
+    // Recomputes the bins from the ring buffer.
+    Goertzel* m_Goertzel;
+};
+
+} // namespace spectrum {
+} // namespace masp {
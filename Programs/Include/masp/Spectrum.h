@@ -0,0 +1,70 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "types.h"
+
+namespace masp {
+namespace spectrum {
+
+/*--------------------------------------------------------------------
+ * PolarFormat
+ *
+ * How the magnitude and the phase of the bins are written by
+ * ConvertToPolar() and ApplyPolarFormat(). The magnitude is multiplied
+ * by scale before decibel * log10(), so that 20 * log10(|X| / E) is
+ * given by scale = 1 / E and decibel = 20. The phase is by atan2(), in
+ * (-pi, pi] or (-180, 180].
+ *--------------------------------------------------------------------*/
+struct PolarFormat
+{
+    // |X|^2 instead of |X|.
+    bool isPower;
+    double scale;
+    // 10 or 20 for the decibels, 0 for the linear magnitude.
+    double decibel;
+    bool isDegree;
+
+    PolarFormat(void)
+        : isPower(false)
+        , scale(1.0)
+        , decibel(0.0)
+        , isDegree(false)
+    {}
+};
+
+// The magnitude and the phase of count bins in a single pass by AVX,
+// added to magnitude and phase with isAccumulated. Either of magnitude
+// and phase may be NULL to skip it. The buffers may be at any alignment.
+status_t ConvertToPolar(double magnitude[], double phase[], const double real[], const double imag[], size_t count, const PolarFormat& format = PolarFormat(), bool isAccumulated = false);
+
+// In place on the linear magnitude and the phase in radians, such as
+// the sums of the frames by ConvertToPolar(), which applies scale,
+// decibel and isDegree of format. isPower isn't referred.
+status_t ApplyPolarFormat(double magnitude[], double phase[], size_t count, const PolarFormat& format);
+
+} // namespace spectrum {
+} // namespace masp {
@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "mcon.h"
+#include "masp/Ft.h"
+
+namespace masp {
+namespace spectrum {
+
+/*--------------------------------------------------------------------
+ * Stft
+ *
+ * The short-time Fourier transform of a stream, which takes blocks of
+ * any size. The latest N samples are kept in a ring buffer, and a frame
+ * of them multiplied by the window is transformed every hop samples,
+ * the first one when N samples have arrived. A hop longer than N skips
+ * the samples between the frames. All the buffers are allocated at the
+ * construction, so that no frame allocates memory.
+ *
+ * The spectrum of a frame has the N/2 + 1 bins [0, N/2], or all the N
+ * bins with isFullLayout. It's by RealFftPlan for an even N and by
+ * FftPlan for an odd N.
+ *--------------------------------------------------------------------*/
+class Stft
+{
+public:
+    // The real and the imaginary parts of GetBinCount() bins of the
+    // frame of frameIndex, counted from 0 since Reset().
+    typedef void (*Callback)(const double real[], const double imag[], size_t frameIndex, void* context);
+
+    // window of N is copied. hop > 0.
+    Stft(const mcon::Vector<double>& window, size_t hop, bool isFullLayout = false);
+    ~Stft();
+
+    // Starts a new stream as if paddingLength zeros, less than N, preceded it.
+    void Reset(size_t paddingLength = 0);
+
+    // Consumes samples up to the next frame and advances samples and
+    // count past them. Returns true when a frame is transformed, which
+    // is in GetReal() and GetImag(), and false when count gets 0 before
+    // it. NULL as samples feeds count zeros, such as the padding at the
+    // end of a stream.
+    bool Next(const double*& samples, size_t& count);
+
+    // Feeds all the count samples, calling callback for each frame.
+    // Returns the number of the frames.
+    size_t Process(const double samples[], size_t count, Callback callback, void* context);
+
+    inline const double* GetReal(void) const { return m_Real; }
+    inline const double* GetImag(void) const { return m_Imag; }
+    inline size_t GetLength(void) const { return m_Window.GetLength(); }
+    inline size_t GetHop(void) const { return m_Hop; }
+    inline size_t GetBinCount(void) const { return m_IsFullLayout ? GetLength() : GetLength() / 2 + 1; }
+    // The number of the frames since Reset().
+    inline size_t GetFrameCount(void) const { return m_FrameCount; }
+    inline bool IsNull(void) const { return m_RealPlan.IsNull() && m_Plan.IsNull(); }
+
+private:
+    Stft(const Stft&);
+    Stft& operator=(const Stft&);
+
+    void Transform(void);
+
+    mcon::Vector<double> m_Window;
+    size_t m_Hop;
+    bool m_IsFullLayout;
+    // Either of them, by the parity of N.
+    ft::RealFftPlan m_RealPlan;
+    ft::FftPlan m_Plan;
+    // The latest N samples, the oldest of which is at m_Position.
+    mcon::Vector<double> m_Ring;
+    size_t m_Position;
+    // The samples to be fed until the next frame.
+    size_t m_Remaining;
+    size_t m_FrameCount;
+    mcon::Vector<double> m_Frame;
+    mcon::Vector<double> m_Real;
+    mcon::Vector<double> m_Imag;
+    mcon::Vector<double> m_Work;
+};
+
+} // namespace spectrum {
+} // namespace masp {
@@ -0,0 +1,117 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "types.h"
+#include "mcon.h"
+#include "masp/Ft.h"
+
+namespace masp {
+namespace spectrum {
+
+/*--------------------------------------------------------------------
+ * Welch
+ *
+ * The averaged periodogram of Welch's method. The signal is cut into
+ * the segments of the window length L, each hop = L - overlap samples
+ * from the previous one, and |X|^2 of the windowed segments is averaged
+ * without detrending. The samples after the last whole segment aren't
+ * used.
+ *
+ * The segments are shared by threads in blocks of consecutive ones,
+ * whose sums are added in the order of the blocks. The number of the
+ * blocks depends only on the number of the segments, so that the result
+ * is identical for any number of the threads.
+ *
+ * With Precision_Single, the segments are transformed in float, which
+ * is faster on the long windows at the relative error of about 1e-7 of
+ * the spectrum, below the noise floor of the most of the recordings.
+ * |X|^2 is summed in double in either precision.
+ *--------------------------------------------------------------------*/
+class Welch
+{
+public:
+    enum Scaling
+    {
+        // The power spectral density, |X|^2 / (fs sum w^2), in V^2/Hz.
+        Scaling_Density,
+        // The power spectrum, |X|^2 / (sum w)^2, in V^2.
+        Scaling_Power,
+        // The square root of the power spectrum, in V, which is the RMS
+        // of a sinusoid on a bin in the one-sided spectrum.
+        Scaling_Amplitude,
+    };
+
+    enum Precision
+    {
+        Precision_Double,
+        Precision_Single,
+    };
+
+    // window of L is copied. overlap < L. The one-sided spectrum has the
+    // L/2 + 1 bins [0, L/2], where the power of the bins other than 0 and
+    // the Nyquist frequency is doubled, and the two-sided one has L bins.
+    Welch(const mcon::Vector<double>& window, size_t overlap, Scaling scaling = Scaling_Density, bool isOneSided = true, Precision precision = Precision_Double);
+    ~Welch();
+
+    // The estimate of GetBinCount() from count samples, which are not
+    // less than L, at samplingRate, or from signal such as a row of a
+    // matrix. threadCount threads share the segments, and with 0 it's
+    // decided by the size. The raw samples take every argument, so that a
+    // vector and an integral samplingRate don't resolve to them.
+    status_t Estimate(mcon::Vector<double>& spectrum, const double samples[], size_t count, double samplingRate, size_t threadCount) const;
+    status_t Estimate(mcon::Vector<double>& spectrum, const mcon::VectordBase& signal, double samplingRate = 1.0, size_t threadCount = 0) const;
+
+    inline size_t GetLength(void) const { return m_Window.GetLength(); }
+    inline size_t GetOverlap(void) const { return m_Overlap; }
+    inline size_t GetHop(void) const { return GetLength() - m_Overlap; }
+    inline Scaling GetScaling(void) const { return m_Scaling; }
+    inline bool IsOneSided(void) const { return m_IsOneSided; }
+    inline Precision GetPrecision(void) const { return m_Precision; }
+    inline size_t GetBinCount(void) const { return m_IsOneSided ? GetLength() / 2 + 1 : GetLength(); }
+    // The number of the segments in count samples.
+    inline size_t GetSegmentCount(size_t count) const { return IsNull() || count < GetLength() ? 0 : (count - GetLength()) / GetHop() + 1; }
+    // True when L is 0 or overlap isn't less than L.
+    inline bool IsNull(void) const { return m_RealPlan.IsNull() && m_Plan.IsNull() && m_RealPlanf.IsNull() && m_Planf.IsNull(); }
+
+private:
+    Welch(const Welch&);
+    Welch& operator=(const Welch&);
+
+    mcon::Vector<double> m_Window;
+    size_t m_Overlap;
+    Scaling m_Scaling;
+    bool m_IsOneSided;
+    Precision m_Precision;
+    // One of them, by the parity of L and the precision.
+    ft::RealFftPlan m_RealPlan;
+    ft::FftPlan m_Plan;
+    ft::RealFftPlanf m_RealPlanf;
+    ft::FftPlanf m_Planf;
+};
+
+} // namespace spectrum {
+} // namespace masp {
@@ -26,3 +26,11 @@
 
 #include "mcon/Vector.h"
 #include "mcon/Matrix.h"
+#include "mcon/Toeplitz.h"
+#include "mcon/Qr.h"
+#include "mcon/Sparse.h"
+#include "mcon/Lu.h"
+#include "mcon/Cholesky.h"
+#include "mcon/Update.h"
+#include "mcon/Symmetric.h"
+#include "mcon/Parallel.h"
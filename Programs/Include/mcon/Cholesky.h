@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "debug.h"
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace mcon {
+
+/*--------------------------------------------------------------------
+ * Cholesky
+ *
+ * Cholesky decomposition of a symmetric positive definite matrix,
+ * A = U^T U, where U is upper triangular.
+ * The factor can be updated for A + x x^T and downdated for A - x x^T
+ * in O(n^2), instead of decomposing the new matrix in O(n^3).
+ *--------------------------------------------------------------------*/
+class Cholesky
+{
+public:
+    Cholesky();
+    ~Cholesky();
+
+    // Only the upper triangle of A is referred.
+    // Returns false when A is not square or not positive definite.
+    bool Factorize(const Matrix<double>& A);
+
+    // Solves A x = b.
+    bool Solve(Vector<double>& x, const VectordBase& b) const;
+
+    // A + x x^T
+    bool Update(const VectordBase& x);
+    // A - x x^T. Returns false, with the factor unchanged, when the
+    // result is not positive definite.
+    bool Downdate(const VectordBase& x);
+
+    // The upper triangular factor U, whose lower part is 0.
+    Matrix<double> GetU(void) const;
+
+    inline size_t GetLength(void) const { return m_Factor.GetRowLength(); }
+    inline bool IsNull(void) const { return m_Factor.IsNull(); }
+
+private:
+    Matrix<double> m_Factor;
+};
+
+} // namespace mcon {
@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "debug.h"
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace mcon {
+
+/*--------------------------------------------------------------------
+ * Lu
+ *
+ * LU decomposition with partial pivoting, P A = L U, for A x = b.
+ *
+ * With Precision_Mixed, A is decomposed in float, which has twice the
+ * SIMD lanes and half the memory traffic, and the solution is refined
+ * to the double accuracy by correcting it with the residual computed
+ * in double. When the refinement does not converge, A is decomposed
+ * again in double and the following solves use it.
+ *--------------------------------------------------------------------*/
+class Lu
+{
+public:
+    enum Precision
+    {
+        Precision_Double,
+        Precision_Mixed,
+    };
+
+    Lu();
+    ~Lu();
+
+    // Returns false when A is not square or singular.
+    bool Factorize(const Matrix<double>& A, Precision precision = Precision_Double);
+
+    // Solves A x = b. The number of the refinement steps is stored in
+    // pRefinementCount if not NULL, which is 0 in the double precision
+    // including the solve which falls back to it.
+    bool Solve(Vector<double>& x, const VectordBase& b, size_t* pRefinementCount = NULL);
+
+    // The precision actually used, which is Precision_Double after the
+    // fallback.
+    inline Precision GetPrecision(void) const { return m_Precision; }
+    inline size_t GetLength(void) const { return m_Length; }
+    inline bool IsNull(void) const { return 0 == m_Length; }
+
+private:
+    Lu(const Lu&);
+    Lu& operator=(const Lu&);
+
+    bool FactorizeDouble(void);
+    void Clear(void);
+
+    // The maximum number of the refinement steps before the fallback.
+    static const size_t g_MaxRefinementCount = 30;
+
+    Precision m_Precision;
+    size_t m_Length;
+    // ||A||_inf, which scales the tolerance of the residual.
+    double m_Norm;
+    // A is kept for the residuals of the refinement.
+    Matrix<double> m_Original;
+    Matrix<double> m_Factor;
+    Matrix<float> m_FactorSingle;
+    size_t* m_Pivots;
+};
+
+} // namespace mcon {
@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <cstring>
+#include <new>
+#include <stdint.h>
+
 #include "debug.h"
 #include "Vector.h"
 #include "Matrixd.h"
@@ -43,6 +47,10 @@ template <class Type> class Vector;
 
 /*--------------------------------------------------------------------
  * Matrix
+ *
+ * As Matrix<double> does, the descriptors of the rows and the rows
+ * padded to the alignment are placed in a single block, so Type must
+ * be copyable by memcpy.
  *--------------------------------------------------------------------*/
 template <class Type>
 class Matrix
@@ -72,13 +80,13 @@ public:
     const Vector<Type>& operator[](size_t i) const
     {
         ASSERT(i < m_RowLength);
-        return *m_Array[i];
+        return m_Array[i];
     }
 
     Vector<Type>& operator[](size_t i)
     {
         ASSERT(i < m_RowLength);
-        return *m_Array[i];
+        return m_Array[i];
     }
 
     Matrix<Type>& operator=(const Matrix<Type>& m);
@@ -156,65 +164,97 @@ public:
     bool Resize(size_t, size_t);
 private:
     // Member functions (private).
-    void AllocateRow   (void);
-    void AllocateColumn(void);
-    void Allocate      (void);
+    bool Allocate(void);
+    void Release (void);
+    // The number of elements between the heads of two rows.
+    inline size_t GetStride(void) const
+    {
+        const size_t unit = (g_Alignment % sizeof(Type)) ? 1 : g_Alignment / sizeof(Type);
+        return ((m_ColumnLength + (unit - 1)) / unit) * unit;
+    }
     inline size_t Smaller(size_t length) const { return (length > m_RowLength) ? m_RowLength : length; };
 
+    // Class variables (private).
+    static const size_t g_Alignment = 32;
+
     // Member variables (private).
     size_t m_RowLength;
     size_t m_ColumnLength;
-    Vector<Type>** m_Array;
+    void* m_Address;
+    Vector<Type>* m_Array;
+    Type* m_Buffer;
 };
 
 
 template <class Type>
-void Matrix<Type>::Allocate(void)
+bool Matrix<Type>::Allocate(void)
 {
-    AllocateRow();
-    AllocateColumn();
-}
-
-template <class Type>
-void Matrix<Type>::AllocateRow(void)
-{
-    if (0 < m_RowLength)
+    if (0 == m_RowLength)
+    {
+        return true;
+    }
+    const size_t size = m_RowLength * sizeof(Vector<Type>)
+                      + (g_Alignment - 1)
+                      + GetStride() * m_RowLength * sizeof(Type);
+    m_Address = reinterpret_cast<void*>(new uint8_t[size]);
+    if (NULL == m_Address)
     {
-        m_Array = new Vector<Type>*[m_RowLength];
-        ASSERT(NULL != m_Array);
+        return false;
     }
+    m_Array = reinterpret_cast<Vector<Type>*>(m_Address);
+    uintptr_t buffer = reinterpret_cast<uintptr_t>(m_Array + m_RowLength);
+    buffer = (buffer + (g_Alignment - 1)) & ~static_cast<uintptr_t>(g_Alignment - 1);
+    m_Buffer = reinterpret_cast<Type*>(buffer);
+    for (size_t k = 0; k < m_RowLength; ++k)
+    {
+        new (m_Array + k) Vector<Type>(m_Buffer + GetStride() * k, m_ColumnLength);
+    }
+    return true;
 }
 
 template <class Type>
-void Matrix<Type>::AllocateColumn(void)
+void Matrix<Type>::Release(void)
 {
-    for (size_t i = 0; i < m_RowLength; ++i)
+    if (NULL != m_Address)
     {
-        m_Array[i] = new Vector<Type>(m_ColumnLength);
-        ASSERT(m_Array[i] != NULL);
+        for (size_t k = 0; k < m_RowLength; ++k)
+        {
+            m_Array[k].~Vector<Type>();
+        }
+        delete[] reinterpret_cast<uint8_t*>(m_Address);
     }
+    m_Address = NULL;
+    m_Array = NULL;
+    m_Buffer = NULL;
 }
 
 template <class Type>
 Matrix<Type>::Matrix(int rowLength, int columnLength)
     : m_RowLength(rowLength),
     m_ColumnLength(columnLength),
-    m_Array(NULL)
+    m_Address(NULL),
+    m_Array(NULL),
+    m_Buffer(NULL)
 {
-    Allocate();
+    bool status = Allocate();
+    UNUSED(status);
+    ASSERT(true == status);
 }
 
 template <class Type>
 Matrix<Type>::Matrix(const Matrix<Type>& m)
     : m_RowLength(m.GetRowLength()),
     m_ColumnLength(m.GetColumnLength()),
-    m_Array(NULL)
+    m_Address(NULL),
+    m_Array(NULL),
+    m_Buffer(NULL)
 {
-    AllocateRow();
-    for (size_t i = 0; i < m_RowLength; ++i)
+    bool status = Allocate();
+    UNUSED(status);
+    ASSERT(true == status);
+    if (NULL != m_Buffer)
     {
-        m_Array[i] = new Vector<Type>(m[i]);
-        ASSERT(m_Array[i] != NULL);
+        std::memcpy(m_Buffer, m.m_Buffer, GetStride() * m_RowLength * sizeof(Type));
     }
 }
 
@@ -223,28 +263,26 @@ template <typename U>
 Matrix<Type>::Matrix(const Matrix<U>& m)
     : m_RowLength(m.GetRowLength()),
     m_ColumnLength(m.GetColumnLength()),
-    m_Array(NULL)
+    m_Address(NULL),
+    m_Array(NULL),
+    m_Buffer(NULL)
 {
-    AllocateRow();
+    bool status = Allocate();
+    UNUSED(status);
+    ASSERT(true == status);
     for (size_t i = 0; i < m_RowLength; ++i)
     {
-        m_Array[i] = new Vector<Type>(m[i]);
-        ASSERT(m_Array[i] != NULL);
+        for (size_t j = 0; j < m_ColumnLength; ++j)
+        {
+            m_Array[i][j] = static_cast<Type>(m[i][j]);
+        }
     }
 }
 
 template <class Type>
 Matrix<Type>::~Matrix()
 {
-    if (m_Array != NULL)
-    {
-        for (size_t i = 0; i < m_RowLength; ++i)
-        {
-            delete m_Array[i];
-        }
-        delete[] m_Array;
-    }
-    m_Array = NULL;
+    Release();
     m_RowLength = 0;
     m_ColumnLength = 0;
 }
@@ -253,72 +291,56 @@ template <class Type>
 Matrix<Type>::Matrix(const Matrixd& m)
     : m_RowLength(m.GetRowLength()),
     m_ColumnLength(m.GetColumnLength()),
-    m_Array(NULL)
+    m_Address(NULL),
+    m_Array(NULL),
+    m_Buffer(NULL)
 {
-    AllocateRow();
-    for (size_t i = 0; i < m_RowLength; ++i)
+    bool status = Allocate();
+    UNUSED(status);
+    ASSERT(true == status);
+    for (size_t r = 0; r < GetRowLength(); ++r)
     {
-        m_Array[i] = new Vector<Type>(m[i]);
-        ASSERT(m_Array[i] != NULL);
-    }
-    for ( int r = 0; r < GetRowLength(); ++r )
-    {
-        (*this)[r] = m[r];
+        m_Array[r] = m[r];
     }
 }
 
+// The elements are kept when only the row length is changed.
 template <class Type>
 bool Matrix<Type>::Resize(size_t rowLength, size_t columnLength)
 {
-    if (rowLength < 0 || columnLength < 0)
+    if (rowLength == m_RowLength && columnLength == m_ColumnLength)
     {
-        return false;
+        return true;
     }
-
-    if (rowLength != m_RowLength)
+    if (columnLength != m_ColumnLength)
     {
-        Vector<Type>** ptr = NULL;
-        if (rowLength > 0)
-        {
-            ptr = new Vector<Type>*[rowLength];
-            ASSERT(NULL != ptr);
-            for (size_t i = 0; i < rowLength; ++i)
-            {
-                ptr[i] = NULL;
-            }
-        }
-
-        for (size_t i = 0; i < Smaller(rowLength); ++i)
-        {
-            ptr[i] = m_Array[i];
-            m_Array[i] = NULL;
-        }
-        for (size_t i = 0; i < rowLength; ++i)
-        {
-            if (ptr[i] == NULL)
-            {
-                ptr[i] = new Vector<Type>(columnLength);
-                ASSERT(ptr[i] != NULL);
-            }
-        }
-        for (size_t i = 0; i < m_RowLength; ++i)
-        {
-            if (m_Array[i] != NULL)
-            {
-                delete m_Array[i];
-                m_Array[i] = NULL;
-            }
-        }
-        delete[] m_Array;
-        m_Array = ptr;
+        Release();
         m_RowLength = rowLength;
+        m_ColumnLength = columnLength;
+        return Allocate();
     }
-    m_ColumnLength = columnLength;
+    void* address = m_Address;
+    Vector<Type>* array = m_Array;
+    Type* buffer = m_Buffer;
+    const size_t rows = Smaller(rowLength);
+    const size_t rowLengthOld = m_RowLength;
 
-    bool status = true;
-    for (size_t i = 0; i < m_RowLength; ++i)
+    m_RowLength = rowLength;
+    m_Address = NULL;
+    m_Array = NULL;
+    m_Buffer = NULL;
+    const bool status = Allocate();
+    if (status && NULL != buffer)
     {
-        status &= (*m_Array[i]).Resize(m_ColumnLength);
+        std::memcpy(m_Buffer, buffer, GetStride() * rows * sizeof(Type));
+    }
+    if (NULL != address)
+    {
+        for (size_t k = 0; k < rowLengthOld; ++k)
+        {
+            array[k].~Vector<Type>();
+        }
+        delete[] reinterpret_cast<uint8_t*>(address);
     }
     return status;
 }
@@ -326,10 +348,20 @@ bool Matrix<Type>::Resize(size_t rowLength, size_t columnLength)
 template <class Type>
 Matrix<Type>& Matrix<Type>::operator=(const Matrix<Type>& m)
 {
-    Resize(m.GetRowLength(), m.GetColumnLength());
-    for (size_t i = 0; i < m_RowLength; ++i)
+    if (this == &m)
+    {
+        return *this;
+    }
+    if (m.GetRowLength() != m_RowLength || m.GetColumnLength() != m_ColumnLength)
+    {
+        Release();
+        m_RowLength = m.GetRowLength();
+        m_ColumnLength = m.GetColumnLength();
+        Allocate();
+    }
+    if (NULL != m_Buffer)
     {
-        *m_Array[i] = m[i];
+        std::memcpy(m_Buffer, m.m_Buffer, GetStride() * m_RowLength * sizeof(Type));
     }
     return *this;
 }
@@ -340,7 +372,7 @@ Matrix<Type>& Matrix<Type>::operator=(const Matrixd& m)
     Resize(m.GetRowLength(), m.GetColumnLength());
     for (size_t i = 0; i < m_RowLength; ++i)
     {
-        *m_Array[i] = m[i];
+        m_Array[i] = m[i];
     }
     return *this;
 }
@@ -367,16 +399,19 @@ Matrix<Type> Matrix<Type>::Multiply(const Matrix<Type>& m) const
         return *this;
     }
     Matrix<Type> multiplied(GetRowLength(), m.GetColumnLength());
+    multiplied = 0;
+    // The rows of m are traversed contiguously.
     for (size_t row = 0; row < multiplied.GetRowLength(); ++row)
     {
-        for (size_t col = 0; col < multiplied.GetColumnLength(); ++col)
+        Vector<Type>& dst = multiplied[row];
+        for (size_t k = 0; k < GetColumnLength(); ++k)
         {
-            Type v = 0;
-            for (size_t k = 0; k < GetColumnLength(); ++k)
+            const Type a = (*this)[row][k];
+            const Vector<Type>& src = m[k];
+            for (size_t col = 0; col < multiplied.GetColumnLength(); ++col)
             {
-                v += (*this)[row][k] * m[k][col];
+                dst[col] += a * src[col];
             }
-            multiplied[row][col] = v;
         }
     }
     return multiplied;
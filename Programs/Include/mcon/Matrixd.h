@@ -35,6 +35,8 @@ namespace mcon {
 // こんなんしたい
 // typedef Matrix<double>(1, n) Vectord(n);
 
+class TransposedMatrixd;
+
 /*--------------------------------------------------------------------
  * Matrix<double>
  *--------------------------------------------------------------------*/
@@ -165,8 +167,16 @@ public:
     Matrix<double>& operator/=(const Matrix<double>& m);
 
     double Determinant(void) const;
-    Matrix<double> Transpose(void) const;
+    // Threads are used when threadCount > 1. With 0, it's decided by the size.
+    Matrix<double> Transpose(size_t threadCount = 0) const;
+    // Same as above into transposed, which is resized only when its size
+    // differs. Returns false for a null matrix or transposed being this.
+    bool Transpose(Matrix<double>& transposed, size_t threadCount = 0) const;
+    // Transposes a square matrix in-place. Returns false if not square.
+    bool TransposeSelf(void);
     Matrix<double> Multiply(const Matrix<double>& m) const;
+    // this * m^T without transposing m.
+    Matrix<double> Multiply(const TransposedMatrixd& m) const;
     Matrix<double> Inverse(void) const;
     Matrix<double> GetCofactorMatrix(size_t row, size_t col) const;
     double GetCofactor(size_t row, size_t col) const;
@@ -182,7 +192,8 @@ public:
     inline size_t GetColumnLength(void) const { return m_ColumnLength; }
 
     // Aliases
-    inline Matrix<double> T(void) const { return Transpose(); }
+    // Returns a lazy handle, which is materialized by assignment.
+    inline TransposedMatrixd T(void) const;
     inline Matrix<double> I(void) const { return Inverse(); }
     inline double  D(void) const { return Determinant(); }
     inline static Matrix<double> E(size_t size) { return Identify(size); }
@@ -200,9 +211,78 @@ private:
     VectordBase* m_ObjectBase;
 };
 
+/*--------------------------------------------------------------------
+ * TransposedMatrixd
+ *
+ * The transpose of a Matrix<double> without copying, which is returned
+ * by Matrix<double>::T(). Multiply() and Gemv() consume it directly by
+ * switching the access pattern, and it's materialized only when it's
+ * assigned to a Matrix<double>.
+ * It refers to the original, so it must not outlive the original.
+ *--------------------------------------------------------------------*/
+class TransposedMatrixd
+{
+public:
+    explicit TransposedMatrixd(const Matrix<double>& m)
+        : m_Original(m)
+    {
+    }
+
+    // Materialization.
+    operator Matrix<double>() const { return m_Original.Transpose(); }
+
+    // Element access, A^T[row][column].
+    inline double operator()(size_t row, size_t column) const
+    {
+        return m_Original[column][row];
+    }
+
+    // this * m without transposing the original.
+    Matrix<double> Multiply(const Matrix<double>& m) const;
+    // this * m^T, which is (m * original)^T.
+    Matrix<double> Multiply(const TransposedMatrixd& m) const;
+
+    inline const Matrix<double>& GetOriginal(void) const { return m_Original; }
+    inline bool IsNull(void) const { return m_Original.IsNull(); }
+    inline size_t GetRowLength(void) const { return m_Original.GetColumnLength(); }
+    inline size_t GetColumnLength(void) const { return m_Original.GetRowLength(); }
+
+    // Aliases
+    inline const Matrix<double>& T(void) const { return m_Original; }
+    inline Matrix<double> Transpose(void) const { return m_Original; }
+
+private:
+    const Matrix<double>& m_Original;
+};
+
+inline TransposedMatrixd Matrix<double>::T(void) const { return TransposedMatrixd(*this); }
+
 // Type definition.
 typedef Matrix<double> Matrixd;
 
+/*--------------------------------------------------------------------
+ * BLAS-like operations on Matrixd/VectordBase
+ *
+ * All of them work in-place without any temporaries, and return false
+ * if the sizes don't match. The output must not alias the inputs.
+ *--------------------------------------------------------------------*/
+
+// y = alpha * x + y
+bool Axpy(VectordBase& y, double alpha, const VectordBase& x);
+
+// y = alpha * A * x + beta * y
+bool Gemv(VectordBase& y, const Matrix<double>& A, const VectordBase& x, double alpha = 1.0, double beta = 0.0);
+bool Gemv(VectordBase& y, const TransposedMatrixd& A, const VectordBase& x, double alpha = 1.0, double beta = 0.0);
+
+// A = alpha * x * y^T + A
+bool Ger(Matrix<double>& A, double alpha, const VectordBase& x, const VectordBase& y);
+
+// A = alpha * x * x^T + A, which keeps a symmetric A exactly symmetric.
+bool Syr(Matrix<double>& A, double alpha, const VectordBase& x);
+
+// A = alpha * (x * y^T + y * x^T) + A, which keeps a symmetric A exactly symmetric.
+bool Syr2(Matrix<double>& A, double alpha, const VectordBase& x, const VectordBase& y);
+
 // Global operators.
 MACRO_MCON_GLOBAL_OPERATOR_DEFINITION(Matrix<double>, double)
 
@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+namespace mcon {
+
+/*--------------------------------------------------------------------
+ * Parallel ranges
+ *
+ * The multithreaded routines of mcon and masp split [0, count) into
+ * contiguous ranges, one for each thread. The last range is processed
+ * on the calling thread.
+ *--------------------------------------------------------------------*/
+
+// threadCount when it isn't 0. Otherwise 1 for a size below threshold,
+// and the hardware concurrency from threshold.
+inline size_t GetThreadCount(size_t threadCount, size_t size, size_t threshold)
+{
+    if ( 0 != threadCount )
+    {
+        return threadCount;
+    }
+    return size < threshold ? 1 : std::max(1U, std::thread::hardware_concurrency());
+}
+
+// Calls function(context, begin, end) on threadCount contiguous ranges
+// of [0, count), no more than count of them.
+template <typename Context>
+void ForRanges(void (*function)(const Context&, size_t, size_t), const Context& context, size_t count, size_t threadCount)
+{
+    threadCount = std::max(static_cast<size_t>(1), std::min(threadCount, count));
+    if ( 1 == threadCount )
+    {
+        function(context, 0, count);
+        return;
+    }
+    std::thread* threads = new std::thread[threadCount - 1];
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        const size_t begin = count * t / threadCount;
+        const size_t end = count * (t + 1) / threadCount;
+        if ( t + 1 < threadCount )
+        {
+            threads[t] = std::thread(function, std::cref(context), begin, end);
+        }
+        else
+        {
+            function(context, begin, end);
+        }
+    }
+    for (size_t t = 0; t + 1 < threadCount; ++t)
+    {
+        threads[t].join();
+    }
+    delete[] threads;
+}
+
+// Stores the result of function(context, begin, end) to *pResult.
+template <typename Context>
+void StoreRangeResult(int (*function)(const Context&, size_t, size_t), const Context& context, size_t begin, size_t end, int* pResult)
+{
+    *pResult = function(context, begin, end);
+}
+
+// Same as above for a function which returns a status. Returns the first
+// of the statuses in the order of the ranges which isn't 0, or 0.
+template <typename Context>
+int ForRanges(int (*function)(const Context&, size_t, size_t), const Context& context, size_t count, size_t threadCount)
+{
+    threadCount = std::max(static_cast<size_t>(1), std::min(threadCount, count));
+    if ( 1 == threadCount )
+    {
+        return function(context, 0, count);
+    }
+    std::thread* threads = new std::thread[threadCount - 1];
+    int* results = new int[threadCount];
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        const size_t begin = count * t / threadCount;
+        const size_t end = count * (t + 1) / threadCount;
+        if ( t + 1 < threadCount )
+        {
+            threads[t] = std::thread(StoreRangeResult<Context>, function, std::cref(context), begin, end, results + t);
+        }
+        else
+        {
+            results[t] = function(context, begin, end);
+        }
+    }
+    int result = 0;
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        if ( t + 1 < threadCount )
+        {
+            threads[t].join();
+        }
+        if ( 0 == result )
+        {
+            result = results[t];
+        }
+    }
+    delete[] threads;
+    delete[] results;
+    return result;
+}
+
+} // namespace mcon {
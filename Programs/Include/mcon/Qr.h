@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "debug.h"
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace mcon {
+
+/*--------------------------------------------------------------------
+ * Qr
+ *
+ * Householder QR decomposition of an M x N matrix A (M >= N) for the
+ * least squares problem, min ||A x - b||.
+ * Unlike the normal equation, A^T A is never formed, so the condition
+ * number is not squared.
+ *
+ * The reflectors are applied in panels of columns as compact WY
+ * blocks, I - V T V^T. A tall-skinny A is split into blocks of rows
+ * which are decomposed in parallel, and then their R factors are
+ * stacked and decomposed again (TSQR).
+ *--------------------------------------------------------------------*/
+class Qr
+{
+public:
+    Qr();
+    ~Qr();
+
+    // Decomposes A. threadCount is the number of row blocks of TSQR,
+    // which is chosen by the size of A when 0 is given.
+    // Returns false when A is null or has less rows than columns.
+    bool Factorize(const Matrix<double>& A, size_t threadCount = 0);
+    // Decomposes A = B^T without transposing B.
+    bool Factorize(const TransposedMatrixd& A, size_t threadCount = 0);
+
+    // Solves min ||A x - b||. The residual norm is stored in pResidual
+    // if not NULL. Returns false when A is rank deficient.
+    bool Solve(Vector<double>& x, const VectordBase& b, double* pResidual = NULL) const;
+
+    // The upper triangular N x N matrix R.
+    Matrix<double> GetR(void) const;
+
+    // Whether all of |R[k][k]| are larger than the rank tolerance.
+    bool IsFullRank(void) const;
+
+    inline size_t GetRowLength(void) const { return m_RowLength; }
+    inline size_t GetColumnLength(void) const { return m_ColumnLength; }
+    inline size_t GetBlockCount(void) const { return 0 == m_BlockCount ? 1 : m_BlockCount; }
+    inline bool IsNull(void) const { return m_Factor.IsNull(); }
+
+private:
+    Qr(const Qr&);
+    Qr& operator=(const Qr&);
+
+    // Decomposes m_Factor, which holds A^T, in place.
+    bool Decompose(size_t threadCount);
+    void DecomposeBlocked(void);
+    // Decomposes the rows [begin, end) of A as one of the TSQR blocks.
+    void DecomposeBlock(const Matrix<double>& At, size_t begin, size_t end);
+    // Decomposes the TSQR blocks [begin, end) of qr, one of the ranges of
+    // the threads.
+    static void DecomposeBlocks(const Qr& qr, size_t begin, size_t end);
+    // c = Q^T c, where c has as many elements as the rows of m_Factor's A.
+    void ApplyTransposedQ(double* c) const;
+    void Clear(void);
+
+    // Row j holds the j-th column of A. After the decomposition,
+    // R[k][j] = m_Factor[j][k] for k < j and m_Factor[j][j:] is the j-th
+    // Householder vector, while the diagonal of R is kept apart.
+    Matrix<double> m_Factor;
+    Vector<double> m_Tau;
+    Vector<double> m_Diagonal;
+    size_t m_RowLength;
+    size_t m_ColumnLength;
+
+    // TSQR blocks, where m_Factor holds the stacked R factors of them.
+    Qr* m_Blocks;
+    size_t m_BlockCount;
+};
+
+} // namespace mcon {
@@ -0,0 +1,143 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "debug.h"
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace mcon {
+
+class ToeplitzOperator;
+
+/*--------------------------------------------------------------------
+ * Diagonal
+ *
+ * An N x N diagonal matrix, of which only the diagonal is stored.
+ *--------------------------------------------------------------------*/
+class Diagonal
+{
+public:
+    explicit Diagonal(size_t length = 0);
+    Diagonal(const VectordBase& d);
+    Diagonal(const Diagonal& d);
+    ~Diagonal();
+
+    Diagonal& operator=(const Diagonal& d);
+
+    // Element access, D[row][column].
+    inline double operator()(size_t row, size_t column) const
+    {
+        ASSERT(row < GetLength() && column < GetLength());
+        return row == column ? m_Diagonal[row] : 0.0;
+    }
+    inline const VectordBase& GetDiagonal(void) const { return m_Diagonal; }
+    inline VectordBase& GetDiagonal(void) { return m_Diagonal; }
+
+    // y = D x.
+    Vector<double> Multiply(const VectordBase& x) const;
+    // D A, which scales the rows of A.
+    Matrix<double> Multiply(const Matrix<double>& A) const;
+    // A D A^T, where A is M x N. Only a triangle is computed.
+    Matrix<double> MultiplyGram(const Matrix<double>& A) const;
+
+    // Expands to a dense matrix.
+    Matrix<double> ToMatrix(void) const;
+
+    bool Resize(size_t length) { return m_Diagonal.Resize(length); }
+
+    inline size_t GetLength(void) const { return m_Diagonal.GetLength(); }
+    inline bool IsNull(void) const { return m_Diagonal.IsNull(); }
+
+private:
+    Vector<double> m_Diagonal;
+};
+
+/*--------------------------------------------------------------------
+ * SparseMatrix
+ *
+ * An M x N matrix in the compressed sparse row (CSR) format.
+ * The non-zero elements are appended in the row major order.
+ *--------------------------------------------------------------------*/
+class SparseMatrix
+{
+public:
+    SparseMatrix(size_t rowLength = 0, size_t columnLength = 0);
+    // Drops the elements whose absolute values are not larger than threshold.
+    explicit SparseMatrix(const Matrix<double>& m, double threshold = 0.0);
+    SparseMatrix(const SparseMatrix& m);
+    ~SparseMatrix();
+
+    SparseMatrix& operator=(const SparseMatrix& m);
+
+    // Element access, A[row][column], in O(log(non-zeros in the row)).
+    double operator()(size_t row, size_t column) const;
+
+    // Appends A[row][column] = value. Returns false when the position
+    // is out of range or not after the last appended one.
+    bool Append(size_t row, size_t column, double value);
+
+    // y = A x, where x has N elements and y has M elements.
+    Vector<double> Multiply(const VectordBase& x) const;
+    // y = A^T x, where x has M elements and y has N elements.
+    Vector<double> MultiplyTransposed(const VectordBase& x) const;
+    // A B, where B has N rows.
+    Matrix<double> Multiply(const Matrix<double>& B) const;
+    // B A B^T, where A is N x N and B is K x N.
+    Matrix<double> MultiplyGram(const Matrix<double>& B) const;
+    // The same of a Toeplitz or Hankel operator B in O(K^2 nnz), reading
+    // its signal for each non-zero element instead of forming B.
+    Matrix<double> MultiplyGram(const ToeplitzOperator& B) const;
+
+    // Expands to a dense matrix.
+    Matrix<double> ToMatrix(void) const;
+
+    inline size_t GetNonZeroCount(void) const { return m_Count; }
+    inline size_t GetRowLength(void) const { return m_RowLength; }
+    inline size_t GetColumnLength(void) const { return m_ColumnLength; }
+    inline bool IsNull(void) const { return 0 == m_RowLength || 0 == m_ColumnLength; }
+
+private:
+    bool Allocate(size_t rowLength, size_t columnLength, size_t capacity);
+    void Release(void);
+    bool Reserve(size_t capacity);
+    // Row r has the elements [GetRowBegin(r), GetRowEnd(r)), where the
+    // rows after the last appended one are empty.
+    inline size_t GetRowBegin(size_t r) const { return r <= m_LastRow ? m_RowOffsets[r] : m_Count; }
+    inline size_t GetRowEnd(size_t r) const { return r < m_LastRow ? m_RowOffsets[r + 1] : m_Count; }
+
+    size_t m_RowLength;
+    size_t m_ColumnLength;
+    size_t m_Count;
+    size_t m_Capacity;
+    size_t m_LastRow;
+    size_t* m_RowOffsets;
+    size_t* m_Columns;
+    double* m_Values;
+};
+
+} // namespace mcon {
@@ -0,0 +1,97 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "debug.h"
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace mcon {
+
+/*--------------------------------------------------------------------
+ * SymmetricMatrix
+ *
+ * An N x N symmetric matrix, of which only the upper triangle is stored
+ * in the packed format. The row i holds the columns [i, N) and follows
+ * the row i - 1, so that N (N + 1) / 2 elements are stored.
+ *--------------------------------------------------------------------*/
+class SymmetricMatrix
+{
+public:
+    explicit SymmetricMatrix(size_t length = 0);
+    // Only the upper triangle of m is referred.
+    explicit SymmetricMatrix(const Matrix<double>& m);
+    SymmetricMatrix(const SymmetricMatrix& m);
+    ~SymmetricMatrix();
+
+    SymmetricMatrix& operator=(const SymmetricMatrix& m);
+    SymmetricMatrix& operator=(double v);
+
+    // Element access, A[row][column] = A[column][row].
+    inline double operator()(size_t row, size_t column) const
+    {
+        ASSERT(row < GetLength() && column < GetLength());
+        return row <= column ? m_Packed[GetOffset(row) + column] : m_Packed[GetOffset(column) + row];
+    }
+    inline double& operator()(size_t row, size_t column)
+    {
+        ASSERT(row < GetLength() && column < GetLength());
+        return row <= column ? m_Packed[GetOffset(row) + column] : m_Packed[GetOffset(column) + row];
+    }
+    // The upper part of the row, A[row][row] to A[row][N - 1].
+    inline const double* GetRow(size_t row) const { return &m_Packed[GetOffset(row) + row]; }
+    inline double* GetRow(size_t row) { return &m_Packed[GetOffset(row) + row]; }
+
+    // y = A x.
+    Vector<double> Multiply(const VectordBase& x) const;
+
+    // Solves A x = b by the Cholesky decomposition in the packed format.
+    // Returns false when A is not positive definite.
+    bool Solve(Vector<double>& x, const VectordBase& b) const;
+
+    // Expands to a dense matrix.
+    Matrix<double> ToMatrix(void) const;
+
+    bool Resize(size_t length);
+
+    inline size_t GetLength(void) const { return m_Length; }
+    inline bool IsNull(void) const { return 0 == m_Length; }
+
+private:
+    // The position of A[row][0], as if the lower part were stored.
+    inline size_t GetOffset(size_t row) const { return row * m_Length - row * (row + 1) / 2; }
+
+    size_t m_Length;
+    Vector<double> m_Packed;
+};
+
+// C = alpha A A^T + beta C, where A is N x K.
+// Only the upper triangle is computed, with about a half of the flops
+// of A.Multiply(A.T()).
+bool Syrk(SymmetricMatrix& C, const Matrix<double>& A, double alpha = 1.0, double beta = 0.0);
+
+} // namespace mcon {
@@ -0,0 +1,152 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "debug.h"
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace mcon {
+
+class Diagonal;
+
+/*--------------------------------------------------------------------
+ * Toeplitz
+ *
+ * A symmetric Toeplitz matrix defined by its first row, r.
+ *     T[i][j] = r[|i - j|]
+ * Only the first row is stored, so memory is O(n) instead of O(n^2).
+ *--------------------------------------------------------------------*/
+class Toeplitz
+{
+public:
+    explicit Toeplitz(size_t length = 0);
+    Toeplitz(const VectordBase& r);
+    Toeplitz(const Toeplitz& t);
+    ~Toeplitz();
+
+    Toeplitz& operator=(const Toeplitz& t);
+
+    // Element access, T[row][column].
+    inline double operator()(size_t row, size_t column) const
+    {
+        ASSERT(row < GetLength() && column < GetLength());
+        return m_Row[ row < column ? column - row : row - column ];
+    }
+    // The first row, which defines the matrix.
+    inline const VectordBase& GetRow(void) const { return m_Row; }
+    inline VectordBase& GetRow(void) { return m_Row; }
+
+    // Solves T x = b by Levinson-Durbin recursion in O(n^2).
+    // Returns false when T is not positive definite.
+    bool Solve(Vector<double>& x, const VectordBase& b) const;
+
+    // Solves T x = b by conjugate gradients preconditioned with T. Chan's
+    // optimal circulant, where each iteration costs O(n log n) with FFTs.
+    // It stops when ||b - T x|| / ||b|| < tolerance or after maxIteration
+    // iterations (n when 0 is given). Returns false if not converged.
+    bool SolveSuperfast(
+        Vector<double>& x,
+        const VectordBase& b,
+        double tolerance = 1.0e-10,
+        size_t maxIteration = 0
+    ) const;
+
+    // y = T x.
+    Vector<double> Multiply(const VectordBase& x) const;
+
+    // Expands to a dense matrix.
+    Matrix<double> ToMatrix(void) const;
+
+    bool Resize(size_t length) { return m_Row.Resize(length); }
+
+    inline size_t GetLength(void) const { return m_Row.GetLength(); }
+    inline bool IsNull(void) const { return m_Row.IsNull(); }
+
+private:
+    Vector<double> m_Row;
+};
+
+/*--------------------------------------------------------------------
+ * ToeplitzOperator
+ *
+ * An M x N matrix generated by a signal u, whose elements are never
+ * stored.
+ *     Toeplitz: A[m][n] = u[n - m]
+ *     Hankel  : A[m][n] = u[n + m]
+ * u is regarded as 0 outside of its range. The Toeplitz one is Ut of
+ * the normal equation built from the shifted input signal.
+ *--------------------------------------------------------------------*/
+class ToeplitzOperator
+{
+public:
+    ToeplitzOperator(const VectordBase& u, size_t rowLength, size_t columnLength, bool isHankel = false);
+    ToeplitzOperator(const ToeplitzOperator& t);
+    ~ToeplitzOperator();
+
+    ToeplitzOperator& operator=(const ToeplitzOperator& t);
+
+    // Element access, A[row][column].
+    inline double operator()(size_t row, size_t column) const
+    {
+        ASSERT(row < GetRowLength() && column < GetColumnLength());
+        return m_IsHankel ? GetSample(column + row)
+            : GetSample(static_cast<ptrdiff_t>(column) - static_cast<ptrdiff_t>(row));
+    }
+
+    // y = A x, where x has N elements and y has M elements.
+    Vector<double> Multiply(const VectordBase& x) const;
+    // y = A^T x, where x has M elements and y has N elements.
+    Vector<double> MultiplyTransposed(const VectordBase& x) const;
+    // G = A A^T in O(MN + M^2) with sliding dot products.
+    Matrix<double> Gram(void) const;
+    // G = A W A^T for a diagonal W of N in O(M^2 N / 2), reading u for
+    // each element. A null matrix when the length of W isn't N.
+    Matrix<double> Gram(const Diagonal& W) const;
+
+    // Expands to a dense matrix.
+    Matrix<double> ToMatrix(void) const;
+
+    inline const VectordBase& GetSignal(void) const { return m_Signal; }
+    inline size_t GetRowLength(void) const { return m_RowLength; }
+    inline size_t GetColumnLength(void) const { return m_ColumnLength; }
+    inline bool IsHankel(void) const { return m_IsHankel; }
+    inline bool IsNull(void) const { return 0 == m_RowLength || 0 == m_ColumnLength; }
+
+private:
+    inline double GetSample(ptrdiff_t k) const
+    {
+        return (k < 0 || static_cast<size_t>(k) >= m_Signal.GetLength()) ? 0.0 : m_Signal[static_cast<size_t>(k)];
+    }
+
+    Vector<double> m_Signal;
+    size_t m_RowLength;
+    size_t m_ColumnLength;
+    bool m_IsHankel;
+};
+
+} // namespace mcon {
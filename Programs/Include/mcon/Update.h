@@ -0,0 +1,49 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "debug.h"
+#include "Vector.h"
+#include "Matrix.h"
+
+namespace mcon {
+
+/*--------------------------------------------------------------------
+ * Low rank updates of an inverse matrix
+ *
+ * Given B = A^(-1), they overwrite B with the inverse of A plus a low
+ * rank matrix in O(n^2 k), instead of inverting it in O(n^3).
+ *--------------------------------------------------------------------*/
+
+// B = (A + u v^T)^(-1) by Sherman-Morrison.
+// Returns false, with B unchanged, when A + u v^T is singular.
+bool ShermanMorrison(Matrix<double>& B, const VectordBase& u, const VectordBase& v);
+
+// B = (A + U^T V)^(-1) by Woodbury, where U and V are k x n, so that
+// each row is one of the rank-1 terms, A + sum_r U[r] V[r]^T.
+// Returns false, with B unchanged, when the result is singular.
+bool Woodbury(Matrix<double>& B, const Matrix<double>& U, const Matrix<double>& V);
+
+} // namespace mcon {
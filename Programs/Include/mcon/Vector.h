@@ -46,6 +46,7 @@ template <typename Type> class Matrix;
 template <typename Type>
 class Vector
 {
+    friend class Matrix<Type>;
 public:
 
     explicit Vector(const int length = 0);
@@ -268,9 +269,19 @@ public:
 
     size_t GetLength(void) const { return m_Length; }
     bool IsNull(void) const { return m_Length == 0; }
+    // A row of Matrix<Type> refers to the matrix' buffer and cannot be
+    // resized.
     bool Resize(size_t length);
 
 private:
+    // Refers to a buffer owned by Matrix<Type>.
+    Vector(Type* address, size_t length)
+        : m_Address(address),
+        m_Length(length),
+        m_IsOwner(false)
+    {
+    }
+
     // Private member functions.
     size_t   Smaller(size_t input) const { return GetLength() < input ? GetLength() : input; }
     void     Allocate(void);
@@ -278,6 +289,7 @@ private:
     // Private member variables.
     Type*    m_Address;
     size_t   m_Length;
+    bool     m_IsOwner;
 };
 
 template <typename Type>
@@ -294,7 +306,8 @@ void Vector<Type>::Allocate(void)
 template <typename Type>
 Vector<Type>::Vector(int length)
     : m_Address(NULL),
-    m_Length(length)
+    m_Length(length),
+    m_IsOwner(true)
 {
     Allocate();
 }
@@ -302,7 +315,8 @@ Vector<Type>::Vector(int length)
 template <typename Type>
 Vector<Type>::Vector(const Vector<Type>& v)
     : m_Address(NULL),
-    m_Length(v.GetLength())
+    m_Length(v.GetLength()),
+    m_IsOwner(true)
 {
     Allocate();
     MCON_ITERATION(i, m_Length, (*this)[i] = v[i]);
@@ -311,7 +325,8 @@ Vector<Type>::Vector(const Vector<Type>& v)
 template <typename Type>
 Vector<Type>::Vector(const VectordBase& v)
     : m_Address(NULL),
-    m_Length(v.GetLength())
+    m_Length(v.GetLength()),
+    m_IsOwner(true)
 {
     Allocate();
     MCON_ITERATION(i, m_Length, (*this)[i] = v[i]);
@@ -321,7 +336,8 @@ template <typename Type>
 template <typename U>
 Vector<Type>::Vector(const Vector<U>& v)
     : m_Address(NULL),
-    m_Length(v.GetLength())
+    m_Length(v.GetLength()),
+    m_IsOwner(true)
 {
     Allocate();
     MCON_ITERATION(i, m_Length, (*this)[i] = static_cast<Type>(v[i]));
@@ -330,11 +346,11 @@ Vector<Type>::Vector(const Vector<U>& v)
 template <typename Type>
 Vector<Type>::~Vector()
 {
-    if (NULL != m_Address)
+    if (NULL != m_Address && m_IsOwner)
     {
         delete[] m_Address;
-        m_Address = NULL;
     }
+    m_Address = NULL;
     m_Length = 0;
 }
 
@@ -350,7 +366,7 @@ Vector<Type>& Vector<Type>::operator=(const Vector<Type>& v)
 {
     // m_Length is updated in Resize().
     Resize(v.GetLength());
-    MCON_ITERATION(i, v.GetLength(), (*this)[i] = v[i]);
+    MCON_ITERATION(i, Smaller(v.GetLength()), (*this)[i] = v[i]);
     return *this;
 }
 
@@ -359,7 +375,7 @@ Vector<Type>& Vector<Type>::operator=(const VectordBase& v)
 {
     // m_Length is updated in Resize().
     Resize(v.GetLength());
-    MCON_ITERATION(i, v.GetLength(), (*this)[i] = v[i]);
+    MCON_ITERATION(i, Smaller(v.GetLength()), (*this)[i] = v[i]);
     return *this;
 }
 
@@ -370,6 +386,10 @@ bool Vector<Type>::Resize(size_t length)
     {
         return true;
     }
+    if (false == m_IsOwner)
+    {
+        return false;
+    }
     if (NULL != m_Address)
     {
         delete[] m_Address;
@@ -48,21 +48,30 @@ namespace {
                 saved[0][i] = i * df * samplingRate;
             }
 
+            // The channels at once, the rows 2c and 2c + 1 for the channel c.
+            const masp::ft::FftPlan plan(N);
+            mcon::Matrix<double> spectra;
+            status = masp::ft::FftMany(spectra, signal, plan);
+            if (NO_ERROR != status)
+            {
+                ERROR_LOG("Failed in fft: error=%d\n", status);
+                return status;
+            }
             for (int c = 0; c < ch; ++c)
             {
-                mcon::Matrix<double> complex(2, N);
-                mcon::Matrix<double> polar(2, N);
-                masp::ft::Ft(complex, signal[c]);
-                masp::ft::ConvertToPolarCoords(polar, complex);
+                const mcon::VectordBase& real = spectra[c * 2 + 0];
+                const mcon::VectordBase& imag = spectra[c * 2 + 1];
+                mcon::VectordBase& amplitude = saved[c * 4 + 1];
+                mcon::VectordBase& argument = saved[c * 4 + 2];
                 double squaredSum = 0;
 
                 for (size_t i = 0; i < N; ++i)
                 {
+                    amplitude[i] = sqrt(real[i] * real[i] + imag[i] * imag[i]);
+                    argument[i] = atan2(imag[i], real[i]);
                     squaredSum += signal[c][i] * signal[c][i];
                     saved[c * 4 + 3][i] = sqrt(squaredSum);
                 }
-                saved[c * 4 + 1] = polar[0];
-                saved[c * 4 + 2] = polar[1];
                 saved[c * 4 + 4] = signal[c];
             }
 
@@ -30,6 +30,15 @@
 
 #include "mcon.h"
 
+enum SolverType
+{
+    SolverType_Inverse,   // Inverse of Ut * Ut^T
+    SolverType_Levinson,  // Levinson-Durbin with the autocorrelation
+    SolverType_Superfast, // Circulant-preconditioned CG with the autocorrelation
+    SolverType_Qr,        // Householder QR (TSQR for long windows) of U
+    SolverType_Mixed,     // LU of Ut * U in float with the refinement in double
+};
+
 typedef struct _ProgramParameter
 {
     mcon::Matrixd inputSignal;
@@ -47,6 +56,7 @@ typedef struct _ProgramParameter
     bool optimize;
     bool optimizeSeparately;
     bool outputLog;
+    SolverType solver;
 
 // Private
     size_t samplingRate;
@@ -60,7 +70,12 @@ status_t Process    (ProgramParameter* param);
 status_t PostProcess(ProgramParameter* param);
 status_t Cleanup    (const ProgramParameter* param);
 
-status_t NormalEquation(mcon::Vector<double>& h, const mcon::Vectord& u, const mcon::Vectord& d, double* pError);
+status_t NormalEquation(
+    mcon::Vector<double>& h,
+    const mcon::Vectord& u,
+    const mcon::Vectord& d,
+    double* pError,
+    SolverType solver = SolverType_Inverse);
 
 class ShowMessage
 {
@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#include <vector>
+
 #include "mfio.h"
 
 #include "Common.h"
@@ -29,16 +31,15 @@
 // These are in Process.cpp
 void NormalEquationPre(
     mcon::Matrixd& Inversed,
-    mcon::Matrixd& Ut,
-    const mcon::Vectord& u,
-    const mcon::Matrixd& W);
+    const mcon::ToeplitzOperator& Ut,
+    const mcon::Diagonal& W);
 
 void NormalEquationPost(
     mcon::Vector<double>& h,
     const mcon::Matrixd& Inversed,
-    const mcon::Matrixd& Ut,
+    const mcon::ToeplitzOperator& Ut,
     const mcon::Vectord& d,
-    const mcon::Matrixd& W,
+    const mcon::Diagonal& W,
     double* pError);
 
 namespace {
@@ -230,7 +231,7 @@ int Optimizer(
     const std::string& outputBase
 )
 {
-    const mcon::Matrixd W; // dݍs (gȂ)
+    const mcon::Diagonal W; // Tv̏dݍs (gȂ)
     const int split = 16;  // T͈͂̕
 
     // ͐M̃GlM̈ (Jn_ƏI_) 擾B
@@ -265,6 +266,20 @@ int Optimizer(
         offsets[ch] = ClampLower<int>(0, erReference.end - M + 1); // {JnCfbNX
     }
 
+    // ͐M̓Xe[WԂŕςȂ̂ŁAts̓`l 1 񂾂vZB
+    const size_t rowLength = input.GetRowLength();
+    std::vector<mcon::ToeplitzOperator> Uts;
+    std::vector<mcon::Matrixd> inverses(rowLength);
+    Uts.reserve(rowLength);
+    for (size_t r = 0; r < rowLength; ++r)
+    {
+        const mcon::Vectord _signal(input[r]);
+        Uts.push_back(mcon::ToeplitzOperator(_signal, M, N));
+        DEBUG_LOG("r=%d: NormalEquationPre()\n", static_cast<int>(r));
+        NormalEquationPre(inverses[r], Uts[r], W);
+        DEBUG_LOG("Inv: (%d, %d)\n", static_cast<int>(inverses[r].GetRowLength()), static_cast<int>(inverses[r].GetColumnLength()));
+    }
+
     for (int i = 0 ; ; ++i)
     {
         const int step = ClampLower<int>(0, (range + split - 1) / split);
@@ -277,14 +292,8 @@ int Optimizer(
             LOG("    Stage-%d: Ch=%d, Range=%d-%d, Step=%d\n", i + 1, static_cast<int>(r), offset, offset + range - 1, step);
             mcon::VectordBase& Js = log[channelCount * i + r];
             Js = 0;
-            const mcon::Vectord _signal(input[r]);
-            const mcon::Vectord signal = _signal(0, N);
-            mcon::Matrixd Ut(M, N);
-            DEBUG_LOG("Ut: (%d, %d)\n", static_cast<int>(Ut.GetRowLength()), static_cast<int>(Ut.GetColumnLength()));
-            mcon::Matrixd inversed;
-            DEBUG_LOG("r=%d: NormalEquationPre()\n", static_cast<int>(r));
-            NormalEquationPre(inversed, Ut, signal, W);
-            DEBUG_LOG("Inv: (%d, %d)\n", static_cast<int>(inversed.GetRowLength()), static_cast<int>(inversed.GetColumnLength()));
+            const mcon::ToeplitzOperator& Ut = Uts[r];
+            const mcon::Matrixd& inversed = inverses[r];
             DEBUG_LOG("r=%d: Do, Optimizing ...\n", static_cast<int>(r));
             for (int k = 0; k < split; ++k)
             {
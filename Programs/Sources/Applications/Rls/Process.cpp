@@ -29,57 +29,281 @@
 
 #include "Common.h"
 
-void NormalEquationPre(mcon::Matrixd& Inversed, mcon::Matrixd& Ut, const mcon::Vectord& u, const mcon::Matrixd& W)
+namespace {
+
+// Solves the normal equation without forming Ut.
+status_t NormalEquationToeplitz(
+    mcon::Vector<double>& h,
+    const mcon::Vectord& u,
+    const mcon::Vectord& d,
+    double* pError,
+    SolverType solver)
 {
-    const int N = Ut.GetColumnLength();
-    const int M = Ut.GetRowLength();
+    const size_t N = d.GetLength();
+    const size_t M = h.GetLength();
+    mcon::Vectord r(M);
+    mcon::Vectord p(M);
 
-    ASSERT( !Ut.IsNull() );
-    ASSERT( N != 0 );
-    ASSERT( M != 0 );
-    UNUSED( W );
+    // r[l] = sum_k u[k] * u[k + l], of which the Toeplitz matrix
+    // approximates Ut * Ut^T (autocorrelation method), and
+    // p[m] = sum_k u[k] * d[k + m], which equals to Ut * d.
+    status_t status = masp::corr::AutoCorrelate(r, u, std::min(N, u.GetLength()), M - 1);
+    if ( NO_ERROR == status )
+    {
+        status = masp::corr::CrossCorrelate(p, u, u.GetLength(), d, N, 0, static_cast<int>(M) - 1);
+    }
+    if ( NO_ERROR != status )
+    {
+        return status;
+    }
 
-    Ut = 0;
+    const mcon::Toeplitz R(r);
+    bool solved = false;
+    if (SolverType_Superfast == solver)
+    {
+        solved = R.SolveSuperfast(h, p);
+        if (!solved)
+        {
+            LOG("    Not converged, retrying with Levinson-Durbin.\n");
+        }
+    }
+    if (!solved)
+    {
+        solved = R.Solve(h, p);
+    }
+    if (!solved)
+    {
+        ERROR_LOG("The autocorrelation is not positive definite.\n");
+        return -ERROR_ILLEGAL;
+    }
+    if (NULL != pError)
+    {
+        // e = d - U * h
+        double error = 0;
+        for (size_t n = 0; n < N; ++n)
+        {
+            double y = 0;
+            for (size_t m = 0; m < M && m <= n; ++m)
+            {
+                y += u[n - m] * h[m];
+            }
+            error += (d[n] - y) * (d[n] - y);
+        }
+        *pError = error;
+    }
+    return NO_ERROR;
+}
 
-    // Ut の方がメモリアクセスの観点から有利なはず。
-    for (int m = 0; m < M; ++m)
+// Solves min ||U h - d|| by QR without forming Ut * U.
+// Long windows are decomposed block by block in parallel (TSQR).
+status_t NormalEquationQr(
+    mcon::Vector<double>& h,
+    const mcon::Vectord& u,
+    const mcon::Vectord& d,
+    double* pError)
+{
+    // Ut[m][n] = u[n - m], filled directly from u.
+    const size_t N = d.GetLength();
+    const size_t M = h.GetLength();
+    mcon::Matrixd Ut(M, N);
+    for (size_t m = 0; m < M; ++m)
     {
-        for (int n = 0; n + m < N; ++n)
+        for (size_t n = 0; n < N; ++n)
         {
-            //LOG("m=%d(%d), n=%d(%d)\n", m, M, n, N);
-            Ut[m][m + n] = u[n];
+            Ut[m][n] = (m <= n && n - m < u.GetLength()) ? u[n - m] : 0.0;
         }
     }
+    mcon::Qr qr;
+    double residual = 0;
+    if ( !qr.Factorize(Ut.T()) || !qr.Solve(h, d, &residual) )
+    {
+        ERROR_LOG("The input matrix is rank deficient.\n");
+        return -ERROR_ILLEGAL;
+    }
+    if (NULL != pError)
+    {
+        *pError = residual * residual;
+    }
+    return NO_ERROR;
+}
+
+// Solves the normal equation by LU in float refined to the double accuracy.
+status_t NormalEquationMixed(
+    mcon::Vector<double>& h,
+    const mcon::Vectord& u,
+    const mcon::Vectord& d,
+    double* pError)
+{
+    const mcon::ToeplitzOperator Ut(u, h.GetLength(), d.GetLength());
+    mcon::Lu lu;
+    size_t count = 0;
+    if ( !lu.Factorize(Ut.Gram(), mcon::Lu::Precision_Mixed) || !lu.Solve(h, Ut.Multiply(d), &count) )
+    {
+        ERROR_LOG("Ut * U is singular.\n");
+        return -ERROR_ILLEGAL;
+    }
+    if ( mcon::Lu::Precision_Mixed == lu.GetPrecision() )
+    {
+        LOG("    Refined %d times.\n", static_cast<int>(count));
+    }
+    else
+    {
+        LOG("    Not refined, solved in double.\n");
+    }
+    if (NULL != pError)
+    {
+        const mcon::Vectord diff = d - Ut.MultiplyTransposed(h);
+        *pError = diff.Dot(diff);
+    }
+    return NO_ERROR;
+}
+
+// Ut * W * U for each type of the weighting matrix, without forming Ut.
+mcon::Matrixd WeightedGram(const mcon::ToeplitzOperator& Ut, const mcon::Matrixd& W)
+{
+    // Column by column, Ut * (W * u_j) of the row u_j of Ut.
+    const size_t M = Ut.GetRowLength();
+    const size_t N = Ut.GetColumnLength();
+    mcon::Matrixd G(M, M);
+    mcon::Vectord e(M);
+    mcon::Vectord Wu(N);
+    for (size_t j = 0; j < M; ++j)
+    {
+        e = 0;
+        e[j] = 1.0;
+        mcon::Gemv(Wu, W, Ut.MultiplyTransposed(e));
+        const mcon::Vectord g = Ut.Multiply(Wu);
+        for (size_t i = 0; i < M; ++i)
+        {
+            G[i][j] = g[i];
+        }
+    }
+    return G;
+}
+
+mcon::Matrixd WeightedGram(const mcon::ToeplitzOperator& Ut, const mcon::Diagonal& W)
+{
+    return Ut.Gram(W);
+}
+
+mcon::Matrixd WeightedGram(const mcon::ToeplitzOperator& Ut, const mcon::SparseMatrix& W)
+{
+    return W.MultiplyGram(Ut);
+}
+
+// W * d for each type of the weighting matrix.
+mcon::Vectord Weight(const mcon::Matrixd& W, const mcon::Vectord& d)
+{
+    mcon::Vectord Wd(d.GetLength());
+    mcon::Gemv(Wd, W, d);
+    return Wd;
+}
+
+mcon::Vectord Weight(const mcon::Diagonal& W, const mcon::Vectord& d)
+{
+    return W.Multiply(d);
+}
+
+mcon::Vectord Weight(const mcon::SparseMatrix& W, const mcon::Vectord& d)
+{
+    return W.Multiply(d);
+}
+
+template <typename Weighting>
+void NormalEquationPreWeighted(mcon::Matrixd& Inversed, const mcon::ToeplitzOperator& Ut, const Weighting& W)
+{
+    ASSERT( !Ut.IsNull() );
+
+    // Ut * W * Ut^T is formed without materializing Ut.
     if (W.IsNull())
     {
-        Inversed = Ut.Multiply( Ut.T() ).I();
+        Inversed = Ut.Gram().I();
     }
     else
     {
-        Inversed = Ut.Multiply( W ).Multiply( Ut.T() ).I();
+        Inversed = WeightedGram(Ut, W).I();
     }
 }
 
-void NormalEquationPost(
+template <typename Weighting>
+void NormalEquationPostWeighted(
     mcon::Vector<double>& h,
     const mcon::Matrixd& Inversed,
-    const mcon::Matrixd& Ut,
+    const mcon::ToeplitzOperator& Ut,
     const mcon::Vectord& d,
-    const mcon::Matrixd& W,
+    const Weighting& W,
     double* pError)
 {
-    const mcon::Matrixd dm(d, true); // d = (1, n) ==> dm = (n, 1);
-    const mcon::Matrixd hm = W.IsNull() ? Inversed.Multiply(Ut).Multiply(dm)
-        : Inversed.Multiply(Ut).Multiply(W).Multiply(dm);
-    h = hm.T()[0];
+    const size_t M = Ut.GetRowLength();
+    const mcon::Vectord p = Ut.Multiply(W.IsNull() ? d : Weight(W, d));
+    h.Resize(M);
+    for (size_t m = 0; m < M; ++m)
+    {
+        h[m] = Inversed[m].Dot(p);
+    }
     if (NULL != pError)
     {
-        const mcon::Matrixd diff = dm - Ut.T().Multiply(hm);
-        *pError = (diff * diff).T()[0].GetSum();
+        const mcon::Vectord diff = d - Ut.MultiplyTransposed(h);
+        *pError = diff.Dot(diff);
     }
 }
 
-status_t NormalEquation(mcon::Vector<double>& h, const mcon::Vectord& u, const mcon::Vectord& d, double* pError)
+} // anonymous
+
+void NormalEquationPre(mcon::Matrixd& Inversed, const mcon::ToeplitzOperator& Ut, const mcon::Matrixd& W)
+{
+    NormalEquationPreWeighted(Inversed, Ut, W);
+}
+
+void NormalEquationPre(mcon::Matrixd& Inversed, const mcon::ToeplitzOperator& Ut, const mcon::Diagonal& W)
+{
+    NormalEquationPreWeighted(Inversed, Ut, W);
+}
+
+void NormalEquationPre(mcon::Matrixd& Inversed, const mcon::ToeplitzOperator& Ut, const mcon::SparseMatrix& W)
+{
+    NormalEquationPreWeighted(Inversed, Ut, W);
+}
+
+void NormalEquationPost(
+    mcon::Vector<double>& h,
+    const mcon::Matrixd& Inversed,
+    const mcon::ToeplitzOperator& Ut,
+    const mcon::Vectord& d,
+    const mcon::Matrixd& W,
+    double* pError)
+{
+    NormalEquationPostWeighted(h, Inversed, Ut, d, W, pError);
+}
+
+void NormalEquationPost(
+    mcon::Vector<double>& h,
+    const mcon::Matrixd& Inversed,
+    const mcon::ToeplitzOperator& Ut,
+    const mcon::Vectord& d,
+    const mcon::Diagonal& W,
+    double* pError)
+{
+    NormalEquationPostWeighted(h, Inversed, Ut, d, W, pError);
+}
+
+void NormalEquationPost(
+    mcon::Vector<double>& h,
+    const mcon::Matrixd& Inversed,
+    const mcon::ToeplitzOperator& Ut,
+    const mcon::Vectord& d,
+    const mcon::SparseMatrix& W,
+    double* pError)
+{
+    NormalEquationPostWeighted(h, Inversed, Ut, d, W, pError);
+}
+
+status_t NormalEquation(
+    mcon::Vector<double>& h,
+    const mcon::Vectord& u,
+    const mcon::Vectord& d,
+    double* pError,
+    SolverType solver)
 {
     const int N = d.GetLength();
     const int M = h.GetLength();
@@ -87,13 +311,25 @@ status_t NormalEquation(mcon::Vector<double>& h, const mcon::Vectord& u, const m
     {
         return -ERROR_ILLEGAL;
     }
+    if ( SolverType_Qr == solver )
+    {
+        return NormalEquationQr(h, u, d, pError);
+    }
+    if ( SolverType_Mixed == solver )
+    {
+        return NormalEquationMixed(h, u, d, pError);
+    }
+    if ( SolverType_Inverse != solver )
+    {
+        return NormalEquationToeplitz(h, u, d, pError, solver);
+    }
     //   h   = (  Ut  *   W   *   U  )^(-1) *   Ut  *   W   *   d
     // [Mx1] = ([MxN] * [NxN] * [NxM])      * [MxN] * [NxN] * [Nx1]
-    mcon::Matrixd Ut(M, N);
+    const mcon::ToeplitzOperator Ut(u, M, N);
     mcon::Matrixd Inv;
-    mcon::Matrixd W;
+    const mcon::Diagonal W;
 
-    NormalEquationPre(Inv, Ut, u, W);
+    NormalEquationPre(Inv, Ut, W);
 
     NormalEquationPost(h, Inv, Ut, d, W, pError);
 
@@ -109,8 +345,9 @@ status_t Rls(mcon::Vector<double>& h, const mcon::Vectord& u, const mcon::Vector
 
     double c = 0.001; // an appropriately small number
     mcon::Matrixd P = mcon::Matrixd::E(M);
-    mcon::Matrixd hm(M, 1);
+    mcon::Vectord hv(M);
     mcon::Vectord uv(M);
+    mcon::Vectord Pu(M); // P * u
 
     mcon::Matrix<double> logs(6, N);
     mcon::VectordBase& e   = logs[0];
@@ -120,27 +357,25 @@ status_t Rls(mcon::Vector<double>& h, const mcon::Vectord& u, const mcon::Vector
     mcon::VectordBase& U   = logs[4];
     mcon::VectordBase& E   = logs[5];
 
-    hm = 0;
+    hv = 0;
     P /= c;
     uv = 0;
 
+    // P is kept symmetric, so that
+    //   k = P u / (u^T P u + 1)
+    //   P -= k u^T P = P - (P u) (P u)^T / (u^T P u + 1)
+    // which costs O(M^2) without any allocation.
     for (int i = 0; i < N; ++i)
     {
         uv.Unshift(u[i]);
         U[i] = uv.GetNorm(); // logs
-        const mcon::Matrixd um(uv, true); // Transposed
-        mcon::Matrixd k(P.Multiply(um)); // numerator
-        const mcon::Matrixd& denominator = um.Transpose().Multiply(P).Multiply(um);
-        ASSERT(denominator.GetRowLength() == 1 && denominator.GetColumnLength() == 1);
-        const double denom = denominator[0][0] + 1;
-        k /= denom;
-        K[i] = k.Transpose()[0].GetNorm(); // logs
-        const mcon::Matrixd& m = um.Transpose().Multiply(hm);
-        ASSERT(m.GetRowLength() == 1 && m.GetColumnLength() == 1);
-        eta[i] = d[i] - m[0][0]; // logs
-        hm += k * eta[i];
+        mcon::Gemv(Pu, P, uv);
+        const double denom = uv.Dot(Pu) + 1;
+        K[i] = Pu.GetNorm() / denom; // logs
+        eta[i] = d[i] - uv.Dot(hv); // logs
+        mcon::Axpy(hv, eta[i] / denom, Pu); // h += k * eta
 
-        e[i] = d[i] - (um.Transpose().Multiply(hm))[0][0]; // logs
+        e[i] = d[i] - uv.Dot(hv); // logs
         if ( i > 0 )
         {
             J[i] = J[i-1] + e[i] * eta[i]; // logs
@@ -151,13 +386,13 @@ status_t Rls(mcon::Vector<double>& h, const mcon::Vectord& u, const mcon::Vector
             J[i] = e[i] * eta[i]; // logs
             E[i] = d[i] * d[i]; // logs
         }
-        P -= k.Multiply(um.Transpose()).Multiply(P);
+        mcon::Syr(P, -1.0 / denom, Pu);
         if ( (i % 10) == 0 )
         {
             LOG("%4.1f [%%]: %d/%d\r", i*100.0/N, i, N);
         }
     }
-    h = hm.Transpose()[0];
+    h = hv;
 
     return NO_ERROR;
 }
@@ -327,7 +562,8 @@ status_t Estimater(
     const mcon::Matrixd& input,
     const mcon::Vectord& reference,
     const int tapps,
-    const mcon::Vectord& referenceOffsets
+    const mcon::Vectord& referenceOffsets,
+    SolverType solver
     )
 {
     const int M = tapps;
@@ -354,7 +590,7 @@ status_t Estimater(
         const mcon::Vectord _u = input[r];
         const mcon::Vectord u = _u(0, N);
         mcon::Vector<double> h(M);
-        NormalEquation(h, u, d, NULL);
+        status = NormalEquation(h, u, d, NULL, solver);
         if (NO_ERROR != status)
         {
             break;
@@ -371,6 +607,7 @@ status_t Process(ProgramParameter* param)
         param->inputSignal,
         param->referenceSignal,
         param->tapps,
-        param->referenceOffset
+        param->referenceOffset,
+        param->solver
     );
 }
@@ -42,7 +42,8 @@ namespace {
         {"m" , 1},
         {"opt" ,0},
         {"sep" ,0},
-        {"log" ,0}
+        {"log" ,0},
+        {"s" , 1}
     };
     ProgramParameter param = ProgramParameter();
 
@@ -60,6 +61,12 @@ namespace {
         LOG("  -opt: spefity to optimize so as to minimize error.\n");
         LOG("  -sep: spefity to optimize each channel separately.\n");
         LOG("  -log: spefity to output a log file on the process of optimization.\n");
+        LOG("  -s: spefity a solver of the normal equation.\n");
+        LOG("      inv: inverse matrix (default).\n");
+        LOG("      lev: Levinson-Durbin with the autocorrelation, O(M^2).\n");
+        LOG("      sf : superfast solver with the autocorrelation, O(M log M) per iteration.\n");
+        LOG("      qr : Householder QR of the input matrix, TSQR for long inputs.\n");
+        LOG("      mix: LU in float refined to double, falling back to double if not converged.\n");
     }
 }
 
@@ -78,6 +85,7 @@ int main(int argc, const char* argv[])
     param.optimize = false;
     param.optimizeSeparately = false;
     param.outputLog = false;
+    param.solver = SolverType_Inverse;
     param.inputLength = -1;
 
     param.inputFilepath = parser.GetArgument(0);
@@ -125,6 +133,35 @@ int main(int argc, const char* argv[])
     {
         param.outputLog = true;
     }
+    if (parser.IsEnabled("s"))
+    {
+        const std::string solver = parser.GetOption("s");
+        if ( solver == std::string("inv") )
+        {
+            param.solver = SolverType_Inverse;
+        }
+        else if ( solver == std::string("lev") )
+        {
+            param.solver = SolverType_Levinson;
+        }
+        else if ( solver == std::string("sf") )
+        {
+            param.solver = SolverType_Superfast;
+        }
+        else if ( solver == std::string("qr") )
+        {
+            param.solver = SolverType_Qr;
+        }
+        else if ( solver == std::string("mix") )
+        {
+            param.solver = SolverType_Mixed;
+        }
+        else
+        {
+            ERROR_LOG("Unknown solver (an argument of \"-s\" switch): %s\n", solver.c_str());
+            return 0;
+        }
+    }
 
     std::string outputPrefix;
     if (parser.IsEnabled("o"))
@@ -67,7 +67,13 @@ typedef struct _ProgramParameter
 
     size_t sampleCount;
 
-    bool isUsedOnlyFt;
+    bool isPsdOutput;
+    bool isSinglePrecision;
+    // The band [zoomLow, zoomHigh] in Hz evaluated by the chirp z instead
+    // of the spectrum of the window.
+    bool isZoomed;
+    double zoomLow;
+    double zoomHigh;
 
     enum GainFormat gainFormat;
     enum ArgFormat argFormat;
@@ -22,56 +22,43 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <string>
 
 #include "mcon.h"
 
 #include "Common.h"
 
-#define DUPLICATE(v) (v), (v)
-
 namespace {
 
 const int LowestSampleCount = 512;
 
-int GetU1Position(size_t value)
+// 2, 3, 5, 7 の積かどうか (FFT が mixed-radix で処理できる長さ)。
+bool IsSmooth(size_t value)
 {
     if (0 == value)
     {
-        return -1;
+        return false;
     }
-    for (int k = (sizeof(size_t) * 8 - 1); k >= 0; --k)
+    const size_t primes[] = { 2, 3, 5, 7 };
+    for (size_t k = 0; k < sizeof(primes) / sizeof(primes[0]); ++k)
     {
-        if (value & (1 << k))
-        {
-            return k;
-        }
+        for ( ; 0 == (value % primes[k]); value /= primes[k]);
     }
-    ASSERT(false);
-    return -2;
+    return 1 == value;
 }
 
-size_t GetLowerLimitSize(size_t frequency)
+// value 以上で最小の 2, 3, 5, 7 の積。
+size_t GetSmoothCeiling(size_t value)
 {
-    const size_t tmp = frequency / 100;
-    size_t size = 0;
+    size_t smooth = value > 0 ? value : 1;
+    for ( ; !IsSmooth(smooth); ++smooth);
+    return smooth;
+}
 
-    for (size_t k = 31; k >= 0; --k)
-    {
-        if (tmp & (1 << k))
-        {
-            size = 1 << k;
-            // 半分を超えていたら、さらに 1 ビットシフトさせる。
-            if (k == 0 || k == 31)
-            {
-                break;
-            }
-            size <<= ( tmp & (1 << (k - 1)) ) ? 1 : 0;
-            break;
-        }
-    }
-    ASSERT( 0 != size );
-    return size;
+size_t GetLowerLimitSize(size_t frequency)
+{
+    return GetSmoothCeiling(frequency / 100);
 }
 
 /*
@@ -79,54 +66,46 @@ size_t GetLowerLimitSize(size_t frequency)
  * 1) サンプリングレートの 1/100 くらいの分解能を実現する。
  * 2) ウィンドウ幅で区切った時、端数が少なくなるように幅を定める。
  * 3) 少し余った場合は切り捨て、少し足りない場合は 0 埋めする。
+ * 幅は 2 の累乗に限らず、2, 3, 5, 7 の積から選ぶ。
  */
 size_t GetWindowLength(size_t n, size_t samplingRate)
 {
-    const size_t upperWidth = ( 1 << GetU1Position(n * 2 - 1) );
+    const size_t upperWidth = n * 2 - 1;
     const size_t lowerWidth = GetLowerLimitSize(samplingRate);
 
     if (upperWidth < lowerWidth)
     {
-        return upperWidth;
+        return GetSmoothCeiling(n);
     }
-
-    int caseCount = 0;
-    DEBUG_LOG("upperWidth: %d (%08x)\n", DUPLICATE( static_cast<int>(upperWidth) ));
-    DEBUG_LOG("lowerWidth: %d (%08x)\n", DUPLICATE( static_cast<int>(lowerWidth) ));
-
-    // 31 は 32 bit での最大左シフト数 ( 1 << 31 )、念のため。
-    for ( ;upperWidth != (lowerWidth << caseCount) && caseCount < 31; ++caseCount);
-    caseCount++;
-    DEBUG_LOG("case: %d\n", caseCount);
-
-    mcon::Vector<double> ratio(caseCount);
-
-    for (size_t w = lowerWidth, k = 0; w <= upperWidth; ++k, w *= 2)
+    DEBUG_LOG("upperWidth: %d\n", static_cast<int>(upperWidth));
+    DEBUG_LOG("lowerWidth: %d\n", static_cast<int>(lowerWidth));
+
+    // 端数の比率 rest / w について、
+    // min(比率, 1 - 比率) は切り捨てるか 0 埋めする割合。
+    // これが最も小さい幅を、同じなら長い方を採用する。
+    size_t width = lowerWidth;
+    double minimum = 1.0;
+    for (size_t w2 = 1; w2 <= upperWidth; w2 *= 2)
+    for (size_t w3 = w2; w3 <= upperWidth; w3 *= 3)
+    for (size_t w5 = w3; w5 <= upperWidth; w5 *= 5)
+    for (size_t w = w5; w <= upperWidth; w *= 7)
     {
+        if (w < lowerWidth)
+        {
+            continue;
+        }
         const size_t rest = n % w;
-        ratio[k] = static_cast<double>(rest) / w;
-        DEBUG_LOG("n=%d, %5d: %f (%d)\n", static_cast<int>(n), static_cast<int>(w), static_cast<double>(rest) / w, static_cast<int>(rest));
-    }
-    const double max = ratio.GetMaximum();
-    const double min = ratio.GetMinimum();
-
-    // (1 - max) は「どれだけ足りないか」、min はどれだけ余っているか。
-    // 小さい方を採用する。
-    const double searchTarget = (1.0 - max < min) ? max : min;
-    DEBUG_LOG("Cut or Shotage: %f\n", searchTarget);
-
-    int index = -1;
-    for (int k = ratio.GetLength() - 1; k >= 0 ; --k)
-    {
-        if (ratio[k] == searchTarget)
+        const double ratio = static_cast<double>(rest) / w;
+        const double loss = std::min(ratio, 1.0 - ratio);
+        if (loss < minimum || (loss == minimum && w > width))
         {
-            index = k;
-            break;
+            minimum = loss;
+            width = w;
         }
     }
-    ASSERT(index != -1);
-    DEBUG_LOG("Size: %d\n", static_cast<int>(lowerWidth << index) );
-    return (lowerWidth << index);
+    DEBUG_LOG("Cut or Shotage: %f\n", minimum);
+    DEBUG_LOG("Size: %d\n", static_cast<int>(width));
+    return width;
 }
 
 }
@@ -156,12 +135,12 @@ bool IsFactorial(const size_t _value, const size_t base)
  * サンプル数とウィンドウ長の調整をする。
  * 1) サンプル数は、信号長かユーザが指定した値のどちらかである。
  *    ユーザ指定値を優先する。
- * 2) ウィンドウ長が指定されている場合、これを尊重する (2 の階乗)。
+ * 2) ウィンドウ長が指定されている場合、これを尊重する (任意の長さ)。
  *    サンプル数が既定値より小さい場合にのみ、変更される。
  *    未指定時は、1 の情報に基づき決める。
  * 3) サンプル数調整では信号長を直接変更する。
  *    使用サンプル数と信号長の関係により、切り捨てか伸長 (0 埋め) が実施される。
- * 4) サンプル数が既定値 (512) より少ない場合、ft で処理する。
+ * 4) サンプル数が既定値 (512) より少ない場合、全体を 1 つのウィンドウとする。
  *
  */
 status_t PreProcess(ProgramParameter* param)
@@ -174,32 +153,28 @@ status_t PreProcess(ProgramParameter* param)
     // ウィンドウサイズが未指定の場合
     if (0 == param->windowLength)
     {
-        // サンプル長が2 の階乗なら FFT で良い。
-        if ( IsFactorial(sampleCount, 2) )
+        // サンプル長が 2, 3, 5, 7 の積なら FFT で良い。
+        if ( IsSmooth(sampleCount) )
         {
-            param->isUsedOnlyFt = false;
             param->windowLength = sampleCount;
         }
         else
         {
-            param->windowLength = (true == param->isUsedOnlyFt) ?
-                sampleCount : GetWindowLength(sampleCount, param->samplingRate);
+            param->windowLength = GetWindowLength(sampleCount, param->samplingRate);
         }
     }
     // ウィンドウサイズが指定されている場合
     else
     {
-        ASSERT( IsFactorial(param->windowLength, 2) );
         // ウィンドウ幅が無駄に長い場合は短くする。
         if (param->windowLength > (signalLength << 1))
         {
-            param->windowLength = 1 << (GetU1Position(signalLength) + 1);
+            param->windowLength = signalLength << 1;
         }
     }
-    // 既定数よりサプル数が小さい場合は ft で処理する。
+    // 既定数よりサプル数が小さい場合は全体を 1 つのウィンドウとする。
     if (sampleCount < LowestSampleCount)
     {
-        param->isUsedOnlyFt = true;
         param->windowLength = sampleCount;
     }
 
@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <string>
 
 #include <math.h>
@@ -68,15 +69,9 @@ status_t CaculateEnergy(const mcon::Matrix<double>& input, const std::string& ou
     return NO_ERROR;
 }
 
-status_t CaculateSpectrum(const ProgramParameter* param)
+void SetWindow(mcon::Vector<double>& window, WindowType windowType)
 {
-    const mcon::Matrix<double>& input = param->signal;
-    const size_t ch = input.GetRowLength();
-    const size_t N = param->windowLength;
-    mcon::Matrix<double> matrix(2 * ch + 1, N);
-    mcon::Vector<double> window(N);
-
-    switch(param->windowType)
+    switch(windowType)
     {
         case WindowType_Rectangular:
             masp::window::Rectangular(window);
@@ -95,6 +90,17 @@ status_t CaculateSpectrum(const ProgramParameter* param)
             masp::window::Hanning(window);
             break;
     }
+}
+
+status_t CaculateSpectrum(const ProgramParameter* param)
+{
+    const mcon::Matrix<double>& input = param->signal;
+    const size_t ch = input.GetRowLength();
+    const size_t N = param->windowLength;
+    mcon::Matrix<double> matrix(2 * ch + 1, N);
+    mcon::Vector<double> window(N);
+
+    SetWindow(window, param->windowType);
 
     for (size_t i = 0; i < N; ++i)
     {
@@ -102,75 +108,34 @@ status_t CaculateSpectrum(const ProgramParameter* param)
     }
     const double windowEnergy = sqrt(window.Dot(window) / window.GetLength()) ;
     DEBUG_LOG("WindowEnergy=%g\n", windowEnergy);
+    // ̔A擪Ɩ 0 Ŗ߂ĉ͂B
+    // MȂ̂ŁAł͔̒ FFT ōς܂ASrɓWJB
+    const size_t hop = std::max(static_cast<size_t>(1), N / 2);
+    masp::spectrum::Stft stft(window, hop, true);
+    // Uɑ΂Ă̂݁A֐̃GlMɉ␳B
+    // fVxxւ̕ΐASt[𑫂킹ɍsB
+    masp::spectrum::PolarFormat format;
+    format.scale = 1.0 / windowEnergy;
+    if (param->gainFormat == GainFormat_10Log
+        || param->gainFormat == GainFormat_20Log)
+    {
+        format.decibel = param->gainFormat == GainFormat_10Log ? 10.0 : 20.0;
+    }
+    format.isDegree = param->argFormat == ArgFormat_Degree;
     for (size_t c = 0; c < ch; ++c)
     {
-        const int count = input.GetColumnLength() / param->windowLength;
-        const int rest = (input.GetColumnLength() % param->windowLength);
-        ASSERT( rest == 0 );
-        UNUSED(rest);
-
         mcon::Matrix<double> sum(2, N);
         sum = 0;
-        // ̔͂B
-        for (int k = 0; k < 2 * count + 1; ++k)
-        {
-            mcon::Vector<double> part(N);
-            mcon::Matrix<double> polar;
-            mcon::Matrix<double> complex;
-            // 擪Ɩ͓ʂɏ
-            if (k == 0 || k == 2 * count)
-            {
-                const double* src = input[c];
-                const int copySize = sizeof(double) * N / 2;
-                double* dst = part;
-                part = 0;
-                if (k == 0)
-                {
-                    std::memcpy(dst + N / 2, src, copySize);
-                }
-                else
-                {
-                    std::memcpy(dst, src + (2 * count - 1) * N / 2, copySize);
-                }
-            }
-            else
-            {
-                // k == 0 ͓Ȃ̂ŁÃCfbNXɂ͂ȂȂB
-                const int head = N * (k - 1) / 2;
-                part = static_cast<mcon::Vectord>(input[c])(head, N);
-            }
-            part *= window;
-
-            if (true == param->isUsedOnlyFt)
-            {
-                masp::ft::Ft(complex, part);
-            }
-            else
-            {
-                masp::ft::Fft(complex, part);
-            }
-            masp::ft::ConvertToPolarCoords(polar, complex);
-            sum[0] += polar[0];
-            sum[1] += polar[1];
-        }
-        // Uɑ΂Ă̂݁A֐̃GlMɉ␳B
-        sum[0] /= windowEnergy;
-        if (param->gainFormat == GainFormat_10Log
-            || param->gainFormat == GainFormat_20Log)
+        stft.Reset(N / 2);
+        const double* samples = input[c];
+        size_t count = input.GetColumnLength();
+        const double* zeros = NULL;
+        size_t zeroCount = N / 2;
+        while ( stft.Next(samples, count) || stft.Next(zeros, zeroCount) )
         {
-            const double gain = param->gainFormat == GainFormat_10Log ? 10.0 : 20.0;
-            for (size_t i = 0; i < N; ++i)
-            {
-                sum[0][i] = gain * log10(sum[0][i]);
-            }
-        }
-        if (param->argFormat == ArgFormat_Degree)
-        {
-            for (size_t i = 0; i < N; ++i)
-            {
-                sum[1][i] = sum[1][i] / M_PI * 180.0;
-            }
+            masp::spectrum::ConvertToPolar(sum[0], sum[1], stft.GetReal(), stft.GetImag(), N, masp::spectrum::PolarFormat(), true);
         }
+        masp::spectrum::ApplyPolarFormat(sum[0], sum[1], N, format);
         matrix[c * 2 + 1] = sum[0];
         matrix[c * 2 + 2] = sum[1];
     }
@@ -190,13 +155,121 @@ status_t CaculateSpectrum(const ProgramParameter* param)
     return NO_ERROR;
 }
 
+status_t CaculateZoom(const ProgramParameter* param)
+{
+    const mcon::Matrix<double>& input = param->signal;
+    const size_t ch = input.GetRowLength();
+    const size_t N = input.GetColumnLength();
+    const size_t M = param->windowLength;
+    mcon::Vector<double> window(N);
+    SetWindow(window, param->windowType);
+
+    // MŜɑAwш M _`[v z ϊŋ߂B
+    // \͐MŌ܂AшÕr͌vZȂB
+    const double fs = static_cast<double>(param->samplingRate);
+    const masp::ft::ChirpZPlan plan(N, M, param->zoomLow / fs, param->zoomHigh / fs);
+    if ( plan.IsNull() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    mcon::Matrix<double> matrix(2 * ch + 1, M);
+    for (size_t m = 0; m < M; ++m)
+    {
+        matrix[0][m] = plan.GetFrequency(m) * fs;
+    }
+    const double windowEnergy = sqrt(window.Dot(window) / window.GetLength()) ;
+    masp::spectrum::PolarFormat format;
+    format.scale = 1.0 / windowEnergy;
+    if (param->gainFormat == GainFormat_10Log
+        || param->gainFormat == GainFormat_20Log)
+    {
+        format.decibel = param->gainFormat == GainFormat_10Log ? 10.0 : 20.0;
+    }
+    format.isDegree = param->argFormat == ArgFormat_Degree;
+    mcon::Vector<double> windowed(N);
+    mcon::Matrix<double> complex(2, M);
+    for (size_t c = 0; c < ch; ++c)
+    {
+        windowed = input[c];
+        windowed *= window;
+        RETURN_IF_FAILED( plan.Execute(complex[0], complex[1], windowed) );
+        RETURN_IF_FAILED( masp::spectrum::ConvertToPolar(matrix[c * 2 + 1], matrix[c * 2 + 2], complex[0], complex[1], M, format) );
+    }
+
+    const std::string ecsv("_zoom.csv");
+
+    mfio::Csv csv(param->outputBase + ecsv);
+    csv.Write("Id,Frequency");
+    for (size_t c = 0; c < ch; ++c)
+    {
+        csv.Write(",Amplitude,Argument");
+    }
+    csv.Write("\n");
+    csv.Write(matrix);
+    csv.Close();
+
+    return NO_ERROR;
+}
+
+status_t CaculatePsd(const ProgramParameter* param)
+{
+    const mcon::Matrix<double>& input = param->signal;
+    const size_t ch = input.GetRowLength();
+    const size_t N = param->windowLength;
+    mcon::Vector<double> window(N);
+    SetWindow(window, param->windowType);
+
+    // Б PSD A̔d˂Ԃ̕ς狁߂B
+    const masp::spectrum::Welch::Precision precision = param->isSinglePrecision ?
+        masp::spectrum::Welch::Precision_Single : masp::spectrum::Welch::Precision_Double;
+    const masp::spectrum::Welch welch(window, N / 2, masp::spectrum::Welch::Scaling_Density, true, precision);
+    const size_t binCount = welch.GetBinCount();
+    mcon::Matrix<double> matrix(ch + 1, binCount);
+    for (size_t k = 0; k < binCount; ++k)
+    {
+        matrix[0][k] = 1.0 * k / N * param->samplingRate;
+    }
+    mcon::Vector<double> psd;
+    for (size_t c = 0; c < ch; ++c)
+    {
+        RETURN_IF_FAILED( welch.Estimate(psd, input[c], static_cast<double>(param->samplingRate)) );
+        matrix[c + 1] = psd;
+    }
+
+    const std::string ecsv("_psd.csv");
+
+    mfio::Csv csv(param->outputBase + ecsv);
+    csv.Write("Id,Frequency");
+    for (size_t c = 0; c < ch; ++c)
+    {
+        csv.Write(",PSD");
+    }
+    csv.Write("\n");
+    csv.Write(matrix);
+    csv.Close();
+
+    return NO_ERROR;
+}
+
 }
 
 status_t Process(const ProgramParameter* param)
 {
     RETURN_IF_FAILED( CaculateEnergy(param->signal, param->outputBase) );
 
-    RETURN_IF_FAILED( CaculateSpectrum(param) );
+    if (param->isZoomed)
+    {
+        RETURN_IF_FAILED( CaculateZoom(param) );
+    }
+    else
+    {
+        RETURN_IF_FAILED( CaculateSpectrum(param) );
+    }
+
+    if (param->isPsdOutput)
+    {
+        RETURN_IF_FAILED( CaculatePsd(param) );
+    }
 
     return NO_ERROR;
 }
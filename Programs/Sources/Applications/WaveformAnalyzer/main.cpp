@@ -36,10 +36,12 @@ static void usage(void)
     LOG("  -h: display this help.\n");
     LOG("  -o: spefity an output filename.\n");
     LOG("  -d: spefity an output directory, which should already exist.\n");
-    LOG("  -w: spefity a window length of fft, which must be factrial of 2.\n");
+    LOG("  -w: spefity a window length of fft.\n");
     LOG("  -wt: spefity a window type, which accepts only \"rec\", \"han\", \"ham\", \"blk\", or \"hrs\".\n");
     LOG("  -l: spefity a sample length used in analyzing.\n");
-    LOG("  -ft: spefity to use only ft.\n");
+    LOG("  -psd: spefity to output the power spectral density by Welch's method as well.\n");
+    LOG("  -single: spefity to compute the power spectral density by the fft of float.\n");
+    LOG("  -zoom: spefity a band LOW HIGH in Hz to zoom on by the chirp z instead of the spectrum, at the points of the window length.\n");
     LOG("  -amp: spefity to output in amplitude.\n");
     LOG("  -10log: spefity to output in 10 * log.\n");
     LOG("  -20log: spefity to output in 20 * log.\n");
@@ -53,7 +55,8 @@ typedef struct mutl::ArgumentDescription Desc;
 const Desc descs[] =
 {
     {"h" , 0},
-    {"ft" , 0},
+    {"psd" , 0},
+    {"single" , 0},
     {"rad" , 0},
     {"deg" , 0},
     {"amp" , 0},
@@ -63,7 +66,8 @@ const Desc descs[] =
     {"wt" , 1},
     {"l" , 1},
     {"d" , 1},
-    {"o" , 1}
+    {"o" , 1},
+    {"zoom" , 2}
 };
 
 int main(int argc, const char* argv[])
@@ -108,7 +112,11 @@ int main(int argc, const char* argv[])
     param.sampleCount = 0;
     param.windowLength = 0;
     param.windowType = WindowType_Rectangular;
-    param.isUsedOnlyFt = false;
+    param.isPsdOutput = false;
+    param.isSinglePrecision = false;
+    param.isZoomed = false;
+    param.zoomLow = 0.0;
+    param.zoomHigh = 0.0;
     param.gainFormat = GainFormat_Amplitude;
     param.argFormat = ArgFormat_Radian;
     param.inputFilepath = parser.GetArgument(0);
@@ -127,16 +135,31 @@ int main(int argc, const char* argv[])
     }
     param.outputBase = outdir + outfile;
 
-    if ( parser.IsEnabled("ft") )
+    if ( parser.IsEnabled("psd") )
     {
-        param.isUsedOnlyFt = true;
+        param.isPsdOutput = true;
+    }
+    if ( parser.IsEnabled("single") )
+    {
+        param.isSinglePrecision = true;
+    }
+    if ( parser.IsEnabled("zoom") )
+    {
+        param.zoomLow = atof( parser.GetOption("zoom", 0).c_str() );
+        param.zoomHigh = atof( parser.GetOption("zoom", 1).c_str() );
+        if ( param.zoomLow < 0.0 || param.zoomHigh <= param.zoomLow )
+        {
+            ERROR_LOG("The values specified with -zoom must be 0 <= LOW < HIGH: %g %g\n", param.zoomLow, param.zoomHigh);
+            return 0;
+        }
+        param.isZoomed = true;
     }
     if ( parser.IsEnabled("w") )
     {
-        const size_t width  = atoi( parser.GetOption("w").c_str() );
-        if ( !IsFactorial(width, 2) )
+        const int width  = atoi( parser.GetOption("w").c_str() );
+        if ( width <= 0 )
         {
-            ERROR_LOG("The value specified with -w must be 2^n: %d\n", static_cast<int>(width) );
+            ERROR_LOG("The value specified with -w must be positive: %d\n", width );
             return 0;
         }
         param.windowLength = width;
@@ -201,7 +224,10 @@ int main(int argc, const char* argv[])
     LOG("    Window      : %d\n", static_cast<int>(param.windowLength) );
     LOG("    WindowType  : %d\n", param.windowType);
     LOG("    Sample      : %d\n", static_cast<int>(param.sampleCount) );
-    LOG("    Process     : %s\n", param.isUsedOnlyFt ? "ft" : "fft");
+    if ( param.isZoomed )
+    {
+        LOG("    Zoom        : %g - %g [Hz]\n", param.zoomLow, param.zoomHigh);
+    }
     LOG("    Gain        : %d\n", param.gainFormat);
     LOG("    Argument    : %d\n", param.argFormat);
 
@@ -215,7 +241,6 @@ int main(int argc, const char* argv[])
     LOG("    SignalLength: %d\n", static_cast<int>(param.signal.GetColumnLength()));
     LOG("    Window      : %d\n", static_cast<int>(param.windowLength));
     LOG("    Count       : %d (%d)\n", static_cast<int>(param.signal.GetColumnLength() / param.windowLength), static_cast<int>(param.signal.GetColumnLength() % param.windowLength));
-    LOG("    Process     : %s\n", param.isUsedOnlyFt ? "ft" : "fft");
 
     PRINT_RETURN_IF_FAILED( Process(&param) );
 
@@ -23,11 +23,16 @@
  */
 
 #include <math.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#include <algorithm>
 
 #include "mcon.h"
 #include "types.h"
 #include "status.h"
 #include "debug.h"
+#include "masp/Ft.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -39,252 +44,1832 @@ namespace ft {
 namespace
 {
     const double g_Pi(M_PI);
-    int Ilog2(int v)
+    // Ft() and Ift() of up to this length are computed directly.
+    const size_t g_DirectFtLength = 32;
+    // FftMany() interleaves the transforms up to this length.
+    const size_t g_InterleavedLength = 128;
+    // FftMany() uses threads from this number of elements in total.
+    const size_t g_FftManyParallelThreshold = 256 * 1024;
+    int Count1(int v)
+    {
+        int ans = 0;
+        for (unsigned int i = 0; i < sizeof(v) * 8; ++i)
+        {
+            ans += ((v >> i) & 0x1) ? 1 : 0;
+        }
+        return ans;
+    }
+
+    int Ilog2(size_t v)
+    {
+        int i = 0;
+        for ( ; 1 < v; v >>= 1)
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    // The number of the doubles in the twiddle table of a stage, whose
+    // half width is L: cos and sin of W^k for k in [0, L) in radix 2,
+    // and of W^k, W^2k and W^3k for k in [0, L/2) in radix 4.
+    inline size_t GetRadix2TableLength(size_t L) { return 2 * L; }
+    inline size_t GetRadix4TableLength(size_t L) { return 3 * L; }
+
+    // Whether the first stage is a radix-2 one, so that the rest, down to
+    // the final radix-8 stage, are the pairs of the radix-2 stages.
+    inline bool HasRadix2Stage(size_t N) { return 1 == (Ilog2(N) - 3) % 2; }
+
+    // The kernels below are templated on the sample type, whose lanes of
+    // an AVX register, 4 of double and 8 of float, are handled by the
+    // overloads of each operation.
+    template <typename Type> struct Simd;
+    template <> struct Simd<double>
+    {
+        typedef __m256d Vector;
+        static const size_t Lanes = 4;
+    };
+    template <> struct Simd<float>
+    {
+        typedef __m256 Vector;
+        static const size_t Lanes = 8;
+    };
+
+    inline __m256d LoadU(const double* p) { return _mm256_loadu_pd(p); }
+    inline __m256  LoadU(const float* p)  { return _mm256_loadu_ps(p); }
+    inline void StoreU(double* p, __m256d v) { _mm256_storeu_pd(p, v); }
+    inline void StoreU(float* p, __m256 v)   { _mm256_storeu_ps(p, v); }
+    inline __m256d Set1(double v) { return _mm256_set1_pd(v); }
+    inline __m256  Set1(float v)  { return _mm256_set1_ps(v); }
+    inline __m256d Add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+    inline __m256  Add(__m256 a, __m256 b)   { return _mm256_add_ps(a, b); }
+    inline __m256d Sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+    inline __m256  Sub(__m256 a, __m256 b)   { return _mm256_sub_ps(a, b); }
+    inline __m256d Mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+    inline __m256  Mul(__m256 a, __m256 b)   { return _mm256_mul_ps(a, b); }
+
+#if defined(__FMA__)
+    inline __m256d MulAdd(__m256d a, __m256d b, __m256d c) { return _mm256_fmadd_pd(a, b, c); }
+    inline __m256d MulSub(__m256d a, __m256d b, __m256d c) { return _mm256_fmsub_pd(a, b, c); }
+    inline __m256  MulAdd(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+    inline __m256  MulSub(__m256 a, __m256 b, __m256 c) { return _mm256_fmsub_ps(a, b, c); }
+#else
+    inline __m256d MulAdd(__m256d a, __m256d b, __m256d c) { return Add(Mul(a, b), c); }
+    inline __m256d MulSub(__m256d a, __m256d b, __m256d c) { return Sub(Mul(a, b), c); }
+    inline __m256  MulAdd(__m256 a, __m256 b, __m256 c) { return Add(Mul(a, b), c); }
+    inline __m256  MulSub(__m256 a, __m256 b, __m256 c) { return Sub(Mul(a, b), c); }
+#endif
+
+    // (re + j im) *= (c + j s)
+    inline void Rotate(__m256d& re, __m256d& im, __m256d c, __m256d s)
+    {
+        const __m256d r = MulSub(re, c, Mul(im, s));
+        im = MulAdd(re, s, Mul(im, c));
+        re = r;
+    }
+
+    inline void Rotate(__m256& re, __m256& im, __m256 c, __m256 s)
+    {
+        const __m256 r = MulSub(re, c, Mul(im, s));
+        im = MulAdd(re, s, Mul(im, c));
+        re = r;
+    }
+
+    template <typename Type>
+    inline void Rotate(Type& re, Type& im, Type c, Type s)
+    {
+        const Type r = re * c - im * s;
+        im = re * s + im * c;
+        re = r;
+    }
+
+    // One stage of the decimation in frequency, H = (L - H) * W^k.
+    template <typename Type>
+    void Radix2Stage(Type* real, Type* imag, size_t N, size_t L, const Type* pCos, const Type* pSin)
+    {
+        typedef typename Simd<Type>::Vector Vector;
+        const size_t Lanes = Simd<Type>::Lanes;
+        for (size_t ofs = 0; ofs < N; ofs += L * 2)
+        {
+            Type* pRealL = real + ofs;
+            Type* pImagL = imag + ofs;
+            Type* pRealH = real + ofs + L;
+            Type* pImagH = imag + ofs + L;
+            size_t k = 0;
+            for ( ; k + Lanes <= L; k += Lanes)
+            {
+                const Vector r1 = LoadU(pRealL + k);
+                const Vector i1 = LoadU(pImagL + k);
+                const Vector r2 = LoadU(pRealH + k);
+                const Vector i2 = LoadU(pImagH + k);
+                Vector dr = Sub(r1, r2);
+                Vector di = Sub(i1, i2);
+                Rotate(dr, di, LoadU(pCos + k), LoadU(pSin + k));
+                StoreU(pRealL + k, Add(r1, r2));
+                StoreU(pImagL + k, Add(i1, i2));
+                StoreU(pRealH + k, dr);
+                StoreU(pImagH + k, di);
+            }
+            for ( ; k < L; ++k )
+            {
+                const Type r1 = pRealL[k];
+                const Type i1 = pImagL[k];
+                Type dr = r1 - pRealH[k];
+                Type di = i1 - pImagH[k];
+                Rotate(dr, di, pCos[k], pSin[k]);
+                pRealL[k] = r1 + pRealH[k];
+                pImagL[k] = i1 + pImagH[k];
+                pRealH[k] = dr;
+                pImagH[k] = di;
+            }
+        }
+    }
+
+    // The two stages of the half widths L and L/2 at once, as a radix-4
+    // butterfly on the quarters x0 to x3 of each block of 2L:
+    //     z0 =  (x0 + x2) + (x1 + x3)
+    //     z1 = ((x0 + x2) - (x1 + x3)) W^2k
+    //     z2 = ((x0 - x2) + j'(x1 - x3)) W^k
+    //     z3 = ((x0 - x2) - j'(x1 - x3)) W^3k
+    // where j' = W^(L/2) is -j forward and j inverse. The outputs stay in
+    // the bit-reversed order of the radix-2 stages. L/2 is a multiple of 8,
+    // the lanes of float.
+    template <typename Type>
+    void Radix4Stage(Type* real, Type* imag, size_t N, size_t L, const Type* table, Type sign)
+    {
+        typedef typename Simd<Type>::Vector Vector;
+        const size_t Q = L / 2;
+        const Type* pCos1 = table;
+        const Type* pSin1 = table + Q;
+        const Type* pCos2 = table + 2 * Q;
+        const Type* pSin2 = table + 3 * Q;
+        const Type* pCos3 = table + 4 * Q;
+        const Type* pSin3 = table + 5 * Q;
+        const Vector sv = Set1(sign);
+        for (size_t ofs = 0; ofs < N; ofs += L * 2)
+        {
+            Type* r0 = real + ofs;
+            Type* i0 = imag + ofs;
+            for (size_t k = 0; k < Q; k += Simd<Type>::Lanes)
+            {
+                const Vector x0r = LoadU(r0 + k);
+                const Vector x0i = LoadU(i0 + k);
+                const Vector x1r = LoadU(r0 + Q + k);
+                const Vector x1i = LoadU(i0 + Q + k);
+                const Vector x2r = LoadU(r0 + 2 * Q + k);
+                const Vector x2i = LoadU(i0 + 2 * Q + k);
+                const Vector x3r = LoadU(r0 + 3 * Q + k);
+                const Vector x3i = LoadU(i0 + 3 * Q + k);
+
+                const Vector a0r = Add(x0r, x2r);
+                const Vector a0i = Add(x0i, x2i);
+                const Vector a1r = Sub(x0r, x2r);
+                const Vector a1i = Sub(x0i, x2i);
+                const Vector b0r = Add(x1r, x3r);
+                const Vector b0i = Add(x1i, x3i);
+                // j' (x1 - x3)
+                const Vector b1r = Mul(sv, Sub(x3i, x1i));
+                const Vector b1i = Mul(sv, Sub(x1r, x3r));
+
+                Vector z1r = Sub(a0r, b0r);
+                Vector z1i = Sub(a0i, b0i);
+                Vector z2r = Add(a1r, b1r);
+                Vector z2i = Add(a1i, b1i);
+                Vector z3r = Sub(a1r, b1r);
+                Vector z3i = Sub(a1i, b1i);
+                Rotate(z1r, z1i, LoadU(pCos2 + k), LoadU(pSin2 + k));
+                Rotate(z2r, z2i, LoadU(pCos1 + k), LoadU(pSin1 + k));
+                Rotate(z3r, z3i, LoadU(pCos3 + k), LoadU(pSin3 + k));
+
+                StoreU(r0 + k, Add(a0r, b0r));
+                StoreU(i0 + k, Add(a0i, b0i));
+                StoreU(r0 + Q + k, z1r);
+                StoreU(i0 + Q + k, z1i);
+                StoreU(r0 + 2 * Q + k, z2r);
+                StoreU(i0 + 2 * Q + k, z2i);
+                StoreU(r0 + 3 * Q + k, z3r);
+                StoreU(i0 + 3 * Q + k, z3i);
+            }
+        }
+    }
+
+    // The last three stages, of the half widths 4, 2 and 1, on each
+    // contiguous block of 8 with the constant twiddle factors.
+    template <typename Type>
+    void Radix8Stage(Type* real, Type* imag, size_t N, Type sign)
+    {
+        const Type h = sqrt(0.5);
+        for (size_t ofs = 0; ofs < N; ofs += 8)
+        {
+            Type* r = real + ofs;
+            Type* i = imag + ofs;
+            Type dr, di;
+            // Half width 4, W = W8^k.
+            for (size_t k = 0; k < 4; ++k)
+            {
+                dr = r[k] - r[k + 4];
+                di = i[k] - i[k + 4];
+                r[k] += r[k + 4];
+                i[k] += i[k + 4];
+                r[k + 4] = dr;
+                i[k + 4] = di;
+            }
+            Rotate(r[5], i[5], h, sign * h);
+            Rotate(r[6], i[6], static_cast<Type>(0), sign);
+            Rotate(r[7], i[7], -h, sign * h);
+            // Half width 2, W = W4^k.
+            for (size_t b = 0; b < 8; b += 4)
+            {
+                for (size_t k = b; k < b + 2; ++k)
+                {
+                    dr = r[k] - r[k + 2];
+                    di = i[k] - i[k + 2];
+                    r[k] += r[k + 2];
+                    i[k] += i[k + 2];
+                    r[k + 2] = dr;
+                    i[k + 2] = di;
+                }
+                // * j'
+                dr = r[b + 3];
+                r[b + 3] = - sign * i[b + 3];
+                i[b + 3] = sign * dr;
+            }
+            // Half width 1.
+            for (size_t k = 0; k < 8; k += 2)
+            {
+                dr = r[k] - r[k + 1];
+                di = i[k] - i[k + 1];
+                r[k] += r[k + 1];
+                i[k] += i[k + 1];
+                r[k + 1] = dr;
+                i[k + 1] = di;
+            }
+        }
+    }
+
+    // The stages above on InterleavedCount transforms, each element of
+    // which is the T lanes at real + T k and imag + T k. The operations of
+    // each lane are the same as the ones above, in the same order.
+    template <typename Type>
+    inline typename Simd<Type>::Vector Load(const Type* p, size_t k) { return LoadU(p + Simd<Type>::Lanes * k); }
+    template <typename Type, typename Vector>
+    inline void Store(Type* p, size_t k, Vector v) { StoreU(p + Simd<Type>::Lanes * k, v); }
+
+    template <typename Type>
+    void InterleavedRadix2Stage(Type* real, Type* imag, size_t N, size_t L, const Type* pCos, const Type* pSin)
+    {
+        typedef typename Simd<Type>::Vector Vector;
+        for (size_t ofs = 0; ofs < N; ofs += L * 2)
+        {
+            for (size_t k = ofs; k < ofs + L; ++k)
+            {
+                const Vector r1 = Load(real, k);
+                const Vector i1 = Load(imag, k);
+                const Vector r2 = Load(real, k + L);
+                const Vector i2 = Load(imag, k + L);
+                Vector dr = Sub(r1, r2);
+                Vector di = Sub(i1, i2);
+                Rotate(dr, di, Set1(pCos[k - ofs]), Set1(pSin[k - ofs]));
+                Store(real, k, Add(r1, r2));
+                Store(imag, k, Add(i1, i2));
+                Store(real, k + L, dr);
+                Store(imag, k + L, di);
+            }
+        }
+    }
+
+    template <typename Type>
+    void InterleavedRadix4Stage(Type* real, Type* imag, size_t N, size_t L, const Type* table, Type sign)
+    {
+        typedef typename Simd<Type>::Vector Vector;
+        const size_t Q = L / 2;
+        const Type* pCos1 = table;
+        const Type* pSin1 = table + Q;
+        const Type* pCos2 = table + 2 * Q;
+        const Type* pSin2 = table + 3 * Q;
+        const Type* pCos3 = table + 4 * Q;
+        const Type* pSin3 = table + 5 * Q;
+        const Vector sv = Set1(sign);
+        for (size_t ofs = 0; ofs < N; ofs += L * 2)
+        {
+            for (size_t k = 0; k < Q; ++k)
+            {
+                const size_t i = ofs + k;
+                const Vector x0r = Load(real, i);
+                const Vector x0i = Load(imag, i);
+                const Vector x1r = Load(real, i + Q);
+                const Vector x1i = Load(imag, i + Q);
+                const Vector x2r = Load(real, i + 2 * Q);
+                const Vector x2i = Load(imag, i + 2 * Q);
+                const Vector x3r = Load(real, i + 3 * Q);
+                const Vector x3i = Load(imag, i + 3 * Q);
+
+                const Vector a0r = Add(x0r, x2r);
+                const Vector a0i = Add(x0i, x2i);
+                const Vector a1r = Sub(x0r, x2r);
+                const Vector a1i = Sub(x0i, x2i);
+                const Vector b0r = Add(x1r, x3r);
+                const Vector b0i = Add(x1i, x3i);
+                const Vector b1r = Mul(sv, Sub(x3i, x1i));
+                const Vector b1i = Mul(sv, Sub(x1r, x3r));
+
+                Vector z1r = Sub(a0r, b0r);
+                Vector z1i = Sub(a0i, b0i);
+                Vector z2r = Add(a1r, b1r);
+                Vector z2i = Add(a1i, b1i);
+                Vector z3r = Sub(a1r, b1r);
+                Vector z3i = Sub(a1i, b1i);
+                Rotate(z1r, z1i, Set1(pCos2[k]), Set1(pSin2[k]));
+                Rotate(z2r, z2i, Set1(pCos1[k]), Set1(pSin1[k]));
+                Rotate(z3r, z3i, Set1(pCos3[k]), Set1(pSin3[k]));
+
+                Store(real, i, Add(a0r, b0r));
+                Store(imag, i, Add(a0i, b0i));
+                Store(real, i + Q, z1r);
+                Store(imag, i + Q, z1i);
+                Store(real, i + 2 * Q, z2r);
+                Store(imag, i + 2 * Q, z2i);
+                Store(real, i + 3 * Q, z3r);
+                Store(imag, i + 3 * Q, z3i);
+            }
+        }
+    }
+
+    template <typename Type>
+    void InterleavedRadix8Stage(Type* real, Type* imag, size_t N, Type sign)
+    {
+        typedef typename Simd<Type>::Vector Vector;
+        const Vector h = Set1(static_cast<Type>(sqrt(0.5)));
+        const Vector sh = Set1(static_cast<Type>(sign * sqrt(0.5)));
+        const Vector sv = Set1(sign);
+        const Vector nsv = Set1(- sign);
+        const Vector zero = Set1(static_cast<Type>(0));
+        for (size_t ofs = 0; ofs < N; ofs += 8)
+        {
+            Vector r[8], i[8];
+            for (size_t k = 0; k < 8; ++k)
+            {
+                r[k] = Load(real, ofs + k);
+                i[k] = Load(imag, ofs + k);
+            }
+            Vector dr, di;
+            for (size_t k = 0; k < 4; ++k)
+            {
+                dr = Sub(r[k], r[k + 4]);
+                di = Sub(i[k], i[k + 4]);
+                r[k] = Add(r[k], r[k + 4]);
+                i[k] = Add(i[k], i[k + 4]);
+                r[k + 4] = dr;
+                i[k + 4] = di;
+            }
+            Rotate(r[5], i[5], h, sh);
+            Rotate(r[6], i[6], zero, sv);
+            Rotate(r[7], i[7], Sub(zero, h), sh);
+            for (size_t b = 0; b < 8; b += 4)
+            {
+                for (size_t k = b; k < b + 2; ++k)
+                {
+                    dr = Sub(r[k], r[k + 2]);
+                    di = Sub(i[k], i[k + 2]);
+                    r[k] = Add(r[k], r[k + 2]);
+                    i[k] = Add(i[k], i[k + 2]);
+                    r[k + 2] = dr;
+                    i[k + 2] = di;
+                }
+                dr = r[b + 3];
+                r[b + 3] = Mul(nsv, i[b + 3]);
+                i[b + 3] = Mul(sv, dr);
+            }
+            for (size_t k = 0; k < 8; k += 2)
+            {
+                dr = Sub(r[k], r[k + 1]);
+                di = Sub(i[k], i[k + 1]);
+                r[k] = Add(r[k], r[k + 1]);
+                i[k] = Add(i[k], i[k + 1]);
+                r[k + 1] = dr;
+                i[k + 1] = di;
+            }
+            for (size_t k = 0; k < 8; ++k)
+            {
+                Store(real, ofs + k, r[k]);
+                Store(imag, ofs + k, i[k]);
+            }
+        }
+    }
+
+    // The rows of FftMany, shared by the threads in the groups of
+    // InterleavedCount rows.
+    template <typename Type>
+    struct Rows
+    {
+        const BasicFftPlan<Type>* plan;
+        Type* const* reals;
+        Type* const* imags;
+        size_t count;
+    };
+
+    // The transforms of the rows in the groups [groupBegin, groupEnd)
+    // with a work area of its own. Returns the first failure.
+    template <typename Type>
+    status_t ExecuteRowRange(const Rows<Type>& rows, size_t groupBegin, size_t groupEnd)
+    {
+        const BasicFftPlan<Type>& plan = *rows.plan;
+        Type* const* reals = rows.reals;
+        Type* const* imags = rows.imags;
+        const size_t N = plan.GetLength();
+        const size_t T = BasicFftPlan<Type>::InterleavedCount;
+        const size_t end = std::min(rows.count, groupEnd * T);
+        const bool isInterleaved = 0 == plan.GetWorkLength() && N <= g_InterleavedLength;
+        const size_t workLength = isInterleaved ? 2 * T * N : plan.GetWorkLength();
+        Type* work = 0 < workLength ? new Type[workLength] : NULL;
+        status_t status = NO_ERROR;
+        size_t i = std::min(rows.count, groupBegin * T);
+        if ( isInterleaved )
+        {
+            for ( ; NO_ERROR == status && i + T <= end; i += T)
+            {
+                status = plan.ExecuteInterleaved(reals + i, imags + i, work);
+            }
+        }
+        for ( ; NO_ERROR == status && i < end; ++i)
+        {
+            status = plan.Execute(reals[i], imags[i], work);
+        }
+        delete[] work;
+        return status;
+    }
+
+    template <typename Type>
+    status_t ExecuteRows(const BasicFftPlan<Type>& plan, Type* const* reals, Type* const* imags, size_t count, size_t threadCount)
+    {
+        const size_t T = BasicFftPlan<Type>::InterleavedCount;
+        const Rows<Type> rows = { &plan, reals, imags, count };
+        // Each thread takes a contiguous range of the groups of T rows.
+        threadCount = mcon::GetThreadCount(threadCount, count * plan.GetLength(), g_FftManyParallelThreshold);
+        return mcon::ForRanges(ExecuteRowRange<Type>, rows, (count + T - 1) / T, threadCount);
+    }
+
+    // The largest radix of the mixed-radix stages.
+    const size_t g_MaxRadix = 7;
+
+    // The DFT of p points, y[u] = sum_r x[r] w^(ru), where w^k is given
+    // by pCos[k] and pSin[k].
+    template <typename Type>
+    inline void Butterfly(Type* yr, Type* yi, const Type* xr, const Type* xi, size_t p, const Type* pCos, const Type* pSin)
+    {
+        switch (p)
+        {
+        case 2:
+            yr[0] = xr[0] + xr[1];
+            yi[0] = xi[0] + xi[1];
+            yr[1] = xr[0] - xr[1];
+            yi[1] = xi[0] - xi[1];
+            break;
+        case 4:
+        {
+            // w = j', which is -j forward and j inverse.
+            const Type sign = pSin[1];
+            const Type a0r = xr[0] + xr[2];
+            const Type a0i = xi[0] + xi[2];
+            const Type a1r = xr[0] - xr[2];
+            const Type a1i = xi[0] - xi[2];
+            const Type b0r = xr[1] + xr[3];
+            const Type b0i = xi[1] + xi[3];
+            const Type b1r = sign * (xi[3] - xi[1]);
+            const Type b1i = sign * (xr[1] - xr[3]);
+            yr[0] = a0r + b0r;
+            yi[0] = a0i + b0i;
+            yr[1] = a1r + b1r;
+            yi[1] = a1i + b1i;
+            yr[2] = a0r - b0r;
+            yi[2] = a0i - b0i;
+            yr[3] = a1r - b1r;
+            yi[3] = a1i - b1i;
+            break;
+        }
+        default:
+            for (size_t u = 0; u < p; ++u)
+            {
+                Type sr = xr[0];
+                Type si = xi[0];
+                for (size_t r = 1, k = u; r < p; ++r, k = (k + u) % p)
+                {
+                    sr += xr[r] * pCos[k] - xi[r] * pSin[k];
+                    si += xr[r] * pSin[k] + xi[r] * pCos[k];
+                }
+                yr[u] = sr;
+                yi[u] = si;
+            }
+            break;
+        }
+    }
+
+    // One stage of the Stockham decimation in frequency of the radix p
+    // from x to y, on the sub-transforms of n points interleaved by s:
+    //     y[q + s(p k + u)] = W_n^(ku) sum_r x[q + s(k + r n/p)] w_p^(ru)
+    // where W_n^(ku) = W^(kus) of the table of W^k for k in [0, N).
+    template <typename Type>
+    void MixedRadixStage(Type* yr, Type* yi, const Type* xr, const Type* xi,
+                         size_t N, size_t n, size_t s, size_t p, const Type* pCos, const Type* pSin)
+    {
+        const size_t m = n / p;
+        Type rc[g_MaxRadix], rs[g_MaxRadix];
+        for (size_t k = 0; k < p; ++k)
+        {
+            rc[k] = pCos[k * (N / p)];
+            rs[k] = pSin[k * (N / p)];
+        }
+        Type wc[g_MaxRadix], ws[g_MaxRadix];
+        Type ar[g_MaxRadix], ai[g_MaxRadix];
+        Type br[g_MaxRadix], bi[g_MaxRadix];
+        for (size_t k = 0; k < m; ++k)
+        {
+            for (size_t u = 0; u < p; ++u)
+            {
+                wc[u] = pCos[k * u * s];
+                ws[u] = pSin[k * u * s];
+            }
+            for (size_t q = 0; q < s; ++q)
+            {
+                for (size_t r = 0; r < p; ++r)
+                {
+                    ar[r] = xr[q + s * (k + r * m)];
+                    ai[r] = xi[q + s * (k + r * m)];
+                }
+                Butterfly(br, bi, ar, ai, p, rc, rs);
+                yr[q + s * p * k] = br[0];
+                yi[q + s * p * k] = bi[0];
+                for (size_t u = 1; u < p; ++u)
+                {
+                    Rotate(br[u], bi[u], wc[u], ws[u]);
+                    yr[q + s * (p * k + u)] = br[u];
+                    yi[q + s * (p * k + u)] = bi[u];
+                }
+            }
+        }
+    }
+
+    template <typename Type>
+    void SetTwiddles(Type* pCos, Type* pSin, size_t length, size_t multiplier, size_t L, double sign)
+    {
+        // W = exp(sign j 2 pi / (2L)), computed in double for any Type.
+        const double df = g_Pi / L;
+        for (size_t k = 0; k < length; ++k)
+        {
+            pCos[k] = cos(df * k * multiplier);
+            pSin[k] = sign * sin(df * k * multiplier);
+        }
+    }
+
+    // The state of the four-step FFT of N = N1 x N2, shared by the threads
+    // of each step.
+    template <typename Type>
+    struct FourStep
+    {
+        size_t N1;
+        size_t N2;
+        int log2N1;
+        // Of N1 and N2, in the direction of the whole.
+        const BasicFftPlan<Type>* pColumnPlan;
+        const BasicFftPlan<Type>* pRowPlan;
+        // W^b for b in [0, N1) and W^(a N1) for a in [0, N2).
+        const Type* pCosB;
+        const Type* pSinB;
+        const Type* pCosA;
+        const Type* pSinA;
+        Type* real;
+        Type* imag;
+        Type* workReal;
+        Type* workImag;
+        // The buffer of TransformColumns() in the work area on a single
+        // thread, or NULL to allocate one for each range.
+        Type* columnBuffer;
+    };
+
+    // The FFTs of N1 on the columns n2 of the data of N1 x N2 into the
+    // work area of the same layout, each multiplied by W^(n2 k1), which
+    // is W^(a N1) W^b for n2 k1 = a N1 + b. The columns are taken in the
+    // blocks of 2 InterleavedCount, a cache line of double, whose pieces
+    // of the rows are already interleaved for the FFT of each half.
+    template <typename Type>
+    void TransformColumns(const FourStep<Type>& s, size_t begin, size_t end)
+    {
+        const size_t N1 = s.N1;
+        const size_t N2 = s.N2;
+        const size_t T = BasicFftPlan<Type>::InterleavedCount;
+        const size_t B = 2 * T;
+        const size_t mask = N1 - 1;
+        Type* buffer = NULL != s.columnBuffer ? s.columnBuffer : new Type[2 * B * N1];
+        Type* reals[2] = { buffer, buffer + T * N1 };
+        Type* imags[2] = { buffer + B * N1, buffer + (B + T) * N1 };
+        for (size_t n2 = begin * B; n2 < end * B; n2 += B)
+        {
+            for (size_t n1 = 0; n1 < N1; ++n1)
+            {
+                const Type* re = s.real + n1 * N2 + n2;
+                const Type* im = s.imag + n1 * N2 + n2;
+                for (size_t h = 0; h < 2; ++h)
+                {
+                    memcpy(reals[h] + T * n1, re + h * T, T * sizeof(Type));
+                    memcpy(imags[h] + T * n1, im + h * T, T * sizeof(Type));
+                }
+            }
+            s.pColumnPlan->ExecuteInterleaved(reals[0], imags[0]);
+            s.pColumnPlan->ExecuteInterleaved(reals[1], imags[1]);
+            for (size_t k1 = 0; k1 < N1; ++k1)
+            {
+                Type* re = s.workReal + k1 * N2 + n2;
+                Type* im = s.workImag + k1 * N2 + n2;
+                for (size_t t = 0; t < B; ++t)
+                {
+                    const size_t m = (n2 + t) * k1;
+                    const size_t a = m >> s.log2N1;
+                    const size_t b = m & mask;
+                    Type c = s.pCosA[a];
+                    Type sn = s.pSinA[a];
+                    Rotate(c, sn, s.pCosB[b], s.pSinB[b]);
+                    re[t] = reals[t / T][T * k1 + t % T];
+                    im[t] = imags[t / T][T * k1 + t % T];
+                    Rotate(re[t], im[t], c, sn);
+                }
+            }
+        }
+        if ( buffer != s.columnBuffer )
+        {
+            delete[] buffer;
+        }
+    }
+
+    // The FFTs of N2 on the rows k1 of the work area, written back to the
+    // data transposed to X[k1 + N1 k2]. The rows are taken in the blocks
+    // of 2 InterleavedCount so that a cache line is written at once.
+    template <typename Type>
+    void TransformRows(const FourStep<Type>& s, size_t begin, size_t end)
+    {
+        const size_t N1 = s.N1;
+        const size_t N2 = s.N2;
+        const size_t B = 2 * BasicFftPlan<Type>::InterleavedCount;
+        for (size_t k1 = begin * B; k1 < end * B; k1 += B)
+        {
+            const Type* re = s.workReal + k1 * N2;
+            const Type* im = s.workImag + k1 * N2;
+            for (size_t t = 0; t < B; ++t)
+            {
+                s.pRowPlan->Execute(s.workReal + (k1 + t) * N2, s.workImag + (k1 + t) * N2, NULL);
+            }
+            for (size_t k2 = 0; k2 < N2; ++k2)
+            {
+                for (size_t t = 0; t < B; ++t)
+                {
+                    s.real[k2 * N1 + k1 + t] = re[t * N2 + k2];
+                    s.imag[k2 * N1 + k1 + t] = im[t * N2 + k2];
+                }
+            }
+        }
+    }
+}
+
+template <typename Type>
+BasicFftPlan<Type>::BasicFftPlan(size_t length, Direction direction)
+    : m_Length(0)
+    , m_Direction(direction)
+    , m_Twiddles(NULL)
+    , m_Swaps(NULL)
+    , m_SwapCount(0)
+    , m_Radices(NULL)
+    , m_RadixCount(0)
+    , m_Inner(NULL)
+    , m_ColumnPlan(NULL)
+    , m_RowPlan(NULL)
+    , m_WorkLength(0)
+{
+    const size_t N = length;
+    if ( 0 == N )
+    {
+        return;
+    }
+    m_Length = N;
+    const double sign = Direction_Forward == direction ? -1.0 : 1.0;
+    if ( Count1(N) == 1 )
+    {
+        if ( FourStepLength <= N && N / FourStepLength < FourStepLength )
+        {
+            SetupFourStep(sign);
+        }
+        else
+        {
+            SetupPowerOf2(sign);
+        }
+        return;
+    }
+    // The radix 4 first, which has the fewest operations per element.
+    const size_t candidates[] = {4, 2, 3, 5, 7};
+    size_t radices[sizeof(size_t) * 8];
+    size_t count = 0;
+    size_t rest = N;
+    for (unsigned int i = 0; i < sizeof(candidates)/sizeof(size_t); ++i)
+    {
+        for ( ; 0 == rest % candidates[i]; rest /= candidates[i])
+        {
+            radices[count++] = candidates[i];
+        }
+    }
+    if ( 1 == rest )
+    {
+        SetupMixedRadix(radices, count, sign);
+    }
+    else
+    {
+        SetupBluestein(sign);
+    }
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::SetupPowerOf2(double sign)
+{
+    const size_t N = m_Length;
+    // The tables of the stages in the order of Execute().
+    size_t tableLength = 0;
+    size_t L = N / 2;
+    if ( N < 8 )
+    {
+        tableLength = GetRadix2TableLength(N);
+    }
+    else
+    {
+        if ( HasRadix2Stage(N) )
+        {
+            tableLength += GetRadix2TableLength(L);
+            L >>= 1;
+        }
+        for ( ; 8 <= L; L >>= 2)
+        {
+            tableLength += GetRadix4TableLength(L);
+        }
+    }
+    m_Twiddles = new Type[tableLength + 1];
+    Type* table = m_Twiddles;
+    L = N / 2;
+    if ( N < 8 )
+    {
+        for ( ; 0 < L; L >>= 1)
+        {
+            SetTwiddles(table, table + L, L, 1, L, sign);
+            table += GetRadix2TableLength(L);
+        }
+    }
+    else
+    {
+        if ( HasRadix2Stage(N) )
+        {
+            SetTwiddles(table, table + L, L, 1, L, sign);
+            table += GetRadix2TableLength(L);
+            L >>= 1;
+        }
+        for ( ; 8 <= L; L >>= 2)
+        {
+            const size_t Q = L / 2;
+            for (size_t m = 1; m <= 3; ++m)
+            {
+                SetTwiddles(table + 2 * (m - 1) * Q, table + (2 * m - 1) * Q, Q, m, L, sign);
+            }
+            table += GetRadix4TableLength(L);
+        }
+    }
+
+    // The bit-reversed index is carried over from i - 1 by adding 1 from
+    // the top bit, instead of reversing every bit of each index.
+    size_t count = 0;
+    for (size_t i = 0, k = 0; i < N; ++i)
+    {
+        if ( i < k )
+        {
+            ++count;
+        }
+        size_t bit = N >> 1;
+        for ( ; 0 < bit && (k & bit); bit >>= 1)
+        {
+            k ^= bit;
+        }
+        k |= bit;
+    }
+    m_Swaps = new size_t[2 * count + 1];
+    for (size_t i = 0, k = 0; i < N; ++i)
+    {
+        if ( i < k )
+        {
+            m_Swaps[2 * m_SwapCount + 0] = i;
+            m_Swaps[2 * m_SwapCount + 1] = k;
+            ++m_SwapCount;
+        }
+        size_t bit = N >> 1;
+        for ( ; 0 < bit && (k & bit); bit >>= 1)
+        {
+            k ^= bit;
+        }
+        k |= bit;
+    }
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::SetupMixedRadix(const size_t radices[], size_t count, double sign)
+{
+    const size_t N = m_Length;
+    m_Radices = new size_t[count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_Radices[i] = radices[i];
+    }
+    m_RadixCount = count;
+    // W^k = exp(sign j 2 pi k / N)
+    m_Twiddles = new Type[2 * N];
+    const double df = 2.0 * g_Pi / N;
+    for (size_t k = 0; k < N; ++k)
+    {
+        m_Twiddles[k] = cos(df * k);
+        m_Twiddles[N + k] = sign * sin(df * k);
+    }
+    m_WorkLength = 2 * N;
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::SetupBluestein(double sign)
+{
+    // X[k] = c[k] sum_n (x[n] c[n]) conj(c[k - n]), c[n] = exp(sign j pi n^2 / N),
+    // since nk = (n^2 + k^2 - (k - n)^2) / 2.
+    const size_t N = m_Length;
+    size_t M = 1;
+    for ( ; M < 2 * N - 1; M <<= 1);
+    m_Inner = new BasicFftPlan<Type>(M);
+    m_Twiddles = new Type[2 * N + 2 * M];
+    Type* pCos = m_Twiddles;
+    Type* pSin = m_Twiddles + N;
+    const double df = g_Pi / N;
+    for (size_t n = 0; n < N; ++n)
+    {
+        // n^2 modulo 2N keeps the phase accurate for a large n.
+        const size_t n2 = static_cast<size_t>( (static_cast<uint64_t>(n) * n) % (2 * N) );
+        pCos[n] = cos(df * n2);
+        pSin[n] = sign * sin(df * n2);
+    }
+    // conj(c[m]) at m and M - m, the negative indices of the circular convolution.
+    Type* pReal = m_Twiddles + 2 * N;
+    Type* pImag = pReal + M;
+    for (size_t m = 0; m < M; ++m)
+    {
+        pReal[m] = 0.0;
+        pImag[m] = 0.0;
+    }
+    for (size_t m = 0; m < N; ++m)
+    {
+        pReal[m] = pCos[m];
+        pImag[m] = - pSin[m];
+        if ( 0 < m )
+        {
+            pReal[M - m] = pCos[m];
+            pImag[M - m] = - pSin[m];
+        }
+    }
+    m_Inner->Execute(pReal, pImag);
+    m_WorkLength = 2 * M + m_Inner->GetWorkLength();
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::SetupFourStep(double sign)
+{
+    // N1 = 2^floor(log2(N) / 2) and N2 = N / N1, which is N1 or 2 N1.
+    const size_t N = m_Length;
+    const size_t N1 = static_cast<size_t>(1) << (Ilog2(N) / 2);
+    const size_t N2 = N / N1;
+    m_ColumnPlan = new BasicFftPlan<Type>(N1, m_Direction);
+    m_RowPlan = new BasicFftPlan<Type>(N2, m_Direction);
+    m_Twiddles = new Type[2 * (N1 + N2)];
+    const double df = 2.0 * g_Pi / N;
+    for (size_t b = 0; b < N1; ++b)
+    {
+        m_Twiddles[b] = cos(df * b);
+        m_Twiddles[N1 + b] = sign * sin(df * b);
+    }
+    Type* pCosA = m_Twiddles + 2 * N1;
+    for (size_t a = 0; a < N2; ++a)
+    {
+        pCosA[a] = cos(df * a * N1);
+        pCosA[N2 + a] = sign * sin(df * a * N1);
+    }
+    // The data of N1 x N2 and the buffer of the columns on a single thread.
+    m_WorkLength = 2 * N + 4 * InterleavedCount * N1;
+}
+
+template <typename Type>
+BasicFftPlan<Type>::~BasicFftPlan()
+{
+    delete[] m_Twiddles;
+    delete[] m_Swaps;
+    delete[] m_Radices;
+    delete m_Inner;
+    delete m_ColumnPlan;
+    delete m_RowPlan;
+}
+
+template <typename Type>
+status_t BasicFftPlan<Type>::Execute(Type real[], Type imag[]) const
+{
+    if ( 0 == m_WorkLength )
+    {
+        return Execute(real, imag, NULL, 0);
+    }
+    Type* work = new Type[m_WorkLength];
+    const status_t status = Execute(real, imag, work, 0);
+    delete[] work;
+    return status;
+}
+
+template <typename Type>
+status_t BasicFftPlan<Type>::Execute(Type real[], Type imag[], Type work[]) const
+{
+    return Execute(real, imag, work, 1);
+}
+
+template <typename Type>
+status_t BasicFftPlan<Type>::Execute(Type real[], Type imag[], Type work[], size_t threadCount) const
+{
+    const size_t N = m_Length;
+    if ( IsNull() || NULL == real || NULL == imag
+        || (0 < m_WorkLength && NULL == work) )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    if ( NULL != m_Inner )
+    {
+        ExecuteBluestein(real, imag, work, threadCount);
+    }
+    else if ( NULL != m_Radices )
+    {
+        ExecuteMixedRadix(real, imag, work);
+    }
+    else if ( NULL != m_ColumnPlan )
+    {
+        // Divided by N1 and N2 in the inner ones.
+        ExecuteFourStep(real, imag, work, threadCount);
+        return NO_ERROR;
+    }
+    else
+    {
+        ExecutePowerOf2(real, imag);
+    }
+    if ( Direction_Inverse == m_Direction )
+    {
+        const Type scale = 1.0 / N;
+        for (size_t i = 0; i < N; ++i)
+        {
+            real[i] *= scale;
+            imag[i] *= scale;
+        }
+    }
+    return NO_ERROR;
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::ExecutePowerOf2(Type real[], Type imag[]) const
+{
+    const size_t N = m_Length;
+    const Type sign = Direction_Forward == m_Direction ? -1.0 : 1.0;
+    // Decimation in frequency.
+    const Type* table = m_Twiddles;
+    size_t L = N / 2;
+    if ( N < 8 )
+    {
+        for ( ; 0 < L; L >>= 1)
+        {
+            Radix2Stage(real, imag, N, L, table, table + L);
+            table += GetRadix2TableLength(L);
+        }
+    }
+    else
+    {
+        if ( HasRadix2Stage(N) )
+        {
+            Radix2Stage(real, imag, N, L, table, table + L);
+            table += GetRadix2TableLength(L);
+            L >>= 1;
+        }
+        for ( ; 8 <= L; L >>= 2)
+        {
+            Radix4Stage(real, imag, N, L, table, sign);
+            table += GetRadix4TableLength(L);
+        }
+        Radix8Stage(real, imag, N, sign);
+    }
+    // Bit-reverse
+    for (size_t i = 0; i < m_SwapCount; ++i)
+    {
+        const size_t a = m_Swaps[2 * i + 0];
+        const size_t b = m_Swaps[2 * i + 1];
+        const Type real_temp = real[a];
+        const Type imag_temp = imag[a];
+        real[a] = real[b];
+        imag[a] = imag[b];
+        real[b] = real_temp;
+        imag[b] = imag_temp;
+    }
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::ExecuteMixedRadix(Type real[], Type imag[], Type work[]) const
+{
+    const size_t N = m_Length;
+    // Back and forth between the data and the work area.
+    Type* xr = real;
+    Type* xi = imag;
+    Type* yr = work;
+    Type* yi = work + N;
+    size_t n = N;
+    size_t s = 1;
+    for (size_t i = 0; i < m_RadixCount; ++i)
+    {
+        const size_t p = m_Radices[i];
+        MixedRadixStage(yr, yi, xr, xi, N, n, s, p, m_Twiddles, m_Twiddles + N);
+        std::swap(xr, yr);
+        std::swap(xi, yi);
+        n /= p;
+        s *= p;
+    }
+    if ( xr != real )
+    {
+        memcpy(real, xr, N * sizeof(Type));
+        memcpy(imag, xi, N * sizeof(Type));
+    }
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::ExecuteBluestein(Type real[], Type imag[], Type work[], size_t threadCount) const
+{
+    const size_t N = m_Length;
+    const size_t M = m_Inner->GetLength();
+    const Type* pCos = m_Twiddles;
+    const Type* pSin = m_Twiddles + N;
+    const Type* pReal = m_Twiddles + 2 * N;
+    const Type* pImag = pReal + M;
+    Type* ar = work;
+    Type* ai = work + M;
+    for (size_t n = 0; n < N; ++n)
+    {
+        ar[n] = real[n];
+        ai[n] = imag[n];
+        Rotate(ar[n], ai[n], pCos[n], pSin[n]);
+    }
+    for (size_t n = N; n < M; ++n)
+    {
+        ar[n] = 0.0;
+        ai[n] = 0.0;
+    }
+    m_Inner->Execute(ar, ai, work + 2 * M, threadCount);
+    // The inverse FFT of the product as conj(FFT(conj(product))) / M.
+    for (size_t k = 0; k < M; ++k)
+    {
+        Rotate(ar[k], ai[k], pReal[k], pImag[k]);
+        ai[k] = - ai[k];
+    }
+    m_Inner->Execute(ar, ai, work + 2 * M, threadCount);
+    const Type scale = 1.0 / M;
+    for (size_t k = 0; k < N; ++k)
+    {
+        real[k] = ar[k] * scale;
+        imag[k] = - ai[k] * scale;
+        Rotate(real[k], imag[k], pCos[k], pSin[k]);
+    }
+}
+
+template <typename Type>
+void BasicFftPlan<Type>::ExecuteFourStep(Type real[], Type imag[], Type work[], size_t threadCount) const
+{
+    const size_t N = m_Length;
+    const size_t N1 = m_ColumnPlan->GetLength();
+    const size_t N2 = m_RowPlan->GetLength();
+    threadCount = mcon::GetThreadCount(threadCount, N, 0);
+    const FourStep<Type> s =
+    {
+        N1, N2, Ilog2(N1), m_ColumnPlan, m_RowPlan,
+        m_Twiddles, m_Twiddles + N1, m_Twiddles + 2 * N1, m_Twiddles + 2 * N1 + N2,
+        real, imag, work, work + N, 1 == threadCount ? work + 2 * N : NULL
+    };
+    mcon::ForRanges(TransformColumns<Type>, s, N2 / (2 * InterleavedCount), threadCount);
+    mcon::ForRanges(TransformRows<Type>, s, N1 / (2 * InterleavedCount), threadCount);
+}
+
+template <typename Type>
+status_t BasicFftPlan<Type>::Execute(mcon::Matrix<Type>& complex) const
+{
+    if ( IsNull() || complex.GetRowLength() < 2 || complex.GetColumnLength() != m_Length )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    return Execute(&complex[0][0], &complex[1][0]);
+}
+
+template <typename Type>
+status_t BasicFftPlan<Type>::ExecuteInterleaved(Type* const real[], Type* const imag[], Type work[]) const
+{
+    const size_t N = m_Length;
+    const size_t T = InterleavedCount;
+    if ( IsNull() || 0 < m_WorkLength || NULL == real || NULL == imag || NULL == work )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    for (size_t t = 0; t < T; ++t)
+    {
+        if ( NULL == real[t] || NULL == imag[t] )
+        {
+            return -ERROR_ILLEGAL;
+        }
+    }
+    Type* re = work;
+    Type* im = work + T * N;
+    for (size_t k = 0; k < N; ++k)
+    {
+        for (size_t t = 0; t < T; ++t)
+        {
+            re[T * k + t] = real[t][k];
+            im[T * k + t] = imag[t][k];
+        }
+    }
+    ExecuteInterleavedStages(re, im);
+    // Back to the rows, swapped by the bit-reversal permutation.
+    for (size_t k = 0; k < N; ++k)
+    {
+        for (size_t t = 0; t < T; ++t)
+        {
+            real[t][k] = re[T * k + t];
+            imag[t][k] = im[T * k + t];
+        }
+    }
+    for (size_t i = 0; i < m_SwapCount; ++i)
+    {
+        const size_t a = m_Swaps[2 * i + 0];
+        const size_t b = m_Swaps[2 * i + 1];
+        for (size_t t = 0; t < T; ++t)
+        {
+            real[t][a] = re[T * b + t];
+            imag[t][a] = im[T * b + t];
+            real[t][b] = re[T * a + t];
+            imag[t][b] = im[T * a + t];
+        }
+    }
+    if ( Direction_Inverse == m_Direction )
     {
-        for (int i = sizeof(v) * 8 - 1; i >= 0 ; --i)
+        const Type scale = 1.0 / N;
+        for (size_t t = 0; t < T; ++t)
         {
-            if ((v >> i) & 0x1)
+            for (size_t i = 0; i < N; ++i)
             {
-                return i;
+                real[t][i] *= scale;
+                imag[t][i] *= scale;
             }
         }
+    }
+    return NO_ERROR;
+}
+
+template <typename Type>
+status_t BasicFftPlan<Type>::ExecuteInterleaved(Type real[], Type imag[]) const
+{
+    const size_t N = m_Length;
+    const size_t T = InterleavedCount;
+    if ( IsNull() || 0 < m_WorkLength || NULL == real || NULL == imag )
+    {
         return -ERROR_ILLEGAL;
     }
-    int Count1(int v)
+    ExecuteInterleavedStages(real, imag);
+    for (size_t i = 0; i < m_SwapCount; ++i)
     {
-        int ans = 0;
-        for (unsigned int i = 0; i < sizeof(v) * 8; ++i)
+        const size_t a = T * m_Swaps[2 * i + 0];
+        const size_t b = T * m_Swaps[2 * i + 1];
+        for (size_t t = 0; t < T; ++t)
         {
-            ans += ((v >> i) & 0x1) ? 1 : 0;
+            std::swap(real[a + t], real[b + t]);
+            std::swap(imag[a + t], imag[b + t]);
         }
-        return ans;
     }
-    int BitReverse(int v, int w) // value, width
+    if ( Direction_Inverse == m_Direction )
     {
-        int x = 0;
-        for (int i = 0; i < w; ++i)
+        const Type scale = 1.0 / N;
+        for (size_t i = 0; i < T * N; ++i)
         {
-            x |= (((v >> i) & 0x1) << (w - i - 1));
+            real[i] *= scale;
+            imag[i] *= scale;
         }
-        return x;
     }
+    return NO_ERROR;
 }
 
-status_t Fft(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries)
+// The same stages as ExecutePowerOf2() on the interleaved transforms.
+template <typename Type>
+void BasicFftPlan<Type>::ExecuteInterleavedStages(Type re[], Type im[]) const
 {
-    const size_t N = timeSeries.GetLength();
-    if (Count1(N) != 1)
+    const size_t N = m_Length;
+    const Type sign = Direction_Forward == m_Direction ? -1.0 : 1.0;
+    const Type* table = m_Twiddles;
+    size_t L = N / 2;
+    if ( N < 8 )
     {
-        return -ERROR_ILLEGAL;
+        for ( ; 0 < L; L >>= 1)
+        {
+            InterleavedRadix2Stage(re, im, N, L, table, table + L);
+            table += GetRadix2TableLength(L);
+        }
     }
-    bool status = complex.Resize(2, N);
-    if (false == status)
+    else
     {
-        return -ERROR_CANNOT_ALLOCATE_MEMORY;
+        if ( HasRadix2Stage(N) )
+        {
+            InterleavedRadix2Stage(re, im, N, L, table, table + L);
+            table += GetRadix2TableLength(L);
+            L >>= 1;
+        }
+        for ( ; 8 <= L; L >>= 2)
+        {
+            InterleavedRadix4Stage(re, im, N, L, table, sign);
+            table += GetRadix4TableLength(L);
+        }
+        InterleavedRadix8Stage(re, im, N, sign);
     }
-    mcon::VectordBase& real = complex[0];
-    mcon::VectordBase& imag = complex[1];
+}
 
+template <typename Type>
+BasicRealFftPlan<Type>::BasicRealFftPlan(size_t length)
+    : m_Length(0)
+    , m_Forward(length / 2)
+    , m_Inverse(length / 2, BasicFftPlan<Type>::Direction_Inverse)
+    , m_Cos(NULL)
+    , m_Sin(NULL)
+{
+    const size_t N = length;
+    if ( N < 2 || 0 != N % 2 )
+    {
+        return;
+    }
+    const size_t count = N / 4 + 1;
+    m_Cos = new Type[count];
+    m_Sin = new Type[count];
     const double df = 2.0 * g_Pi / N;
+    for (size_t k = 0; k < count; ++k)
+    {
+        m_Cos[k] = cos(df * k);
+        m_Sin[k] = - sin(df * k);
+    }
+    m_Length = N;
+}
 
-    mcon::Vector<double> sinTable(N/2);
-    mcon::Vector<double> cosTable(N/2);
+template <typename Type>
+BasicRealFftPlan<Type>::~BasicRealFftPlan()
+{
+    delete[] m_Cos;
+    delete[] m_Sin;
+}
 
-    for (size_t i = 0; i < N / 2; ++i)
+template <typename Type>
+status_t BasicRealFftPlan<Type>::Forward(Type real[], Type imag[], const Type timeSeries[]) const
+{
+    if ( 0 == GetWorkLength() )
     {
-        sinTable[i] = sin(df * i);
-        cosTable[i] = cos(df * i);
+        return Forward(real, imag, timeSeries, NULL);
+    }
+    Type* work = new Type[GetWorkLength()];
+    const status_t status = Forward(real, imag, timeSeries, work);
+    delete[] work;
+    return status;
+}
+
+template <typename Type>
+status_t BasicRealFftPlan<Type>::Forward(Type real[], Type imag[], const Type timeSeries[], Type work[]) const
+{
+    const size_t M = m_Length / 2;
+    if ( IsNull() || NULL == real || NULL == imag || NULL == timeSeries
+        || (0 < GetWorkLength() && NULL == work) )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    // The output is used as the work area of the half length FFT.
+    for (size_t n = 0; n < M; ++n)
+    {
+        real[n] = timeSeries[2 * n + 0];
+        imag[n] = timeSeries[2 * n + 1];
+    }
+    const status_t status = m_Forward.Execute(real, imag, work);
+    if ( NO_ERROR != status )
+    {
+        return status;
     }
-    // Substitute beforehand
-    real = timeSeries;
-    imag = 0;
 
-    size_t innerLoop = N / 2;
-    int outerLoop = 1;
-    //DEBUG_LOG("N=%d\n", N);
+    // X[k] = E + W^k O and X[M-k] = conj(E - W^k O), where
+    //     E = (Z[k] + conj(Z[M-k])) / 2
+    //     O = (Z[k] - conj(Z[M-k])) / 2j
+    // are the transforms of the even and the odd samples.
+    const Type half = 0.5;
+    const Type r0 = real[0];
+    const Type i0 = imag[0];
+    real[0] = r0 + i0;
+    imag[0] = 0;
+    real[M] = r0 - i0;
+    imag[M] = 0;
+    for (size_t k = 1; k <= M / 2; ++k)
+    {
+        const size_t m = M - k;
+        const Type er = (real[k] + real[m]) * half;
+        const Type ei = (imag[k] - imag[m]) * half;
+        const Type orr = (imag[k] + imag[m]) * half;
+        const Type oi = (real[m] - real[k]) * half;
+        const Type c = m_Cos[k];
+        const Type s = m_Sin[k];
+        const Type wr = c * orr - s * oi;
+        const Type wi = c * oi + s * orr;
+        real[k] = er + wr;
+        imag[k] = ei + wi;
+        real[m] = er - wr;
+        imag[m] = wi - ei;
+    }
+    return NO_ERROR;
+}
 
-    // Decimation in frequency.
-    for ( ; 0 < innerLoop; innerLoop >>= 1, outerLoop <<= 1)
+template <typename Type>
+status_t BasicRealFftPlan<Type>::Inverse(Type timeSeries[], Type real[], Type imag[]) const
+{
+    const size_t M = m_Length / 2;
+    if ( IsNull() || NULL == real || NULL == imag || NULL == timeSeries )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    // Z[k] = E + j O and Z[M-k] = conj(E) + j conj(O), where
+    //     E = (X[k] + conj(X[M-k])) / 2
+    //     O = (X[k] - conj(X[M-k])) conj(W^k) / 2
+    const Type half = 0.5;
+    const Type x0 = real[0];
+    const Type xM = real[M];
+    real[0] = (x0 + xM) * half;
+    imag[0] = (x0 - xM) * half;
+    for (size_t k = 1; k <= M / 2; ++k)
+    {
+        const size_t m = M - k;
+        const Type er = (real[k] + real[m]) * half;
+        const Type ei = (imag[k] - imag[m]) * half;
+        const Type dr = (real[k] - real[m]) * half;
+        const Type di = (imag[k] + imag[m]) * half;
+        const Type c = m_Cos[k];
+        const Type s = m_Sin[k];
+        const Type orr = dr * c + di * s;
+        const Type oi = di * c - dr * s;
+        real[k] = er - oi;
+        imag[k] = ei + orr;
+        real[m] = er + oi;
+        imag[m] = orr - ei;
+    }
+    const status_t status = m_Inverse.Execute(real, imag);
+    if ( NO_ERROR != status )
+    {
+        return status;
+    }
+    for (size_t n = 0; n < M; ++n)
     {
-        //DEBUG_LOG("inner=%d, outer=%d\n", innerLoop, outerLoop);
-        for ( int outer = 0; outer < outerLoop; ++outer )
+        timeSeries[2 * n + 0] = real[n];
+        timeSeries[2 * n + 1] = imag[n];
+    }
+    return NO_ERROR;
+}
+
+template class BasicFftPlan<double>;
+template class BasicFftPlan<float>;
+template class BasicRealFftPlan<double>;
+template class BasicRealFftPlan<float>;
+
+namespace
+{
+    // A power of 2 not less than N + M - 1 for the circular convolution
+    // of the chirp z transform, and 0 when N or M is 0.
+    size_t GetChirpZLength(size_t N, size_t M)
+    {
+        if ( 0 == N || 0 == M )
         {
-            const int& step = innerLoop;
-            const int ofs = outer * step * 2;
-#if 0
-            for (size_t k = 0; k < innerLoop; ++k )
-            {
-                const double r1 = real[k+ofs];
-                const double i1 = imag[k+ofs];
-                const double r2 = real[k+step+ofs];
-                const double i2 = imag[k+step+ofs];
-
-                real[k+ofs] = r1 + r2;
-                imag[k+ofs] = i1 + i2;
-                const int idx = k * outerLoop;
-                //DEBUG_LOG("step=%d, ofs=%d, k=%d, idx=%d\n", step, ofs, k, idx);
-                real[k+step+ofs] =   (r1 - r2) * cosTable[idx] + (i1 - i2) * sinTable[idx];
-                imag[k+step+ofs] = - (r1 - r2) * sinTable[idx] + (i1 - i2) * cosTable[idx];
-            }
-#else
-            // Easier to look into.
-            void* _pReal = real;
-            void* _pImag = imag;
-            double* pRealL = reinterpret_cast<double*>(_pReal) + ofs;
-            double* pImagL = reinterpret_cast<double*>(_pImag) + ofs;
-            double* pRealH = reinterpret_cast<double*>(_pReal) + ofs + step;
-            double* pImagH = reinterpret_cast<double*>(_pImag) + ofs + step;
-            for (size_t k = 0; k < innerLoop; ++k )
-            {
-                const double r1 = pRealL[k];
-                const double i1 = pImagL[k];
-                const double r2 = pRealH[k];
-                const double i2 = pImagH[k];
-
-                const size_t idx = k * outerLoop;
-                pRealL[k] = r1 + r2;
-                pImagL[k] = i1 + i2;
-                pRealH[k] =   (r1 - r2) * cosTable[idx] + (i1 - i2) * sinTable[idx];
-                pImagH[k] = - (r1 - r2) * sinTable[idx] + (i1 - i2) * cosTable[idx];
-                //DEBUG_LOG("step=%d, ofs=%d, k=%d, idx=%d\n", step, ofs, k, idx);
-            }
-#endif
+            return 0;
         }
+        size_t L = 1;
+        for ( ; L < N + M - 1; L <<= 1);
+        return L;
     }
-    // Bit-reverse
-    const int width = Ilog2(N);
-    //DEBUG_LOG("width=%d\n", width);
-    for (size_t i = 0; i < N; ++i )
+
+    // cos and sin of 2 pi cycles, reduced into [0, 1) in long double,
+    // which keeps the phase of a large n^2 accurate.
+    void SetChirp(double& c, double& s, long double cycles)
     {
-        const size_t k = BitReverse(i, width);
-        if (k == i || k < i)
+        const double phase = 2.0 * g_Pi * static_cast<double>(cycles - floorl(cycles));
+        c = cos(phase);
+        s = sin(phase);
+    }
+}
+
+ChirpZPlan::ChirpZPlan(size_t length, size_t count, double f1, double f2)
+    : m_Length(0)
+    , m_Count(0)
+    , m_Start(f1)
+    , m_Step(1 < count ? (f2 - f1) / (count - 1) : 0.0)
+    , m_Plan(GetChirpZLength(length, count))
+    , m_Chirps(NULL)
+{
+    if ( m_Plan.IsNull() )
+    {
+        return;
+    }
+    // X[m] = d[m] sum_n (x[n] c[n]) conj(d[m - n]), where
+    // c[n] = exp(-j 2 pi (f1 n + step n^2 / 2)), d[m] = exp(-j pi step m^2).
+    const size_t N = length;
+    const size_t M = count;
+    const size_t L = m_Plan.GetLength();
+    const long double step = m_Step;
+    m_Chirps = new double[2 * (N + M + L)];
+    double* pCos = m_Chirps;
+    double* pSin = pCos + N;
+    for (size_t n = 0; n < N; ++n)
+    {
+        const long double ln = n;
+        SetChirp(pCos[n], pSin[n], - (f1 * ln + step * ln * ln / 2));
+    }
+    double* pOutCos = m_Chirps + 2 * N;
+    double* pOutSin = pOutCos + M;
+    for (size_t m = 0; m < M; ++m)
+    {
+        const long double lm = m;
+        SetChirp(pOutCos[m], pOutSin[m], - step * lm * lm / 2);
+    }
+    // conj(d[k]) at k for [0, M) and at L - k for [1, N), the negative
+    // indices of the circular convolution.
+    double* pReal = m_Chirps + 2 * (N + M);
+    double* pImag = pReal + L;
+    for (size_t k = 0; k < L; ++k)
+    {
+        pReal[k] = 0.0;
+        pImag[k] = 0.0;
+    }
+    for (size_t k = 0; k < std::max(N, M); ++k)
+    {
+        const long double lk = k;
+        double c, s;
+        SetChirp(c, s, step * lk * lk / 2);
+        if ( k < M )
+        {
+            pReal[k] = c;
+            pImag[k] = s;
+        }
+        if ( 0 < k && k < N )
         {
-            continue;
+            pReal[L - k] = c;
+            pImag[L - k] = s;
         }
-        const double real_temp = real[k];
-        const double imag_temp = imag[k];
-        real[k] = real[i];
-        imag[k] = imag[i];
-        real[i] = real_temp;
-        imag[i] = imag_temp;
     }
-    return NO_ERROR;
+    m_Plan.Execute(pReal, pImag);
+    m_Length = N;
+    m_Count = M;
 }
 
-status_t Ifft(mcon::Vector<double>& timeSeries, const mcon::Matrix<double>& complex)
+ChirpZPlan::~ChirpZPlan()
 {
-    const size_t N = complex.GetColumnLength();
-    if (Count1(N) != 1)
+    delete[] m_Chirps;
+}
+
+status_t ChirpZPlan::Execute(double real[], double imag[], const double timeSeries[], double work[]) const
+{
+    return Execute(real, imag, timeSeries, NULL, work);
+}
+
+status_t ChirpZPlan::Execute(double real[], double imag[], const double inputReal[], const double inputImag[], double work[]) const
+{
+    if ( IsNull() || NULL == real || NULL == imag || NULL == inputReal )
     {
         return -ERROR_ILLEGAL;
     }
-    mcon::Vector<double> tsPair;
-    mcon::Vector<double> sinTable;
-    mcon::Vector<double> cosTable;
+    const size_t N = m_Length;
+    const size_t M = m_Count;
+    const size_t L = m_Plan.GetLength();
+    double* buffer = NULL;
+    if ( NULL == work )
+    {
+        buffer = new double[GetWorkLength()];
+    }
+    double* ar = NULL == work ? buffer : work;
+    double* ai = ar + L;
+    // On the threads of the hardware as FftPlan::Execute(), when allocating.
+    const size_t threadCount = NULL == work ? 0 : 1;
+    const double* pCos = m_Chirps;
+    const double* pSin = pCos + N;
+    const double* pOutCos = m_Chirps + 2 * N;
+    const double* pOutSin = pOutCos + M;
+    const double* pReal = m_Chirps + 2 * (N + M);
+    const double* pImag = pReal + L;
+    for (size_t n = 0; n < N; ++n)
+    {
+        ar[n] = inputReal[n];
+        ai[n] = NULL == inputImag ? 0.0 : inputImag[n];
+        Rotate(ar[n], ai[n], pCos[n], pSin[n]);
+    }
+    for (size_t n = N; n < L; ++n)
+    {
+        ar[n] = 0.0;
+        ai[n] = 0.0;
+    }
+    m_Plan.Execute(ar, ai, ai + L, threadCount);
+    // The inverse FFT of the product as conj(FFT(conj(product))) / L.
+    for (size_t k = 0; k < L; ++k)
+    {
+        Rotate(ar[k], ai[k], pReal[k], pImag[k]);
+        ai[k] = - ai[k];
+    }
+    m_Plan.Execute(ar, ai, ai + L, threadCount);
+    const double scale = 1.0 / L;
+    for (size_t m = 0; m < M; ++m)
+    {
+        real[m] = ar[m] * scale;
+        imag[m] = - ai[m] * scale;
+        Rotate(real[m], imag[m], pOutCos[m], pOutSin[m]);
+    }
+    delete[] buffer;
+    return NO_ERROR;
+}
 
-    if ( false == timeSeries.Resize(N)
-        || false == tsPair.Resize(N)
-        || false == sinTable.Resize(N)
-        || false == cosTable.Resize(N) )
+status_t ChirpZ(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries, const ChirpZPlan& plan)
+{
+    const size_t M = plan.GetCount();
+    if ( plan.IsNull() || timeSeries.GetLength() != plan.GetLength() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    if ( (complex.GetRowLength() != 2 || complex.GetColumnLength() != M)
+        && false == complex.Resize(2, M) )
     {
         return -ERROR_CANNOT_ALLOCATE_MEMORY;
     }
+    return plan.Execute(complex[0], complex[1], timeSeries);
+}
 
-    const double df = 2.0 * g_Pi / N;
+status_t ChirpZ(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries, size_t count, double f1, double f2)
+{
+    const ChirpZPlan plan(timeSeries.GetLength(), count, f1, f2);
+    if ( plan.IsNull() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    return ChirpZ(complex, timeSeries, plan);
+}
 
-    for (size_t i = 0; i < N / 2; ++i)
+namespace
+{
+    // The bodies of the overloads of double and float below.
+    template <typename Type>
+    status_t ExecuteStrided(Type real[], Type imag[], size_t stride, size_t count, const BasicFftPlan<Type>& plan, size_t threadCount)
     {
-        sinTable[i] = sin(df * i);
-        cosTable[i] = cos(df * i);
+        if ( plan.IsNull() || NULL == real || NULL == imag
+            || (1 < count && stride < plan.GetLength()) )
+        {
+            return -ERROR_ILLEGAL;
+        }
+        Type** reals = new Type*[count + 1];
+        Type** imags = new Type*[count + 1];
+        for (size_t i = 0; i < count; ++i)
+        {
+            reals[i] = real + i * stride;
+            imags[i] = imag + i * stride;
+        }
+        const status_t status = ExecuteRows(plan, reals, imags, count, threadCount);
+        delete[] reals;
+        delete[] imags;
+        return status;
     }
-    // Substitute beforehand
-    timeSeries = complex[0];
-    tsPair = complex[1];
 
-    size_t innerLoop = N / 2;
-    size_t outerLoop = 1;
+    template <typename Type>
+    status_t ExecuteForward(Type real[], Type imag[], const Type td[], const BasicFftPlan<Type>& plan, Type work[])
+    {
+        const size_t N = plan.GetLength();
+        if ( plan.IsNull() || BasicFftPlan<Type>::Direction_Forward != plan.GetDirection()
+            || NULL == real || NULL == imag || NULL == td )
+        {
+            return -ERROR_ILLEGAL;
+        }
+        if ( real != td )
+        {
+            memmove(real, td, N * sizeof(Type));
+        }
+        memset(imag, 0, N * sizeof(Type));
+        return NULL == work ? plan.Execute(real, imag) : plan.Execute(real, imag, work);
+    }
 
-    // Decimation in frequency.
-    for ( ; 0 < innerLoop; innerLoop >>= 1, outerLoop <<= 1)
-    {
-        //DEBUG_LOG("inner=%d, outer=%d\n", innerLoop, outerLoop);
-        for (size_t outer = 0; outer < outerLoop; ++outer )
-        {
-            const int& step = innerLoop;
-            const int ofs = outer * step * 2;
-            // Easier to look into.
-            void* _pTs = timeSeries;
-            void* _pTsPair = tsPair;
-            double* pTsL     = reinterpret_cast<double*>(_pTs) + ofs;
-            double* pTsPairL = reinterpret_cast<double*>(_pTsPair) + ofs;
-            double* pTsH     = reinterpret_cast<double*>(_pTs) + ofs + step;
-            double* pTsPairH = reinterpret_cast<double*>(_pTsPair) + ofs + step;
-            for (size_t k = 0; k < innerLoop; ++k )
-            {
-                const double r1 = pTsL[k];
-                const double i1 = pTsPairL[k];
-                const double r2 = pTsH[k];
-                const double i2 = pTsPairH[k];
-
-                const size_t idx = k * outerLoop;
-                pTsL[k]     = r1 + r2;
-                pTsPairL[k] = i1 + i2;
-                pTsH[k]     =   (r1 - r2) * cosTable[idx] - (i1 - i2) * sinTable[idx];
-                pTsPairH[k] =   (r1 - r2) * sinTable[idx] + (i1 - i2) * cosTable[idx];
-                //DEBUG_LOG("step=%d, ofs=%d, k=%d, idx=%d\n", step, ofs, k, idx);
-            }
+    template <typename Type>
+    status_t ExecuteInverse(Type td[], const Type real[], Type imag[], const BasicFftPlan<Type>& plan, Type work[])
+    {
+        const size_t N = plan.GetLength();
+        if ( plan.IsNull() || BasicFftPlan<Type>::Direction_Inverse != plan.GetDirection()
+            || NULL == td || NULL == real || NULL == imag )
+        {
+            return -ERROR_ILLEGAL;
+        }
+        if ( td != real )
+        {
+            memmove(td, real, N * sizeof(Type));
         }
+        return NULL == work ? plan.Execute(td, imag) : plan.Execute(td, imag, work);
     }
-    // Bit-reverse
-    const int width = Ilog2(N);
-    //DEBUG_LOG("width=%d\n", width);
-    for (size_t i = 0; i < N; ++i )
+}
+
+status_t Fft(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries, const FftPlan& plan)
+{
+    const size_t N = timeSeries.GetLength();
+    if ( plan.IsNull() || N != plan.GetLength() || FftPlan::Direction_Forward != plan.GetDirection() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    if ( (complex.GetRowLength() != 2 || complex.GetColumnLength() != N)
+        && false == complex.Resize(2, N) )
+    {
+        return -ERROR_CANNOT_ALLOCATE_MEMORY;
+    }
+    // Substitute beforehand
+    complex[0] = timeSeries;
+    complex[1] = 0;
+    return plan.Execute(complex);
+}
+
+status_t FftMany(double real[], double imag[], size_t stride, size_t count, const FftPlan& plan, size_t threadCount)
+{
+    return ExecuteStrided(real, imag, stride, count, plan, threadCount);
+}
+
+status_t FftMany(float real[], float imag[], size_t stride, size_t count, const FftPlanf& plan, size_t threadCount)
+{
+    return ExecuteStrided(real, imag, stride, count, plan, threadCount);
+}
+
+status_t FftMany(mcon::Matrix<double>& complex, const mcon::Matrix<double>& timeSeries, const FftPlan& plan, size_t threadCount)
+{
+    const size_t N = timeSeries.GetColumnLength();
+    const size_t count = timeSeries.GetRowLength();
+    if ( plan.IsNull() || N != plan.GetLength() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    if ( (complex.GetRowLength() != 2 * count || complex.GetColumnLength() != N)
+        && false == complex.Resize(2 * count, N) )
+    {
+        return -ERROR_CANNOT_ALLOCATE_MEMORY;
+    }
+    double** reals = new double*[count + 1];
+    double** imags = new double*[count + 1];
+    for (size_t i = 0; i < count; ++i)
+    {
+        complex[2 * i + 0] = timeSeries[i];
+        complex[2 * i + 1] = 0;
+        reals[i] = complex[2 * i + 0];
+        imags[i] = complex[2 * i + 1];
+    }
+    const status_t status = ExecuteRows(plan, reals, imags, count, threadCount);
+    delete[] reals;
+    delete[] imags;
+    return status;
+}
+
+status_t Fft(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries)
+{
+    const FftPlan plan(timeSeries.GetLength());
+    if ( plan.IsNull() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    return Fft(complex, timeSeries, plan);
+}
+
+status_t RealFft(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries, const RealFftPlan& plan, bool isFullLayout)
+{
+    const size_t N = timeSeries.GetLength();
+    if ( plan.IsNull() || N != plan.GetLength() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    const size_t length = isFullLayout ? N : plan.GetBinCount();
+    if ( (complex.GetRowLength() != 2 || complex.GetColumnLength() != length)
+        && false == complex.Resize(2, length) )
+    {
+        return -ERROR_CANNOT_ALLOCATE_MEMORY;
+    }
+    double* real = complex[0];
+    double* imag = complex[1];
+    const status_t status = plan.Forward(real, imag, timeSeries);
+    if ( NO_ERROR == status && isFullLayout )
     {
-        const size_t k = BitReverse(i, width);
-        if (k < i)
+        for (size_t k = 1; k < N / 2; ++k)
         {
-            continue;
+            real[N - k] = real[k];
+            imag[N - k] = - imag[k];
         }
-        const double ts_temp = timeSeries[k] / N;
-        timeSeries[k] = timeSeries[i] / N;
-        timeSeries[i] = ts_temp;
     }
-    return NO_ERROR;
+    return status;
 }
 
-status_t Fft(double real[], double imag[], double td[], int n)
+status_t RealFft(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries, bool isFullLayout)
 {
-    mcon::Vector<double> input;
-    mcon::Matrix<double> complex;
+    const RealFftPlan plan(timeSeries.GetLength());
+    if ( plan.IsNull() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    return RealFft(complex, timeSeries, plan, isFullLayout);
+}
 
-    if ( false == input.Resize(n) )
+status_t RealIfft(mcon::Vector<double>& timeSeries, const mcon::Matrix<double>& complex)
+{
+    const size_t bins = complex.GetColumnLength();
+    if ( complex.GetRowLength() < 2 || bins < 2 )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    const RealFftPlan plan(2 * (bins - 1));
+    if ( plan.IsNull() )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    mcon::Vector<double> real(complex[0]);
+    mcon::Vector<double> imag(complex[1]);
+    if ( false == timeSeries.Resize(plan.GetLength()) )
     {
         return -ERROR_CANNOT_ALLOCATE_MEMORY;
     }
-    if ( false == complex.Resize(2, n) )
+    return plan.Inverse(timeSeries, real, imag);
+}
+
+status_t Ifft(mcon::Vector<double>& timeSeries, const mcon::Matrix<double>& complex)
+{
+    const size_t N = complex.GetColumnLength();
+    const FftPlan plan(N, FftPlan::Direction_Inverse);
+    if ( plan.IsNull() || complex.GetRowLength() < 2 )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    mcon::Vector<double> tsPair;
+    if ( false == timeSeries.Resize(N)
+        || false == tsPair.Resize(N) )
     {
         return -ERROR_CANNOT_ALLOCATE_MEMORY;
     }
-    memcpy(input, td, sizeof(double) * n);
+    // Substitute beforehand
+    timeSeries = complex[0];
+    tsPair = complex[1];
+    return plan.Execute(timeSeries, tsPair);
+}
+
+status_t Fft(double real[], double imag[], const double td[], const FftPlan& plan, double work[])
+{
+    return ExecuteForward(real, imag, td, plan, work);
+}
 
-    status_t status;
-    status = Fft(complex, input);
+status_t Ifft(double td[], const double real[], double imag[], const FftPlan& plan, double work[])
+{
+    return ExecuteInverse(td, real, imag, plan, work);
+}
+
+status_t Fft(float real[], float imag[], const float td[], const FftPlanf& plan, float work[])
+{
+    return ExecuteForward(real, imag, td, plan, work);
+}
+
+status_t Ifft(float td[], const float real[], float imag[], const FftPlanf& plan, float work[])
+{
+    return ExecuteInverse(td, real, imag, plan, work);
+}
 
-    if ( NO_ERROR == status )
+status_t Fft(double real[], double imag[], const double td[], int n)
+{
+    if ( n <= 0 )
     {
-        memcpy(real, complex[0], n * sizeof(double));
-        memcpy(imag, complex[1], n * sizeof(double));
+        return -ERROR_ILLEGAL;
     }
-    return status;
+    const FftPlan plan(n);
+    return Fft(real, imag, td, plan);
 }
 
-status_t Ifft(double td[], double real[], double imag[], int n)
+status_t Ifft(double td[], const double real[], const double imag[], int n)
 {
-    return NO_ERROR;
+    if ( n <= 0 )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    const FftPlan plan(n, FftPlan::Direction_Inverse);
+    double* imagPart = new double[n];
+    memcpy(imagPart, imag, n * sizeof(double));
+    const status_t status = Ifft(td, real, imagPart, plan);
+    delete[] imagPart;
+    return status;
 }
 
 status_t Ft(double real[], double imag[], const double td[], int n)
 {
+    if ( 0 < n && static_cast<size_t>(n) > g_DirectFtLength )
+    {
+        return Fft(real, imag, td, n);
+    }
     for (int i = 0; i < n; ++i)
     {
         double df = (double)i * g_Pi * 2/ n;
@@ -301,6 +1886,10 @@ status_t Ft(double real[], double imag[], const double td[], int n)
 
 status_t Ft(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSeries)
 {
+    if ( timeSeries.GetLength() > g_DirectFtLength )
+    {
+        return Fft(complex, timeSeries);
+    }
     bool status = complex.Resize(2, timeSeries.GetLength());
     if (false == status)
     {
@@ -344,6 +1933,10 @@ status_t Ft(mcon::Matrix<double>& complex, const mcon::Vector<double>& timeSerie
 
 status_t Ift(double td[], const double real[], const double imag[], int N)
 {
+    if ( 0 < N && static_cast<size_t>(N) > g_DirectFtLength )
+    {
+        return Ifft(td, real, imag, N);
+    }
     for (int i = 0; i < N; ++i)
     {
         double df = (double)i * g_Pi * 2 / N;
@@ -363,6 +1956,10 @@ status_t Ift(mcon::Vector<double>& timeSeries, const mcon::Matrix<double>& compl
     {
         return -ERROR_ILLEGAL;
     }
+    if ( complex.GetColumnLength() > g_DirectFtLength )
+    {
+        return Ifft(timeSeries, complex);
+    }
     if ( false == timeSeries.Resize(complex.GetColumnLength()) )
     {
         return -ERROR_CANNOT_ALLOCATE_MEMORY;
@@ -417,7 +2014,7 @@ status_t ConvertToPolarCoords(mcon::Matrix<double>& polar, const mcon::Matrix<do
     for (size_t i = 0; i < complex.GetColumnLength(); ++i)
     {
         r[i] = sqrt(POW2(real[i]) + POW2(imag[i]));
-        arg[i] = atan(imag[i]/real[i]);
+        arg[i] = atan2(imag[i], real[i]);
     }
     return NO_ERROR;
 }
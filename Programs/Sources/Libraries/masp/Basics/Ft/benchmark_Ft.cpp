@@ -25,7 +25,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
+#include <algorithm>
 #include <string>
 
 #include "masp/Ft.h"
@@ -100,46 +102,336 @@ static void tune_ft(void)
 }
 
 static const int KiB = 1024;
-static const int MiB = KiB * KiB;
+
+// The radix-2 scalar FFT which Fft() used to be, as the reference of
+// the speed, where the tables are built in each call.
+static void Radix2Fft(double real[], double imag[], size_t N)
+{
+    const double df = 2.0 * M_PI / N;
+    mcon::Vector<double> sinTable(N/2);
+    mcon::Vector<double> cosTable(N/2);
+    for (size_t i = 0; i < N / 2; ++i)
+    {
+        sinTable[i] = sin(df * i);
+        cosTable[i] = cos(df * i);
+    }
+    size_t outerLoop = 1;
+    for (size_t innerLoop = N / 2; 0 < innerLoop; innerLoop >>= 1, outerLoop <<= 1)
+    {
+        for (size_t outer = 0; outer < outerLoop; ++outer )
+        {
+            const size_t step = innerLoop;
+            const size_t ofs = outer * step * 2;
+            for (size_t k = 0; k < innerLoop; ++k )
+            {
+                const double r1 = real[k+ofs];
+                const double i1 = imag[k+ofs];
+                const double r2 = real[k+step+ofs];
+                const double i2 = imag[k+step+ofs];
+                const size_t idx = k * outerLoop;
+                real[k+ofs] = r1 + r2;
+                imag[k+ofs] = i1 + i2;
+                real[k+step+ofs] =   (r1 - r2) * cosTable[idx] + (i1 - i2) * sinTable[idx];
+                imag[k+step+ofs] = - (r1 - r2) * sinTable[idx] + (i1 - i2) * cosTable[idx];
+            }
+        }
+    }
+    int width = 0;
+    for (size_t n = N; 1 < n; n >>= 1)
+    {
+        ++width;
+    }
+    for (size_t i = 0; i < N; ++i )
+    {
+        size_t k = 0;
+        for (int b = 0; b < width; ++b)
+        {
+            k |= ((i >> b) & 0x1) << (width - b - 1);
+        }
+        if (k <= i)
+        {
+            continue;
+        }
+        std::swap(real[i], real[k]);
+        std::swap(imag[i], imag[k]);
+    }
+}
 
 void benchmark_Fft(void)
 {
-    mcon::Vector<double> ts;
-    mcon::Matrix<double> ft;
-    mcon::Matrix<double> fft;
+    enum {
+        ID_RADIX2,
+        ID_FFT,
+        ID_PLAN,
+        ID_REAL,
+        ID_PLAN_SINGLE,
+        ID_REAL_SINGLE,
+        ID_BATCH,
+        ID_MANY,
+        NUM_IDS
+    };
+    const char* testNames[NUM_IDS] = {
+        "Radix-2 (previous Fft)",
+        "Fft",
+        "FftPlan::Execute",
+        "RealFftPlan::Forward",
+        "FftPlanf::Execute",
+        "RealFftPlanf::Forward",
+        "FftPlan::Execute (batch)",
+        "FftMany (batch 1 thread)"
+    };
 
     const int sizes[] =
     {
+         16,
          64,
         256,
           1 * KiB,
           4 * KiB,
          16 * KiB,
          64 * KiB,
-        256 * KiB,
-          1 * MiB,
-          4 * MiB
     };
-    for ( unsigned int k = 0; k < sizeof(sizes)/sizeof(int); ++k )
+    const unsigned int numPatterns = sizeof(sizes) / sizeof(int);
+    double scores[NUM_IDS][numPatterns];
+
+    for ( unsigned int k = 0; k < numPatterns; ++k )
     {
         const int N = sizes[k];
-        bool status = ts.Resize(N);
-        if ( false == status ) { break; }
-        status = ft.Resize(2, N);
-        if ( false == status ) { break; }
-        status = fft.Resize(2, N);
-        if ( false == status ) { break; }
+        int log2N = 0;
+        for (int n = N; 1 < n; n >>= 1)
+        {
+            ++log2N;
+        }
+        // About 2^26 butterfly operations for each.
+        const int repeat = std::max(1, (1 << 26) / (N * log2N));
+        mcon::Vector<double> ts(N);
+        for (int i = 0; i < N; ++i)
+        {
+            ts[i] = sin(0.001 * i * i);
+        }
+        mcon::Matrix<double> fft(2, N);
+        const masp::ft::FftPlan plan(N);
+        const masp::ft::RealFftPlan realPlan(N);
         mutl::Stopwatch sw;
-        masp::ft::Ft(ft, ts);
-        const double scoreFt = sw.Push();
-        masp::ft::Fft(fft, ts);
-        const double scoreFft = sw.Push();
-        printf("size=%7d: Ratio %g\n", N, scoreFt / scoreFft);
+
+        sw.Tick();
+        for (int r = 0; r < repeat; ++r)
+        {
+            fft[0] = ts;
+            fft[1] = 0;
+            Radix2Fft(fft[0], fft[1], N);
+        }
+        scores[ID_RADIX2][k] = sw.Tick() / repeat;
+        for (int r = 0; r < repeat; ++r)
+        {
+            masp::ft::Fft(fft, ts);
+        }
+        scores[ID_FFT][k] = sw.Tick() / repeat;
+        for (int r = 0; r < repeat; ++r)
+        {
+            fft[0] = ts;
+            fft[1] = 0;
+            plan.Execute(fft[0], fft[1]);
+        }
+        scores[ID_PLAN][k] = sw.Tick() / repeat;
+        for (int r = 0; r < repeat; ++r)
+        {
+            realPlan.Forward(fft[0], fft[1], ts);
+        }
+        scores[ID_REAL][k] = sw.Tick() / repeat;
+
+        // The same in float.
+        const masp::ft::FftPlanf planf(N);
+        const masp::ft::RealFftPlanf realPlanf(N);
+        float* tsf = new float[3 * N];
+        float* realf = tsf + N;
+        float* imagf = realf + N;
+        for (int i = 0; i < N; ++i)
+        {
+            tsf[i] = static_cast<float>(ts[i]);
+        }
+        sw.Tick();
+        for (int r = 0; r < repeat; ++r)
+        {
+            memcpy(realf, tsf, N * sizeof(float));
+            memset(imagf, 0, N * sizeof(float));
+            planf.Execute(realf, imagf);
+        }
+        scores[ID_PLAN_SINGLE][k] = sw.Tick() / repeat;
+        for (int r = 0; r < repeat; ++r)
+        {
+            realPlanf.Forward(realf, imagf, tsf);
+        }
+        scores[ID_REAL_SINGLE][k] = sw.Tick() / repeat;
+        delete[] tsf;
+
+        // The batches of the rows at the stride N, each initialized as
+        // the ones above.
+        const int batch = 16;
+        const int batchRepeat = std::max(1, repeat / batch);
+        mcon::Vector<double> realBuffer(batch * N);
+        mcon::Vector<double> imagBuffer(batch * N);
+        double* real = realBuffer;
+        double* imag = imagBuffer;
+        sw.Tick();
+        for (int r = 0; r < batchRepeat; ++r)
+        {
+            for (int b = 0; b < batch; ++b)
+            {
+                memcpy(real + b * N, ts, N * sizeof(double));
+            }
+            memset(imag, 0, batch * N * sizeof(double));
+            for (int b = 0; b < batch; ++b)
+            {
+                plan.Execute(real + b * N, imag + b * N);
+            }
+        }
+        scores[ID_BATCH][k] = sw.Tick() / (batchRepeat * batch);
+        for (int r = 0; r < batchRepeat; ++r)
+        {
+            for (int b = 0; b < batch; ++b)
+            {
+                memcpy(real + b * N, ts, N * sizeof(double));
+            }
+            memset(imag, 0, batch * N * sizeof(double));
+            masp::ft::FftMany(real, imag, N, batch, plan, 1);
+        }
+        scores[ID_MANY][k] = sw.Tick() / (batchRepeat * batch);
+    }
+    printf("Size [ns/transform]");
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        printf(",%d", sizes[k]);
+    }
+    printf("\n");
+    for ( int id = 0; id < NUM_IDS; ++id )
+    {
+        printf("%s", testNames[id]);
+        for ( unsigned int k = 0; k < numPatterns; ++k )
+        {
+            printf(",%.0f", scores[id][k] * 1.0e9);
+        }
+        printf("\n");
+    }
+    // Counted as 5 N log2(N) flops, the radix-2 ones, even for the real
+    // one, which shows the speed-up rather than the actual flop rate.
+    printf("Size [GFLOPS]");
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        printf(",%d", sizes[k]);
+    }
+    printf("\n");
+    for ( int id = 0; id < NUM_IDS; ++id )
+    {
+        printf("%s", testNames[id]);
+        for ( unsigned int k = 0; k < numPatterns; ++k )
+        {
+            const double N = sizes[k];
+            printf(",%.2f", 5.0 * N * log2(N) / scores[id][k] * 1.0e-9);
+        }
+        printf("\n");
+    }
+}
+
+// The four-step of the large powers of 2 on a thread and on the threads
+// of the hardware, of which the data go beyond the caches.
+static void benchmark_LargeFft(void)
+{
+    enum {
+        ID_PLAN,
+        ID_PLAN_THREADS,
+        ID_PLAN_SINGLE_THREADS,
+        NUM_IDS
+    };
+    const char* testNames[NUM_IDS] = {
+        "FftPlan::Execute (1 thread)",
+        "FftPlan::Execute",
+        "FftPlanf::Execute",
+    };
+
+    const int sizes[] =
+    {
+          1 * KiB * KiB,
+          4 * KiB * KiB,
+         16 * KiB * KiB,
+         64 * KiB * KiB,
+    };
+    const unsigned int numPatterns = sizeof(sizes) / sizeof(int);
+    double scores[NUM_IDS][numPatterns];
+
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        const int N = sizes[k];
+        const int repeat = std::max(1, (1 << 24) / N);
+        double* ts = new double[3 * N];
+        double* real = ts + N;
+        double* imag = real + N;
+        for (int i = 0; i < N; ++i)
+        {
+            ts[i] = sin(0.001 * i);
+        }
+        const masp::ft::FftPlan plan(N);
+        double* work = new double[plan.GetWorkLength()];
+        mutl::Stopwatch sw;
+
+        sw.Tick();
+        for (int r = 0; r < repeat; ++r)
+        {
+            memcpy(real, ts, N * sizeof(double));
+            memset(imag, 0, N * sizeof(double));
+            plan.Execute(real, imag, work, 1);
+        }
+        scores[ID_PLAN][k] = sw.Tick() / repeat;
+        for (int r = 0; r < repeat; ++r)
+        {
+            memcpy(real, ts, N * sizeof(double));
+            memset(imag, 0, N * sizeof(double));
+            plan.Execute(real, imag, work, 0);
+        }
+        scores[ID_PLAN_THREADS][k] = sw.Tick() / repeat;
+        delete[] work;
+
+        // The same in float, in the area of double.
+        const masp::ft::FftPlanf planf(N);
+        float* tsf = reinterpret_cast<float*>(real);
+        float* realf = tsf + N;
+        float* imagf = realf + N;
+        float* workf = new float[planf.GetWorkLength()];
+        for (int i = 0; i < N; ++i)
+        {
+            tsf[i] = static_cast<float>(ts[i]);
+        }
+        sw.Tick();
+        for (int r = 0; r < repeat; ++r)
+        {
+            memcpy(realf, tsf, N * sizeof(float));
+            memset(imagf, 0, N * sizeof(float));
+            planf.Execute(realf, imagf, workf, 0);
+        }
+        scores[ID_PLAN_SINGLE_THREADS][k] = sw.Tick() / repeat;
+        delete[] workf;
+        delete[] ts;
+    }
+    printf("Size [ms/transform]");
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        printf(",%d", sizes[k]);
+    }
+    printf("\n");
+    for ( int id = 0; id < NUM_IDS; ++id )
+    {
+        printf("%s", testNames[id]);
+        for ( unsigned int k = 0; k < numPatterns; ++k )
+        {
+            printf(",%.1f", scores[id][k] * 1.0e3);
+        }
+        printf("\n");
     }
 }
 
 void benchmark_Ft(void)
 {
     benchmark_Fft();
+    benchmark_LargeFft();
     tune_ft();
 }
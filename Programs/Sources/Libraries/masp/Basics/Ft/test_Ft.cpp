@@ -25,6 +25,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
 
 #include "debug.h"
 #include "masp/Ft.h"
@@ -156,7 +161,12 @@ static void test_gp_complex(void)
     const char* fname = "sweep_440-3520_1s.wav";
     mfio::Wave wave;
     mcon::Vector<double> buffer;
-    wave.Read(fname, buffer);
+    // The input isn't in the tree; skipped unless it has been placed.
+    if ( NO_ERROR != wave.Read(fname, buffer) || buffer.IsNull() )
+    {
+        LOG("Skipped: %s isn't found.\n", fname);
+        return;
+    }
     mcon::Matrix<double> complex;
     mcon::Matrix<double> gp;
     mcon::Matrix<double> icomplex;
@@ -281,10 +291,806 @@ static void test_fft(void)
     }
 }
 
+// The reference DFT, since Ft() goes through the FFT above a small length.
+static void DirectFt(mcon::Matrix<double>& complex, const mcon::Vector<double>& buffer)
+{
+    const int n = buffer.GetLength();
+    complex.Resize(2, n);
+    for (int k = 0; k < n; ++k)
+    {
+        long double real = 0;
+        long double imag = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            const long double arg = 2.0L * M_PI * ((static_cast<long long>(i) * k) % n) / n;
+            real += buffer[i] * cosl(arg);
+            imag -= buffer[i] * sinl(arg);
+        }
+        complex[0][k] = static_cast<double>(real);
+        complex[1][k] = static_cast<double>(imag);
+    }
+}
+
+static void RepeatFft(mcon::Matrix<double>& complex, const mcon::Vector<double>& buffer, const masp::ft::FftPlan& plan)
+{
+    for (int repeat = 0; repeat < 20; ++repeat)
+    {
+        masp::ft::Fft(complex, buffer, plan);
+    }
+}
+
+static void test_fft_plan(void)
+{
+    LOG("* [FftPlan]\n");
+    {
+        const masp::ft::FftPlan plan0(0);
+        CHECK_VALUE(plan0.IsNull(), true);
+        double real[3] = {0};
+        double imag[3] = {0};
+        CHECK_VALUE(plan0.Execute(real, imag), -ERROR_ILLEGAL);
+        const masp::ft::FftPlan plan3(3);
+        CHECK_VALUE(plan3.IsNull(), false);
+        CHECK_VALUE(plan3.Execute(real, imag, NULL), -ERROR_ILLEGAL);
+        const masp::ft::FftPlan plan4(4);
+        CHECK_VALUE(plan4.GetWorkLength(), 0);
+        mcon::Matrix<double> complex(2, 3);
+        CHECK_VALUE(plan4.Execute(complex), -ERROR_ILLEGAL);
+    }
+    // Through the radix-2, 4 and 8 stages of both parities of log2(n).
+    const int lengths[] = {1, 2, 4, 8, 16, 32, 64, 512, 1024};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(int); ++i)
+    {
+        const int n = lengths[i];
+        LOG("    n=%d\n", n);
+        mcon::Vector<double> buffer(n);
+        for (int k = 0; k < n; ++k)
+        {
+            buffer[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * k;
+        }
+        mcon::Matrix<double> ft;
+        DirectFt(ft, buffer);
+
+        const masp::ft::FftPlan plan(n);
+        CHECK_VALUE(plan.GetLength(), n);
+        mcon::Matrix<double> fft;
+        status_t status = masp::ft::Fft(fft, buffer, plan);
+        CHECK_VALUE(status, NO_ERROR);
+        double err = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err = std::max(err, fabs(ft[0][k] - fft[0][k]) + fabs(ft[1][k] - fft[1][k]));
+        }
+        CHECK_VALUE(err / n, 0);
+
+        // Back to the time domain.
+        const masp::ft::FftPlan inverse(n, masp::ft::FftPlan::Direction_Inverse);
+        status = inverse.Execute(fft);
+        CHECK_VALUE(status, NO_ERROR);
+        err = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err = std::max(err, fabs(fft[0][k] - buffer[k]) + fabs(fft[1][k]));
+        }
+        CHECK_VALUE(err, 0);
+    }
+    // A plan shared by threads.
+    {
+        const int n = 4096;
+        const int threadCount = 4;
+        const masp::ft::FftPlan plan(n);
+        mcon::Vector<double> buffer(n);
+        for (int k = 0; k < n; ++k)
+        {
+            buffer[k] = sin(0.01 * k * k);
+        }
+        mcon::Matrix<double> expected;
+        masp::ft::Fft(expected, buffer, plan);
+        mcon::Matrix<double> results[threadCount];
+        std::thread* threads = new std::thread[threadCount];
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads[t] = std::thread(RepeatFft, std::ref(results[t]), std::cref(buffer), std::cref(plan));
+        }
+        bool isSame = true;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads[t].join();
+            for (int k = 0; k < n; ++k)
+            {
+                isSame &= (results[t][0][k] == expected[0][k]) && (results[t][1][k] == expected[1][k]);
+            }
+        }
+        delete[] threads;
+        CHECK_VALUE(isSame, true);
+    }
+}
+
+static void test_fft_any_length(void)
+{
+    LOG("* [Fft of any length]\n");
+    // The products of 2, 3, 5 and 7 of the mixed radices, and the others
+    // of Bluestein's.
+    const int lengths[] = {3, 5, 6, 7, 12, 15, 35, 105, 360, 1000, 11, 13, 97, 1009, 2 * 97, 3 * 1009};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(int); ++i)
+    {
+        const int n = lengths[i];
+        LOG("    n=%d\n", n);
+        mcon::Vector<double> buffer(n);
+        for (int k = 0; k < n; ++k)
+        {
+            buffer[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * k;
+        }
+        mcon::Matrix<double> ft;
+        DirectFt(ft, buffer);
+
+        mcon::Matrix<double> fft;
+        status_t status = masp::ft::Fft(fft, buffer);
+        CHECK_VALUE(status, NO_ERROR);
+        double err = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err = std::max(err, fabs(ft[0][k] - fft[0][k]) + fabs(ft[1][k] - fft[1][k]));
+        }
+        CHECK_VALUE(err / n, 0);
+
+        // Ft() dispatches to the FFT.
+        mcon::Matrix<double> dispatched;
+        masp::ft::Ft(dispatched, buffer);
+        err = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err = std::max(err, fabs(ft[0][k] - dispatched[0][k]) + fabs(ft[1][k] - dispatched[1][k]));
+        }
+        CHECK_VALUE(err / n, 0);
+
+        // With the work area of the caller, the same as allocated inside.
+        const masp::ft::FftPlan plan(n);
+        CHECK_VALUE(0 < plan.GetWorkLength(), true);
+        mcon::Vector<double> work(plan.GetWorkLength());
+        mcon::Matrix<double> complex(2, n);
+        complex[0] = buffer;
+        complex[1] = 0;
+        status = plan.Execute(complex[0], complex[1], work);
+        CHECK_VALUE(status, NO_ERROR);
+        bool isSame = true;
+        for (int k = 0; k < n; ++k)
+        {
+            isSame &= (complex[0][k] == fft[0][k]) && (complex[1][k] == fft[1][k]);
+        }
+        CHECK_VALUE(isSame, true);
+
+        // Back to the time domain by Ifft() and Ift().
+        mcon::Vector<double> ifft;
+        status = masp::ft::Ifft(ifft, fft);
+        CHECK_VALUE(status, NO_ERROR);
+        mcon::Vector<double> ift;
+        status = masp::ft::Ift(ift, fft);
+        CHECK_VALUE(status, NO_ERROR);
+        err = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err = std::max(err, fabs(ifft[k] - buffer[k]) + fabs(ift[k] - buffer[k]));
+        }
+        CHECK_VALUE(err, 0);
+    }
+}
+
+static void test_fft_many(void)
+{
+    LOG("* [FftMany]\n");
+    {
+        const masp::ft::FftPlan plan0(0);
+        mcon::Matrix<double> input(3, 4);
+        mcon::Matrix<double> output;
+        CHECK_VALUE(masp::ft::FftMany(output, input, plan0), -ERROR_ILLEGAL);
+        const masp::ft::FftPlan plan8(8);
+        CHECK_VALUE(masp::ft::FftMany(output, input, plan8), -ERROR_ILLEGAL);
+        // The rows of 8 overlap at the stride 4.
+        mcon::Vector<double> real(3 * 8);
+        mcon::Vector<double> imag(3 * 8);
+        CHECK_VALUE(masp::ft::FftMany(real, imag, 4, 3, plan8), -ERROR_ILLEGAL);
+    }
+    // The interleaved, the long, the mixed-radix and Bluestein's, with
+    // the rows which are not a multiple of the interleaved ones.
+    const int lengths[] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 1024, 12, 97};
+    const int rows = 11;
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(int); ++i)
+    {
+        const int n = lengths[i];
+        LOG("    n=%d\n", n);
+        mcon::Matrix<double> input(rows, n);
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                input[r][k] = sin(0.3 * k * (r + 1)) + 0.01 * k * r;
+            }
+        }
+        const masp::ft::FftPlan plan(n);
+        const masp::ft::FftPlan inverse(n, masp::ft::FftPlan::Direction_Inverse);
+        mcon::Matrix<double> expected(2 * rows, n);
+        for (int r = 0; r < rows; ++r)
+        {
+            expected[2 * r + 0] = input[r];
+            expected[2 * r + 1] = 0;
+            plan.Execute(expected[2 * r + 0], expected[2 * r + 1]);
+        }
+        const size_t threadCounts[] = {1, 3, 0};
+        for (unsigned int t = 0; t < sizeof(threadCounts)/sizeof(size_t); ++t)
+        {
+            mcon::Matrix<double> output;
+            status_t status = masp::ft::FftMany(output, input, plan, threadCounts[t]);
+            CHECK_VALUE(status, NO_ERROR);
+            bool isSame = output.GetRowLength() == 2 * rows;
+            for (int r = 0; isSame && r < 2 * rows; ++r)
+            {
+                for (int k = 0; k < n; ++k)
+                {
+                    isSame &= (output[r][k] == expected[r][k]);
+                }
+            }
+            CHECK_VALUE(isSame, true);
+        }
+        // In place at a stride, back to the time domain.
+        const int stride = n + 3;
+        mcon::Vector<double> real(rows * stride);
+        mcon::Vector<double> imag(rows * stride);
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                real[r * stride + k] = expected[2 * r + 0][k];
+                imag[r * stride + k] = expected[2 * r + 1][k];
+            }
+        }
+        status_t status = masp::ft::FftMany(real, imag, stride, rows, inverse, 2);
+        CHECK_VALUE(status, NO_ERROR);
+        bool isSame = true;
+        double err = 0;
+        for (int r = 0; r < rows; ++r)
+        {
+            mcon::Matrix<double> serial(2, n);
+            serial[0] = expected[2 * r + 0];
+            serial[1] = expected[2 * r + 1];
+            inverse.Execute(serial);
+            for (int k = 0; k < n; ++k)
+            {
+                isSame &= (real[r * stride + k] == serial[0][k]) && (imag[r * stride + k] == serial[1][k]);
+                err = std::max(err, fabs(real[r * stride + k] - input[r][k]));
+            }
+        }
+        CHECK_VALUE(isSame, true);
+        CHECK_VALUE(err, 0);
+    }
+}
+
+static void test_raw_fft(void)
+{
+    LOG("* [Fft on raw buffers]\n");
+    {
+        double td[4] = {0};
+        double real[4] = {0};
+        double imag[4] = {0};
+        const masp::ft::FftPlan inverse(4, masp::ft::FftPlan::Direction_Inverse);
+        CHECK_VALUE(masp::ft::Fft(real, imag, td, inverse), -ERROR_ILLEGAL);
+        CHECK_VALUE(masp::ft::Fft(real, imag, td, 0), -ERROR_ILLEGAL);
+        CHECK_VALUE(masp::ft::Ifft(td, real, imag, 0), -ERROR_ILLEGAL);
+    }
+    // A power of 2, the mixed radices and Bluestein's, at the aligned and
+    // the unaligned addresses.
+    const int lengths[] = {256, 360, 97};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(int); ++i)
+    {
+        const int n = lengths[i];
+        for (int offset = 0; offset < 2; ++offset)
+        {
+            LOG("    n=%d, offset=%d\n", n, offset);
+            mcon::Vector<double> buffer(n);
+            for (int k = 0; k < n; ++k)
+            {
+                buffer[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * k;
+            }
+            mcon::Matrix<double> expected;
+            masp::ft::Fft(expected, buffer);
+
+            // The buffers of the caller, shifted by offset from the alignment.
+            mcon::Vector<double> storage(5 * (n + 1));
+            double* td = &storage[0 * (n + 1) + offset];
+            double* real = &storage[1 * (n + 1) + offset];
+            double* imag = &storage[2 * (n + 1) + offset];
+            double* ifft = &storage[3 * (n + 1) + offset];
+            double* imagCopy = &storage[4 * (n + 1) + offset];
+            memcpy(td, buffer, n * sizeof(double));
+
+            const masp::ft::FftPlan plan(n);
+            const masp::ft::FftPlan inverse(n, masp::ft::FftPlan::Direction_Inverse);
+            mcon::Vector<double> work(std::max(plan.GetWorkLength(), inverse.GetWorkLength()) + 1);
+            status_t status = masp::ft::Fft(real, imag, td, plan, &work[0]);
+            CHECK_VALUE(status, NO_ERROR);
+            bool isSame = true;
+            for (int k = 0; k < n; ++k)
+            {
+                isSame &= (real[k] == expected[0][k]) && (imag[k] == expected[1][k]);
+            }
+            CHECK_VALUE(isSame, true);
+
+            // Out of place and in place back to the time domain.
+            memcpy(imagCopy, imag, n * sizeof(double));
+            status = masp::ft::Ifft(ifft, real, imagCopy, inverse, &work[0]);
+            CHECK_VALUE(status, NO_ERROR);
+            status = masp::ft::Ifft(real, real, imag, inverse);
+            CHECK_VALUE(status, NO_ERROR);
+            double err = 0;
+            for (int k = 0; k < n; ++k)
+            {
+                err = std::max(err, fabs(ifft[k] - buffer[k]) + fabs(real[k] - buffer[k]));
+            }
+            CHECK_VALUE(err, 0);
+
+            // Without a plan.
+            status = masp::ft::Fft(real, imag, td, n);
+            CHECK_VALUE(status, NO_ERROR);
+            status = masp::ft::Ifft(ifft, real, imag, n);
+            CHECK_VALUE(status, NO_ERROR);
+            err = 0;
+            for (int k = 0; k < n; ++k)
+            {
+                err = std::max(err, fabs(ifft[k] - buffer[k]));
+            }
+            CHECK_VALUE(err, 0);
+        }
+    }
+}
+
+static void test_real_fft(void)
+{
+    LOG("* [RealFft]\n");
+    {
+        const masp::ft::RealFftPlan plan1(1);
+        CHECK_VALUE(plan1.IsNull(), true);
+        const masp::ft::RealFftPlan plan5(5);
+        CHECK_VALUE(plan5.IsNull(), true);
+        mcon::Vector<double> buffer(5);
+        mcon::Matrix<double> complex;
+        CHECK_VALUE(masp::ft::RealFft(complex, buffer), -ERROR_ILLEGAL);
+        complex.Resize(2, 1);
+        CHECK_VALUE(masp::ft::RealIfft(buffer, complex), -ERROR_ILLEGAL);
+    }
+    // Including the half lengths of the mixed radices and Bluestein's.
+    const int lengths[] = {2, 4, 8, 16, 32, 64, 512, 1024, 6, 24, 200, 26, 194};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(int); ++i)
+    {
+        const int n = lengths[i];
+        LOG("    n=%d\n", n);
+        mcon::Vector<double> buffer(n);
+        for (int k = 0; k < n; ++k)
+        {
+            buffer[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * k;
+        }
+        mcon::Matrix<double> fft;
+        masp::ft::Fft(fft, buffer);
+
+        const masp::ft::RealFftPlan plan(n);
+        CHECK_VALUE(plan.GetBinCount(), n / 2 + 1);
+        mcon::Matrix<double> half;
+        status_t status = masp::ft::RealFft(half, buffer, plan);
+        CHECK_VALUE(status, NO_ERROR);
+        CHECK_VALUE(half.GetColumnLength(), n / 2 + 1);
+        double err = 0;
+        for (int k = 0; k <= n / 2; ++k)
+        {
+            err = std::max(err, fabs(half[0][k] - fft[0][k]) + fabs(half[1][k] - fft[1][k]));
+        }
+        CHECK_VALUE(err / n, 0);
+
+        mcon::Matrix<double> full;
+        status = masp::ft::RealFft(full, buffer, true);
+        CHECK_VALUE(status, NO_ERROR);
+        CHECK_VALUE(full.GetColumnLength(), n);
+        err = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err = std::max(err, fabs(full[0][k] - fft[0][k]) + fabs(full[1][k] - fft[1][k]));
+        }
+        CHECK_VALUE(err / n, 0);
+
+        mcon::Vector<double> ifft;
+        status = masp::ft::RealIfft(ifft, half);
+        CHECK_VALUE(status, NO_ERROR);
+        CHECK_VALUE(ifft.GetLength(), n);
+        err = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err = std::max(err, fabs(ifft[k] - buffer[k]));
+        }
+        CHECK_VALUE(err, 0);
+    }
+}
+
+static void test_fft_single(void)
+{
+    LOG("* [FftPlanf]\n");
+#define POW2(v) ((v)*(v))
+    // The RMS of the error of float relative to the one of the result of
+    // double, on the powers of 2 small enough to be interleaved and not,
+    // the mixed radices and Bluestein's.
+    const int lengths[] = {8, 16, 64, 1024, 16384, 360, 1000, 97, 1009};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(int); ++i)
+    {
+        const int n = lengths[i];
+        mcon::Vector<double> buffer(n);
+        float* td = new float[5 * n];
+        float* real = td + n;
+        float* imag = real + n;
+        float* work = NULL;
+        for (int k = 0; k < n; ++k)
+        {
+            buffer[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * (k % 100);
+            td[k] = static_cast<float>(buffer[k]);
+        }
+        mcon::Matrix<double> expected;
+        masp::ft::Fft(expected, buffer);
+
+        const masp::ft::FftPlanf plan(n);
+        const masp::ft::FftPlanf inverse(n, masp::ft::FftPlanf::Direction_Inverse);
+        CHECK_VALUE(plan.GetWorkLength(), inverse.GetWorkLength());
+        if ( 0 < plan.GetWorkLength() )
+        {
+            work = new float[plan.GetWorkLength()];
+        }
+        status_t status = masp::ft::Fft(real, imag, td, plan, work);
+        CHECK_VALUE(status, NO_ERROR);
+        double err = 0;
+        double norm = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err += POW2(real[k] - expected[0][k]) + POW2(imag[k] - expected[1][k]);
+            norm += POW2(expected[0][k]) + POW2(expected[1][k]);
+        }
+        const double fftErr = sqrt(err / norm);
+
+        status = masp::ft::Ifft(real, real, imag, inverse, work);
+        CHECK_VALUE(status, NO_ERROR);
+        err = 0;
+        norm = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            err += POW2(real[k] - buffer[k]);
+            norm += POW2(buffer[k]);
+        }
+        const double ifftErr = sqrt(err / norm);
+        LOG("    n=%d, fft=%g, ifft=%g\n", n, fftErr, ifftErr);
+        CHECK_VALUE(fftErr < 1e-7 * log2(n), true);
+        CHECK_VALUE(ifftErr < 1e-7 * log2(n), true);
+        delete[] work;
+        delete[] td;
+    }
+
+    // The real one and FftMany(), of which the interleaved lanes are 8.
+    CHECK_VALUE(masp::ft::FftPlanf::InterleavedCount, 8);
+    const int lengths2[] = {2, 16, 64, 4096, 24, 194};
+    for (unsigned int i = 0; i < sizeof(lengths2)/sizeof(int); ++i)
+    {
+        const int n = lengths2[i];
+        const int rows = 11;
+        mcon::Vector<double> buffer(n);
+        float* td = new float[n];
+        for (int k = 0; k < n; ++k)
+        {
+            buffer[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * (k % 100);
+            td[k] = static_cast<float>(buffer[k]);
+        }
+        mcon::Matrix<double> expected;
+        masp::ft::Fft(expected, buffer);
+
+        const masp::ft::RealFftPlanf realPlan(n);
+        float* real = new float[n / 2 + 1];
+        float* imag = new float[n / 2 + 1];
+        status_t status = realPlan.Forward(real, imag, td);
+        CHECK_VALUE(status, NO_ERROR);
+        double err = 0;
+        double norm = 0;
+        for (int k = 0; k <= n / 2; ++k)
+        {
+            err += POW2(real[k] - expected[0][k]) + POW2(imag[k] - expected[1][k]);
+            norm += POW2(expected[0][k]) + POW2(expected[1][k]);
+        }
+        const double realErr = sqrt(err / norm);
+
+        const masp::ft::FftPlanf plan(n);
+        float* reals = new float[2 * rows * n];
+        float* imags = reals + rows * n;
+        for (int r = 0; r < rows; ++r)
+        {
+            memcpy(reals + r * n, td, n * sizeof(float));
+            memset(imags + r * n, 0, n * sizeof(float));
+        }
+        status = masp::ft::FftMany(reals, imags, n, rows, plan, 2);
+        CHECK_VALUE(status, NO_ERROR);
+        // Every row is identical to Execute() of it.
+        float* single = new float[2 * n + plan.GetWorkLength()];
+        memcpy(single, td, n * sizeof(float));
+        memset(single + n, 0, n * sizeof(float));
+        plan.Execute(single, single + n, single + 2 * n);
+        bool isSame = true;
+        for (int r = 0; r < rows; ++r)
+        {
+            isSame &= 0 == memcmp(reals + r * n, single, n * sizeof(float));
+            isSame &= 0 == memcmp(imags + r * n, single + n, n * sizeof(float));
+        }
+        LOG("    n=%d, real=%g\n", n, realErr);
+        CHECK_VALUE(realErr < 1e-7 * std::max(1.0, log2(n)), true);
+        CHECK_VALUE(isSame, true);
+        delete[] single;
+        delete[] reals;
+        delete[] real;
+        delete[] imag;
+        delete[] td;
+    }
+#undef POW2
+}
+
+static void test_fft_four_step(void)
+{
+    LOG("* [FftPlan, FourStep]\n");
+#define POW2(v) ((v)*(v))
+    // The powers of 2 of N1 x N1 and N1 x 2 N1 by the four-step, and
+    // Bluestein's of which the inner one is by the four-step.
+    const size_t F = masp::ft::FftPlan::FourStepLength;
+    const size_t lengths[] = {F, 2 * F, F / 2 + 1};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(size_t); ++i)
+    {
+        const size_t n = lengths[i];
+        const masp::ft::FftPlan plan(n);
+        const masp::ft::FftPlan inverse(n, masp::ft::FftPlan::Direction_Inverse);
+        CHECK_VALUE(plan.GetLength(), n);
+        CHECK_VALUE(0 < plan.GetWorkLength(), true);
+        double* td = new double[n];
+        double* real = new double[2 * n];
+        double* imag = real + n;
+        double* work = new double[plan.GetWorkLength()];
+        for (size_t k = 0; k < n; ++k)
+        {
+            td[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * (k % 100);
+        }
+        memcpy(real, td, n * sizeof(double));
+        memset(imag, 0, n * sizeof(double));
+        status_t status = plan.Execute(real, imag, work, 1);
+        CHECK_VALUE(status, NO_ERROR);
+
+        // Some of the bins by the direct DFT.
+        const size_t bins[] = {0, 1, 2, 1023, 1024, 1025, n / 3, n / 2, n - 1};
+        double err = 0;
+        double norm = 0;
+        for (unsigned int j = 0; j < sizeof(bins)/sizeof(size_t); ++j)
+        {
+            const size_t b = bins[j];
+            long double re = 0;
+            long double im = 0;
+            for (size_t k = 0; k < n; ++k)
+            {
+                const long double phase = - 2.0L * M_PI * ((b * k) % n) / n;
+                re += td[k] * cosl(phase);
+                im += td[k] * sinl(phase);
+            }
+            err += POW2(real[b] - static_cast<double>(re)) + POW2(imag[b] - static_cast<double>(im));
+            norm += POW2(static_cast<double>(re)) + POW2(static_cast<double>(im));
+        }
+        const double fftErr = sqrt(err / norm);
+
+        // The same on any number of the threads.
+        double* other = new double[2 * n];
+        const size_t threadCounts[] = {2, 3, 0};
+        bool isSame = true;
+        for (unsigned int j = 0; j < sizeof(threadCounts)/sizeof(size_t); ++j)
+        {
+            memcpy(other, td, n * sizeof(double));
+            memset(other + n, 0, n * sizeof(double));
+            status = plan.Execute(other, other + n, work, threadCounts[j]);
+            CHECK_VALUE(status, NO_ERROR);
+            isSame &= 0 == memcmp(other, real, 2 * n * sizeof(double));
+        }
+        memcpy(other, td, n * sizeof(double));
+        memset(other + n, 0, n * sizeof(double));
+        status = plan.Execute(other, other + n);
+        CHECK_VALUE(status, NO_ERROR);
+        isSame &= 0 == memcmp(other, real, 2 * n * sizeof(double));
+        CHECK_VALUE(isSame, true);
+        delete[] other;
+
+        status = inverse.Execute(real, imag, work, 2);
+        CHECK_VALUE(status, NO_ERROR);
+        err = 0;
+        norm = 0;
+        for (size_t k = 0; k < n; ++k)
+        {
+            err += POW2(real[k] - td[k]) + POW2(imag[k]);
+            norm += POW2(td[k]);
+        }
+        const double ifftErr = sqrt(err / norm);
+        LOG("    n=%zu, fft=%g, ifft=%g\n", n, fftErr, ifftErr);
+        CHECK_VALUE(fftErr < 1e-13, true);
+        CHECK_VALUE(ifftErr < 1e-14, true);
+        delete[] work;
+        delete[] real;
+        delete[] td;
+    }
+
+    // The round trip of float.
+    {
+        const size_t n = F;
+        const masp::ft::FftPlanf plan(n);
+        const masp::ft::FftPlanf inverse(n, masp::ft::FftPlanf::Direction_Inverse);
+        float* td = new float[n];
+        float* real = new float[2 * n + plan.GetWorkLength()];
+        float* imag = real + n;
+        float* work = imag + n;
+        for (size_t k = 0; k < n; ++k)
+        {
+            td[k] = static_cast<float>(sin(0.3 * k) + 0.5 * cos(1.7 * k));
+        }
+        memcpy(real, td, n * sizeof(float));
+        memset(imag, 0, n * sizeof(float));
+        status_t status = plan.Execute(real, imag, work, 0);
+        CHECK_VALUE(status, NO_ERROR);
+        status = inverse.Execute(real, imag, work, 0);
+        CHECK_VALUE(status, NO_ERROR);
+        double err = 0;
+        double norm = 0;
+        for (size_t k = 0; k < n; ++k)
+        {
+            err += POW2(real[k] - td[k]) + POW2(imag[k]);
+            norm += POW2(td[k]);
+        }
+        const double ifftErr = sqrt(err / norm);
+        LOG("    n=%zu, float ifft=%g\n", n, ifftErr);
+        CHECK_VALUE(ifftErr < 1e-6, true);
+        delete[] real;
+        delete[] td;
+    }
+#undef POW2
+}
+
+static void test_chirp_z(void)
+{
+    LOG("* [ChirpZPlan]\n");
+#define POW2(v) ((v)*(v))
+    // The bands of some lengths against the direct DFT, where the last
+    // one is descending and the complex one shifts the band by 0.25.
+    const size_t lengths[] = {100, 1000, 97, 4096, 33};
+    const size_t counts[] = {37, 500, 1, 64, 129};
+    const double bands[][2] = {{0.1, 0.13}, {-0.2, 0.45}, {0.3, 0.3}, {0.01, 0.012}, {0.4, 0.05}};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(size_t); ++i)
+    {
+        const size_t n = lengths[i];
+        const size_t M = counts[i];
+        double* td = new double[2 * n];
+        double* ti = td + n;
+        for (size_t k = 0; k < n; ++k)
+        {
+            td[k] = sin(0.3 * k) + 0.5 * cos(1.7 * k) + 0.01 * (k % 100);
+            // x[n] exp(j 2 pi 0.25 n), of which X(f) is the one of td at f - 0.25.
+            ti[k] = td[k] * sin(0.5 * M_PI * (k % 4));
+        }
+        const masp::ft::ChirpZPlan plan(n, M, bands[i][0], bands[i][1]);
+        CHECK_VALUE(plan.GetLength(), n);
+        CHECK_VALUE(plan.GetCount(), M);
+        CHECK_VALUE(plan.GetFrequency(0), bands[i][0]);
+        if ( 1 < M )
+        {
+            CHECK_VALUE(plan.GetFrequency(M - 1), bands[i][1]);
+        }
+        double* real = new double[4 * M];
+        double* imag = real + M;
+        double* shiftedReal = imag + M;
+        double* shiftedImag = shiftedReal + M;
+        double* work = new double[plan.GetWorkLength()];
+        status_t status = plan.Execute(real, imag, td, work);
+        CHECK_VALUE(status, NO_ERROR);
+        double* tr = new double[n];
+        for (size_t k = 0; k < n; ++k)
+        {
+            tr[k] = td[k] * cos(0.5 * M_PI * (k % 4));
+        }
+        const masp::ft::ChirpZPlan shifted(n, M, bands[i][0] + 0.25, bands[i][1] + 0.25);
+        status = shifted.Execute(shiftedReal, shiftedImag, tr, ti, NULL);
+        CHECK_VALUE(status, NO_ERROR);
+
+        double err = 0;
+        double shiftedErr = 0;
+        double norm = 0;
+        for (size_t m = 0; m < M; ++m)
+        {
+            const long double f = plan.GetFrequency(m);
+            long double re = 0;
+            long double im = 0;
+            for (size_t k = 0; k < n; ++k)
+            {
+                const long double phase = - 2.0L * M_PI * f * k;
+                re += td[k] * cosl(phase);
+                im += td[k] * sinl(phase);
+            }
+            err += POW2(real[m] - static_cast<double>(re)) + POW2(imag[m] - static_cast<double>(im));
+            shiftedErr += POW2(shiftedReal[m] - static_cast<double>(re)) + POW2(shiftedImag[m] - static_cast<double>(im));
+            norm += POW2(static_cast<double>(re)) + POW2(static_cast<double>(im));
+        }
+        err = sqrt(err / norm);
+        shiftedErr = sqrt(shiftedErr / norm);
+        LOG("    n=%d, M=%d, err=%g, shifted=%g\n", static_cast<int>(n), static_cast<int>(M), err, shiftedErr);
+        CHECK_VALUE(err < 1e-12, true);
+        CHECK_VALUE(shiftedErr < 1e-12, true);
+
+        // The matrix one.
+        mcon::Vector<double> buffer(n);
+        for (size_t k = 0; k < n; ++k)
+        {
+            buffer[k] = td[k];
+        }
+        mcon::Matrix<double> complex;
+        status = masp::ft::ChirpZ(complex, buffer, M, bands[i][0], bands[i][1]);
+        CHECK_VALUE(status, NO_ERROR);
+        CHECK_VALUE(complex.GetColumnLength(), M);
+        CHECK_VALUE(0 == memcmp(complex[0], real, M * sizeof(double)), true);
+        delete[] tr;
+        delete[] work;
+        delete[] real;
+        delete[] td;
+    }
+
+    // The bins of the FFT over [0, (N - 1) / N].
+    {
+        const size_t n = 360;
+        mcon::Vector<double> buffer(n);
+        for (size_t k = 0; k < n; ++k)
+        {
+            buffer[k] = sin(0.3 * k) + 0.01 * (k % 100);
+        }
+        mcon::Matrix<double> expected;
+        mcon::Matrix<double> complex;
+        masp::ft::Fft(expected, buffer);
+        const status_t status = masp::ft::ChirpZ(complex, buffer, n, 0.0, (n - 1.0) / n);
+        CHECK_VALUE(status, NO_ERROR);
+        double err = 0;
+        double norm = 0;
+        for (size_t k = 0; k < n; ++k)
+        {
+            err += POW2(complex[0][k] - expected[0][k]) + POW2(complex[1][k] - expected[1][k]);
+            norm += POW2(expected[0][k]) + POW2(expected[1][k]);
+        }
+        err = sqrt(err / norm);
+        LOG("    n=%d, fft=%g\n", static_cast<int>(n), err);
+        CHECK_VALUE(err < 1e-13, true);
+    }
+
+    // The illegal ones.
+    {
+        const masp::ft::ChirpZPlan noCount(16, 0, 0.0, 0.5);
+        const masp::ft::ChirpZPlan noLength(0, 16, 0.0, 0.5);
+        CHECK_VALUE(noCount.IsNull(), true);
+        CHECK_VALUE(noLength.IsNull(), true);
+        double buffer[32] = {0};
+        status_t status = noCount.Execute(buffer, buffer + 16, buffer);
+        CHECK_VALUE(status, -ERROR_ILLEGAL);
+        const masp::ft::ChirpZPlan plan(16, 16, 0.0, 0.5);
+        mcon::Matrix<double> complex;
+        status = masp::ft::ChirpZ(complex, mcon::Vector<double>(15), plan);
+        CHECK_VALUE(status, -ERROR_ILLEGAL);
+    }
+#undef POW2
+}
+
 void test_Ft(void)
 {
     test_ft();
     test_ft_buffer();
     test_gp_complex();
     test_fft();
+    test_fft_plan();
+    test_fft_any_length();
+    test_fft_many();
+    test_raw_fft();
+    test_real_fft();
+    test_fft_single();
+    test_fft_four_step();
+    test_chirp_z();
 }
@@ -0,0 +1,228 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "types.h"
+#include "status.h"
+#include "debug.h"
+#include "masp/Ft.h"
+#include "masp/Correlation.h"
+
+namespace {
+
+// The cost of a real FFT of M per M log2(M), in the multiply-adds of
+// the direct sums.
+const double g_FftCostFactor = 0.8;
+const size_t g_MinFftLength = 16;
+
+// The range of k of sum_k x[k] y[k + lag], which is empty when begin >= end.
+inline void GetOverlap(ssize_t& begin, ssize_t& end, size_t xLength, size_t yLength, ssize_t lag)
+{
+    begin = std::max(static_cast<ssize_t>(0), -lag);
+    end = std::min(static_cast<ssize_t>(xLength), static_cast<ssize_t>(yLength) - lag);
+}
+
+double GetDirectCost(size_t xLength, size_t yLength, int minLag, int maxLag)
+{
+    double cost = 0;
+    for (ssize_t l = minLag; l <= maxLag; ++l)
+    {
+        ssize_t begin, end;
+        GetOverlap(begin, end, xLength, yLength, l);
+        cost += std::max(static_cast<ssize_t>(0), end - begin);
+    }
+    return cost;
+}
+
+// The FFT length M of the least cost for span samples of x, which are
+// cut into the blocks of M - lagCount + 1, each needing the FFTs of the
+// block and of y under it and the inverse.
+size_t ChooseFftLength(size_t span, size_t lagCount, double& cost)
+{
+    size_t M = g_MinFftLength;
+    while ( M < 2 * lagCount )
+    {
+        M *= 2;
+    }
+    size_t best = M;
+    cost = -1;
+    for ( ; ; M *= 2)
+    {
+        const size_t B = M - lagCount + 1;
+        const size_t blockCount = (span + B - 1) / B;
+        const double c = blockCount * (3 * g_FftCostFactor * M * log2(static_cast<double>(M)) + 2.0 * M);
+        if ( cost < 0 || c < cost )
+        {
+            cost = c;
+            best = M;
+        }
+        if ( span <= B )
+        {
+            break;
+        }
+    }
+    return best;
+}
+
+void CorrelateDirect(double c[], const double x[], size_t xLength, const double y[], size_t yLength, int minLag, int maxLag)
+{
+    for (ssize_t l = minLag; l <= maxLag; ++l)
+    {
+        ssize_t begin, end;
+        GetOverlap(begin, end, xLength, yLength, l);
+        double sum = 0;
+        for (ssize_t k = begin; k < end; ++k)
+        {
+            sum += x[k] * y[k + l];
+        }
+        c[l - minLag] = sum;
+    }
+}
+
+// By the circular correlation IFFT(conj(X) Y) of M for each block of x
+// [k0, k0 + B), where y is taken from k0 + minLag for B + lagCount - 1
+// samples, so that the lags [0, lagCount) of it never wrap around.
+void CorrelateFft(double c[], const double x[], size_t xLength, const double y[], size_t yLength, int minLag, int maxLag)
+{
+    const size_t lagCount = maxLag - minLag + 1;
+    memset(c, 0, lagCount * sizeof(double));
+    // k where any of the lags overlaps y.
+    const ssize_t kBegin = std::max(static_cast<ssize_t>(0), -static_cast<ssize_t>(maxLag));
+    const ssize_t kEnd = std::min(static_cast<ssize_t>(xLength), static_cast<ssize_t>(yLength) - minLag);
+    if ( kEnd <= kBegin )
+    {
+        return;
+    }
+    double cost;
+    const size_t M = ChooseFftLength(kEnd - kBegin, lagCount, cost);
+    const size_t B = M - lagCount + 1;
+    const size_t binCount = M / 2 + 1;
+    const masp::ft::RealFftPlan plan(M);
+    double* xb = new double[3 * M + 4 * binCount];
+    double* yb = xb + M;
+    double* out = yb + M;
+    double* xr = out + M;
+    double* xi = xr + binCount;
+    double* yr = xi + binCount;
+    double* yi = yr + binCount;
+    for (ssize_t k0 = kBegin; k0 < kEnd; k0 += B)
+    {
+        const size_t n = std::min(static_cast<ssize_t>(B), kEnd - k0);
+        memset(xb, 0, M * sizeof(double));
+        memcpy(xb, x + k0, n * sizeof(double));
+        memset(yb, 0, M * sizeof(double));
+        for (size_t i = 0; i < n + lagCount - 1; ++i)
+        {
+            const ssize_t m = k0 + minLag + i;
+            if ( 0 <= m && m < static_cast<ssize_t>(yLength) )
+            {
+                yb[i] = y[m];
+            }
+        }
+        plan.Forward(xr, xi, xb);
+        plan.Forward(yr, yi, yb);
+        for (size_t k = 0; k < binCount; ++k)
+        {
+            const double zr = xr[k] * yr[k] + xi[k] * yi[k];
+            const double zi = xr[k] * yi[k] - xi[k] * yr[k];
+            yr[k] = zr;
+            yi[k] = zi;
+        }
+        plan.Inverse(out, yr, yi);
+        for (size_t s = 0; s < lagCount; ++s)
+        {
+            c[s] += out[s];
+        }
+    }
+    delete[] xb;
+}
+
+} // anonymous namespace
+
+namespace masp {
+namespace corr {
+
+status_t CrossCorrelate(double c[], const double x[], size_t xLength, const double y[], size_t yLength, int minLag, int maxLag, Method method)
+{
+    if ( NULL == c || NULL == x || NULL == y || 0 == xLength || 0 == yLength || maxLag < minLag )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    if ( Method_Auto == method )
+    {
+        // Both of the costs are counted only on the lags overlapping.
+        const ssize_t kBegin = std::max(static_cast<ssize_t>(0), -static_cast<ssize_t>(maxLag));
+        const ssize_t kEnd = std::min(static_cast<ssize_t>(xLength), static_cast<ssize_t>(yLength) - minLag);
+        double fftCost = 0;
+        if ( kBegin < kEnd )
+        {
+            ChooseFftLength(kEnd - kBegin, maxLag - minLag + 1, fftCost);
+        }
+        method = GetDirectCost(xLength, yLength, minLag, maxLag) <= fftCost ? Method_Direct : Method_Fft;
+    }
+    if ( Method_Direct == method )
+    {
+        CorrelateDirect(c, x, xLength, y, yLength, minLag, maxLag);
+    }
+    else
+    {
+        CorrelateFft(c, x, xLength, y, yLength, minLag, maxLag);
+    }
+    return NO_ERROR;
+}
+
+status_t CrossCorrelate(mcon::Vector<double>& c, const mcon::VectordBase& x, const mcon::VectordBase& y, int minLag, int maxLag, Method method)
+{
+    if ( 0 == x.GetLength() || 0 == y.GetLength() || maxLag < minLag )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    if ( false == c.Resize(maxLag - minLag + 1) )
+    {
+        return -ERROR_CANNOT_ALLOCATE_MEMORY;
+    }
+    return CrossCorrelate(c, x, x.GetLength(), y, y.GetLength(), minLag, maxLag, method);
+}
+
+status_t CrossCorrelate(mcon::Vector<double>& c, const mcon::VectordBase& x, const mcon::VectordBase& y, Method method)
+{
+    return CrossCorrelate(c, x, y, 1 - static_cast<int>(x.GetLength()), static_cast<int>(y.GetLength()) - 1, method);
+}
+
+status_t AutoCorrelate(double r[], const double x[], size_t length, size_t maxLag, Method method)
+{
+    return CrossCorrelate(r, x, length, x, length, 0, static_cast<int>(maxLag), method);
+}
+
+status_t AutoCorrelate(mcon::Vector<double>& r, const mcon::VectordBase& x, size_t maxLag, Method method)
+{
+    return CrossCorrelate(r, x, x, 0, static_cast<int>(maxLag), method);
+}
+
+} // namespace corr {
+} // namespace masp {
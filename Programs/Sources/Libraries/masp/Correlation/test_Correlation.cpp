@@ -0,0 +1,161 @@
+
+#include <stdio.h>
+#include <math.h>
+
+#include <algorithm>
+
+#include "status.h"
+#include "debug.h"
+#include "masp.h"
+
+namespace {
+
+double Reference(const mcon::Vector<double>& x, const mcon::Vector<double>& y, int lag)
+{
+    double sum = 0;
+    for (int k = 0; k < static_cast<int>(x.GetLength()); ++k)
+    {
+        const int m = k + lag;
+        if ( 0 <= m && m < static_cast<int>(y.GetLength()) )
+        {
+            sum += x[k] * y[m];
+        }
+    }
+    return sum;
+}
+
+void Generate(mcon::Vector<double>& v, double seed)
+{
+    for (size_t n = 0; n < v.GetLength(); ++n)
+    {
+        v[n] = sin(seed * n + 0.3) + 0.5 * cos(seed * seed * n * n / v.GetLength());
+    }
+}
+
+}
+
+static void test_cross_correlate(void)
+{
+    LOG("* [CrossCorrelate]\n");
+    mcon::Vector<double> x(300), y(1000), c;
+    Generate(x, 0.7);
+    Generate(y, 1.1);
+    {
+        double _c[4];
+        CHECK_VALUE(masp::corr::CrossCorrelate(NULL, x, 300, y, 1000, 0, 3), -ERROR_ILLEGAL);
+        CHECK_VALUE(masp::corr::CrossCorrelate(_c, x, 0, y, 1000, 0, 3), -ERROR_ILLEGAL);
+        CHECK_VALUE(masp::corr::CrossCorrelate(_c, x, 300, y, 1000, 3, 0), -ERROR_ILLEGAL);
+        const mcon::Vector<double> empty;
+        CHECK_VALUE(masp::corr::CrossCorrelate(c, empty, y), -ERROR_ILLEGAL);
+    }
+    const int ranges[][2] =
+    {
+        {0, 0},
+        {0, 63},
+        {-20, 20},
+        {-299, 999},
+        // Partly and entirely out of the overlap.
+        {900, 1200},
+        {-400, -300},
+        {1000, 1010},
+    };
+    const masp::corr::Method methods[] =
+    {
+        masp::corr::Method_Direct,
+        masp::corr::Method_Fft,
+        masp::corr::Method_Auto,
+    };
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); ++i)
+    {
+        const int minLag = ranges[i][0];
+        const int maxLag = ranges[i][1];
+        double err[3] = {0, 0, 0};
+        for (size_t m = 0; m < 3; ++m)
+        {
+            masp::corr::CrossCorrelate(c, x, y, minLag, maxLag, methods[m]);
+            if ( static_cast<int>(c.GetLength()) != maxLag - minLag + 1 )
+            {
+                err[m] = 1;
+                continue;
+            }
+            for (int l = minLag; l <= maxLag; ++l)
+            {
+                err[m] = std::max(err[m], fabs(c[l - minLag] - Reference(x, y, l)));
+            }
+        }
+        LOG("    [%d, %d]\n", minLag, maxLag);
+        CHECK_VALUE(err[0], 0);
+        CHECK_VALUE(err[1] < 1e-10, true);
+        CHECK_VALUE(err[2] < 1e-10, true);
+    }
+    {
+        // The full range of x against y and y against x.
+        CHECK_VALUE(masp::corr::CrossCorrelate(c, x, y), NO_ERROR);
+        CHECK_VALUE(c.GetLength(), 1299);
+        double err = 0;
+        for (int l = -299; l <= 999; ++l)
+        {
+            err = std::max(err, fabs(c[l + 299] - Reference(x, y, l)));
+        }
+        CHECK_VALUE(err < 1e-10, true);
+        mcon::Vector<double> d;
+        masp::corr::CrossCorrelate(d, y, x, masp::corr::Method_Fft);
+        err = 0;
+        for (int l = -999; l <= 299; ++l)
+        {
+            // sum_k y[k] x[k + l] = sum_k x[k] y[k - l]
+            err = std::max(err, fabs(d[l + 999] - c[-l + 299]));
+        }
+        CHECK_VALUE(err < 1e-10, true);
+    }
+    {
+        // Long signals with a few lags, which are cut into blocks.
+        mcon::Vector<double> u(50000), v(50000);
+        Generate(u, 0.31);
+        Generate(v, 0.47);
+        mcon::Vector<double> direct, fft;
+        masp::corr::CrossCorrelate(direct, u, v, -100, 400, masp::corr::Method_Direct);
+        masp::corr::CrossCorrelate(fft, u, v, -100, 400, masp::corr::Method_Fft);
+        double err = 0;
+        for (size_t l = 0; l < direct.GetLength(); ++l)
+        {
+            err = std::max(err, fabs(direct[l] - fft[l]) / direct.GetMaximumAbsolute());
+        }
+        CHECK_VALUE(err < 1e-12, true);
+    }
+}
+
+static void test_auto_correlate(void)
+{
+    LOG("* [AutoCorrelate]\n");
+    mcon::Vector<double> x(777), r;
+    Generate(x, 0.9);
+    CHECK_VALUE(masp::corr::AutoCorrelate(r, x, 776, masp::corr::Method_Fft), NO_ERROR);
+    CHECK_VALUE(r.GetLength(), 777);
+    double err = 0;
+    for (int l = 0; l < 777; ++l)
+    {
+        err = std::max(err, fabs(r[l] - Reference(x, x, l)));
+    }
+    CHECK_VALUE(err < 1e-10, true);
+    CHECK_VALUE(r[0], x.GetDotProduct(x));
+    // Longer than the signal, where the lags out of it are 0.
+    masp::corr::AutoCorrelate(r, x, 1000);
+    CHECK_VALUE(r.GetLength(), 1001);
+    CHECK_VALUE(r[777], 0);
+    CHECK_VALUE(r[1000], 0);
+    double _r[16];
+    CHECK_VALUE(masp::corr::AutoCorrelate(_r, x, 777, 15), NO_ERROR);
+    err = 0;
+    for (int l = 0; l < 16; ++l)
+    {
+        err = std::max(err, fabs(_r[l] - Reference(x, x, l)));
+    }
+    CHECK_VALUE(err < 1e-10, true);
+}
+
+void test_Correlation(void)
+{
+    test_cross_correlate();
+    test_auto_correlate();
+}
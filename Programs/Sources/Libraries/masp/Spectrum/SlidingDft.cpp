@@ -0,0 +1,241 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+#include <x86intrin.h>
+
+#include "types.h"
+#include "status.h"
+#include "debug.h"
+#include "masp/SlidingDft.h"
+
+namespace {
+
+const size_t g_Lanes = 4;
+
+inline size_t GetPaddedCount(size_t count)
+{
+    return (count + g_Lanes - 1) / g_Lanes * g_Lanes;
+}
+
+} // anonymous namespace
+
+namespace masp {
+namespace spectrum {
+
+Goertzel::Goertzel(const double bins[], size_t binCount, size_t length)
+    : m_BinCount(0 == length || NULL == bins ? 0 : binCount)
+    , m_Length(length)
+    , m_SampleCount(0)
+    , m_Bins(m_BinCount)
+    , m_Coefficients(GetPaddedCount(m_BinCount))
+    , m_Cos(GetPaddedCount(m_BinCount))
+    , m_Sin(GetPaddedCount(m_BinCount))
+    , m_State1(GetPaddedCount(m_BinCount))
+    , m_State2(GetPaddedCount(m_BinCount))
+{
+    // The padding lanes are kept with the coefficient 0.
+    m_Coefficients = 0;
+    m_Cos = 0;
+    m_Sin = 0;
+    for (size_t k = 0; k < m_BinCount; ++k)
+    {
+        const double w = 2 * M_PI * bins[k] / length;
+        m_Bins[k] = bins[k];
+        m_Cos[k] = cos(w);
+        m_Sin[k] = sin(w);
+        m_Coefficients[k] = 2 * m_Cos[k];
+    }
+    Reset();
+}
+
+Goertzel::~Goertzel()
+{
+}
+
+void Goertzel::Reset(void)
+{
+    m_State1 = 0;
+    m_State2 = 0;
+    m_SampleCount = 0;
+}
+
+void Goertzel::Process(const double samples[], size_t count)
+{
+    if ( IsNull() || NULL == samples )
+    {
+        return;
+    }
+    const size_t P = m_State1.GetLength();
+    const double* coefficients = m_Coefficients;
+    double* state1 = m_State1;
+    double* state2 = m_State2;
+    // s[n] = x[n] + 2 cos(w) s[n-1] - s[n-2], the lanes kept in the
+    // registers through the samples.
+    for (size_t v = 0; v < P; v += g_Lanes)
+    {
+        const __m256d c = _mm256_loadu_pd(coefficients + v);
+        __m256d s1 = _mm256_loadu_pd(state1 + v);
+        __m256d s2 = _mm256_loadu_pd(state2 + v);
+        for (size_t n = 0; n < count; ++n)
+        {
+            const __m256d s0 = _mm256_sub_pd(_mm256_add_pd(_mm256_set1_pd(samples[n]), _mm256_mul_pd(c, s1)), s2);
+            s2 = s1;
+            s1 = s0;
+        }
+        _mm256_storeu_pd(state1 + v, s1);
+        _mm256_storeu_pd(state2 + v, s2);
+    }
+    m_SampleCount += count;
+}
+
+void Goertzel::GetSpectrum(double real[], double imag[]) const
+{
+    const size_t L = m_SampleCount;
+    for (size_t k = 0; k < m_BinCount; ++k)
+    {
+        if ( 0 == L )
+        {
+            real[k] = 0.0;
+            imag[k] = 0.0;
+            continue;
+        }
+        // y = s[L-1] - e^(-jw) s[L-2] = sum_n x[n] e^(jw(L-1-n)), so that
+        // X = e^(-jw(L-1)) y, of which the angle is reduced modulo N.
+        const double yr = m_State1[k] - m_Cos[k] * m_State2[k];
+        const double yi = m_Sin[k] * m_State2[k];
+        const double phi = -2 * M_PI * fmod(m_Bins[k] * (L - 1), static_cast<double>(m_Length)) / m_Length;
+        const double c = cos(phi);
+        const double s = sin(phi);
+        real[k] = c * yr - s * yi;
+        imag[k] = s * yr + c * yi;
+    }
+}
+
+SlidingDft::SlidingDft(const size_t bins[], size_t binCount, size_t length)
+    : m_BinCount(0 == length || NULL == bins ? 0 : binCount)
+    , m_SampleCount(0)
+    , m_Cos(GetPaddedCount(m_BinCount))
+    , m_Sin(GetPaddedCount(m_BinCount))
+    , m_Real(GetPaddedCount(m_BinCount))
+    , m_Imag(GetPaddedCount(m_BinCount))
+    , m_Ring(0 == m_BinCount ? 0 : length)
+    , m_Position(0)
+    , m_Goertzel(NULL)
+{
+    // The padding lanes rotate by 1.
+    m_Cos = 1;
+    m_Sin = 0;
+    double* k = new double[m_BinCount + 1];
+    for (size_t i = 0; i < m_BinCount; ++i)
+    {
+        k[i] = static_cast<double>(bins[i] % length);
+        m_Cos[i] = cos(2 * M_PI * k[i] / length);
+        m_Sin[i] = sin(2 * M_PI * k[i] / length);
+    }
+    m_Goertzel = new Goertzel(k, m_BinCount, length);
+    delete[] k;
+    Reset();
+}
+
+SlidingDft::~SlidingDft()
+{
+    delete m_Goertzel;
+}
+
+void SlidingDft::Reset(void)
+{
+    m_Real = 0;
+    m_Imag = 0;
+    m_Ring = 0;
+    m_Position = 0;
+    m_SampleCount = 0;
+}
+
+inline void SlidingDft::Update(double sample)
+{
+    const size_t N = GetLength();
+    double* ring = m_Ring;
+    const __m256d d = _mm256_set1_pd(sample - ring[m_Position]);
+    ring[m_Position] = sample;
+    m_Position = m_Position + 1 == N ? 0 : m_Position + 1;
+    const double* pCos = m_Cos;
+    const double* pSin = m_Sin;
+    double* real = m_Real;
+    double* imag = m_Imag;
+    for (size_t v = 0; v < m_Real.GetLength(); v += g_Lanes)
+    {
+        const __m256d c = _mm256_loadu_pd(pCos + v);
+        const __m256d s = _mm256_loadu_pd(pSin + v);
+        const __m256d re = _mm256_add_pd(_mm256_loadu_pd(real + v), d);
+        const __m256d im = _mm256_loadu_pd(imag + v);
+        _mm256_storeu_pd(real + v, _mm256_sub_pd(_mm256_mul_pd(re, c), _mm256_mul_pd(im, s)));
+        _mm256_storeu_pd(imag + v, _mm256_add_pd(_mm256_mul_pd(re, s), _mm256_mul_pd(im, c)));
+    }
+    ++m_SampleCount;
+    if ( 0 == m_Position )
+    {
+        Refresh();
+    }
+}
+
+void SlidingDft::Refresh(void)
+{
+    const double* ring = m_Ring;
+    m_Goertzel->Reset();
+    m_Goertzel->Process(ring + m_Position, GetLength() - m_Position);
+    m_Goertzel->Process(ring, m_Position);
+    m_Goertzel->GetSpectrum(m_Real, m_Imag);
+}
+
+void SlidingDft::Process(const double samples[], size_t count)
+{
+    if ( IsNull() || NULL == samples )
+    {
+        return;
+    }
+    for (size_t n = 0; n < count; ++n)
+    {
+        Update(samples[n]);
+    }
+}
+
+void SlidingDft::Process(const double samples[], size_t count, Callback callback, void* context)
+{
+    if ( IsNull() || NULL == samples )
+    {
+        return;
+    }
+    for (size_t n = 0; n < count; ++n)
+    {
+        Update(samples[n]);
+        if ( NULL != callback )
+        {
+            callback(m_Real, m_Imag, m_SampleCount - 1, context);
+        }
+    }
+}
+
+} // namespace spectrum {
+} // namespace masp {
@@ -0,0 +1,307 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <float.h>
+#include <math.h>
+#include <x86intrin.h>
+
+#include "types.h"
+#include "status.h"
+#include "debug.h"
+#include "masp/Spectrum.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif // #ifndef M_PI
+
+namespace {
+
+const size_t g_Lanes = 4;
+
+// The lower bits of pi / 2 than M_PI / 2 has.
+const double g_PiOver2Low = 6.123233995736765886130E-17;
+
+// atan(t) = t + t z P(z) / Q(z), z = t^2, for t in [0, 0.66] (Cephes).
+const double g_AtanP[] =
+{
+    -8.750608600031904122785E-1,
+    -1.615753718733365076637E1,
+    -7.500855792314704667340E1,
+    -1.228866684490136173410E2,
+    -6.485021904942025371773E1,
+};
+const double g_AtanQ[] =
+{
+    2.485846490142306297962E1,
+    1.650270098316988542046E2,
+    4.328810604912902668951E2,
+    4.853903996359136964868E2,
+    1.945506571482613964425E2,
+};
+
+// log(1 + x) = x - x^2 / 2 + x^3 P(x) / Q(x) for 1 + x in
+// [sqrt(1/2), sqrt(2)) (Cephes).
+const double g_LogP[] =
+{
+    1.01875663804580931796E-4,
+    4.97494994976747001425E-1,
+    4.70579119878881725854E0,
+    1.44989225341610930846E1,
+    1.79368678507819816313E1,
+    7.70838733755885391666E0,
+};
+const double g_LogQ[] =
+{
+    1.12873587189167450590E1,
+    4.52279145837532221105E1,
+    8.29875266912776603211E1,
+    7.11544750618946736021E1,
+    2.31251620126765340583E1,
+};
+
+inline __m256d Set(double v)
+{
+    return _mm256_set1_pd(v);
+}
+
+// Evaluates c[0] x^(n-1) + ... + c[n-1], with the leading 1 of x^n when isMonic.
+inline __m256d Polynomial(__m256d x, const double c[], size_t n, bool isMonic)
+{
+    __m256d y = isMonic ? _mm256_add_pd(x, Set(c[0])) : Set(c[0]);
+    for (size_t i = 1; i < n; ++i)
+    {
+        y = _mm256_add_pd(_mm256_mul_pd(y, x), Set(c[i]));
+    }
+    return y;
+}
+
+// atan2(y, x) of the lanes, falling back to atan2() of libm unless all
+// the lanes are finite and not (0, 0).
+__m256d Atan2(__m256d y, __m256d x)
+{
+    const __m256d signBit = Set(-0.0);
+    const __m256d one = Set(1.0);
+    const __m256d ax = _mm256_andnot_pd(signBit, x);
+    const __m256d ay = _mm256_andnot_pd(signBit, y);
+    const __m256d large = _mm256_max_pd(ax, ay);
+    const __m256d small = _mm256_min_pd(ax, ay);
+    const __m256d isRegular = _mm256_and_pd(
+        _mm256_and_pd(_mm256_cmp_pd(ax, Set(DBL_MAX), _CMP_LE_OQ), _mm256_cmp_pd(ay, Set(DBL_MAX), _CMP_LE_OQ)),
+        _mm256_cmp_pd(large, _mm256_setzero_pd(), _CMP_GT_OQ));
+    if ( 0xF != _mm256_movemask_pd(isRegular) )
+    {
+        double _y[g_Lanes], _x[g_Lanes];
+        _mm256_storeu_pd(_y, y);
+        _mm256_storeu_pd(_x, x);
+        for (size_t i = 0; i < g_Lanes; ++i)
+        {
+            _y[i] = atan2(_y[i], _x[i]);
+        }
+        return _mm256_loadu_pd(_y);
+    }
+    // t in [0, 1], reduced to [-0.2, 0.66] by atan(t) = pi/4 + atan((t - 1)/(t + 1)).
+    __m256d t = _mm256_div_pd(small, large);
+    const __m256d isReduced = _mm256_cmp_pd(t, Set(0.66), _CMP_GT_OQ);
+    t = _mm256_blendv_pd(t, _mm256_div_pd(_mm256_sub_pd(t, one), _mm256_add_pd(t, one)), isReduced);
+    const __m256d z = _mm256_mul_pd(t, t);
+    __m256d r = _mm256_div_pd(_mm256_mul_pd(z, Polynomial(z, g_AtanP, 5, false)), Polynomial(z, g_AtanQ, 5, true));
+    r = _mm256_add_pd(_mm256_mul_pd(t, r), t);
+    r = _mm256_add_pd(r, _mm256_and_pd(isReduced, Set(0.5 * g_PiOver2Low)));
+    r = _mm256_add_pd(_mm256_and_pd(isReduced, Set(M_PI / 4)), r);
+    // pi/2 - r when |y| > |x|, then pi - r when x < 0.
+    r = _mm256_blendv_pd(r, _mm256_add_pd(Set(M_PI / 2), _mm256_sub_pd(Set(g_PiOver2Low), r)), _mm256_cmp_pd(ay, ax, _CMP_GT_OQ));
+    r = _mm256_blendv_pd(r, _mm256_add_pd(Set(M_PI), _mm256_sub_pd(Set(2 * g_PiOver2Low), r)), _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ));
+    return _mm256_or_pd(r, _mm256_and_pd(signBit, y));
+}
+
+// factor * log10(x) of the lanes, falling back to log10() of libm unless
+// all the lanes are normal positive numbers.
+__m256d Decibel(__m256d x, double factor)
+{
+    const __m256d isRegular = _mm256_and_pd(_mm256_cmp_pd(x, Set(DBL_MIN), _CMP_GE_OQ), _mm256_cmp_pd(x, Set(DBL_MAX), _CMP_LE_OQ));
+    if ( 0xF != _mm256_movemask_pd(isRegular) )
+    {
+        double _x[g_Lanes];
+        _mm256_storeu_pd(_x, x);
+        for (size_t i = 0; i < g_Lanes; ++i)
+        {
+            _x[i] = factor * log10(_x[i]);
+        }
+        return _mm256_loadu_pd(_x);
+    }
+    // x = m 2^e, m in [0.5, 1). The exponent is converted to double by
+    // putting it into the mantissa of 2^52.
+    const __m256i bits = _mm256_castpd_si256(x);
+    const __m128i lower = _mm_srli_epi64(_mm256_castsi256_si128(bits), 52);
+    const __m128i upper = _mm_srli_epi64(_mm256_extractf128_si256(bits, 1), 52);
+    const __m256d magic = Set(4503599627370496.0);
+    __m256d e = _mm256_or_pd(_mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(lower), upper, 1)), magic);
+    e = _mm256_sub_pd(e, Set(4503599627370496.0 + 1022));
+    const __m256d mantissa = _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+    __m256d m = _mm256_or_pd(_mm256_and_pd(x, mantissa), Set(0.5));
+    // m in [sqrt(1/2), sqrt(2)) and m - 1 as the argument.
+    const __m256d isSmall = _mm256_cmp_pd(m, Set(M_SQRT1_2), _CMP_LT_OQ);
+    e = _mm256_sub_pd(e, _mm256_and_pd(isSmall, Set(1.0)));
+    m = _mm256_sub_pd(_mm256_add_pd(m, _mm256_and_pd(isSmall, m)), Set(1.0));
+    const __m256d z = _mm256_mul_pd(m, m);
+    __m256d y = _mm256_div_pd(_mm256_mul_pd(m, _mm256_mul_pd(z, Polynomial(m, g_LogP, 6, false))), Polynomial(m, g_LogQ, 5, true));
+    // log(2) = 0.693359375 - 2.121944400546905827679e-4 in two parts.
+    y = _mm256_sub_pd(y, _mm256_mul_pd(e, Set(2.121944400546905827679e-4)));
+    y = _mm256_sub_pd(y, _mm256_mul_pd(z, Set(0.5)));
+    y = _mm256_add_pd(_mm256_add_pd(m, y), _mm256_mul_pd(e, Set(0.693359375)));
+    return _mm256_mul_pd(y, Set(factor * M_LOG10E));
+}
+
+// g_Lanes bins at any alignment.
+inline void ConvertLanes(double magnitude[], double phase[], const double real[], const double imag[], const masp::spectrum::PolarFormat& format, bool isAccumulated)
+{
+    const __m256d re = _mm256_loadu_pd(real);
+    const __m256d im = _mm256_loadu_pd(imag);
+    if ( NULL != magnitude )
+    {
+        __m256d m = _mm256_add_pd(_mm256_mul_pd(re, re), _mm256_mul_pd(im, im));
+        if ( false == format.isPower )
+        {
+            m = _mm256_sqrt_pd(m);
+        }
+        m = _mm256_mul_pd(m, Set(format.scale));
+        if ( 0.0 != format.decibel )
+        {
+            m = Decibel(m, format.decibel);
+        }
+        if ( isAccumulated )
+        {
+            m = _mm256_add_pd(m, _mm256_loadu_pd(magnitude));
+        }
+        _mm256_storeu_pd(magnitude, m);
+    }
+    if ( NULL != phase )
+    {
+        __m256d p = Atan2(im, re);
+        if ( format.isDegree )
+        {
+            p = _mm256_mul_pd(p, Set(180.0 / M_PI));
+        }
+        if ( isAccumulated )
+        {
+            p = _mm256_add_pd(p, _mm256_loadu_pd(phase));
+        }
+        _mm256_storeu_pd(phase, p);
+    }
+}
+
+inline void ApplyLanes(double magnitude[], double phase[], const masp::spectrum::PolarFormat& format)
+{
+    if ( NULL != magnitude )
+    {
+        __m256d m = _mm256_mul_pd(_mm256_loadu_pd(magnitude), Set(format.scale));
+        if ( 0.0 != format.decibel )
+        {
+            m = Decibel(m, format.decibel);
+        }
+        _mm256_storeu_pd(magnitude, m);
+    }
+    if ( NULL != phase && format.isDegree )
+    {
+        _mm256_storeu_pd(phase, _mm256_mul_pd(_mm256_loadu_pd(phase), Set(180.0 / M_PI)));
+    }
+}
+
+// Copies n < g_Lanes elements of src into dst, padded by 1 which keeps
+// the lanes out of the fallbacks, or back.
+inline double* Pad(double dst[], const double src[], size_t n)
+{
+    if ( NULL == src )
+    {
+        return NULL;
+    }
+    for (size_t i = 0; i < g_Lanes; ++i)
+    {
+        dst[i] = i < n ? src[i] : 1.0;
+    }
+    return dst;
+}
+
+inline void Unpad(double dst[], const double src[], size_t n)
+{
+    for (size_t i = 0; NULL != dst && i < n; ++i)
+    {
+        dst[i] = src[i];
+    }
+}
+
+} // anonymous namespace
+
+namespace masp {
+namespace spectrum {
+
+status_t ConvertToPolar(double magnitude[], double phase[], const double real[], const double imag[], size_t count, const PolarFormat& format, bool isAccumulated)
+{
+    if ( (NULL == magnitude && NULL == phase) || NULL == real || NULL == imag )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    size_t k = 0;
+    for ( ; k + g_Lanes <= count; k += g_Lanes)
+    {
+        ConvertLanes(NULL != magnitude ? magnitude + k : NULL, NULL != phase ? phase + k : NULL, real + k, imag + k, format, isAccumulated);
+    }
+    // The rest by the same lanes, so that every bin is computed alike.
+    if ( k < count )
+    {
+        const size_t n = count - k;
+        double _magnitude[g_Lanes], _phase[g_Lanes], _real[g_Lanes], _imag[g_Lanes];
+        double* m = Pad(_magnitude, NULL != magnitude ? magnitude + k : NULL, n);
+        double* p = Pad(_phase, NULL != phase ? phase + k : NULL, n);
+        ConvertLanes(m, p, Pad(_real, real + k, n), Pad(_imag, imag + k, n), format, isAccumulated);
+        Unpad(NULL != magnitude ? magnitude + k : NULL, _magnitude, n);
+        Unpad(NULL != phase ? phase + k : NULL, _phase, n);
+    }
+    return NO_ERROR;
+}
+
+status_t ApplyPolarFormat(double magnitude[], double phase[], size_t count, const PolarFormat& format)
+{
+    if ( NULL == magnitude && NULL == phase )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    size_t k = 0;
+    for ( ; k + g_Lanes <= count; k += g_Lanes)
+    {
+        ApplyLanes(NULL != magnitude ? magnitude + k : NULL, NULL != phase ? phase + k : NULL, format);
+    }
+    if ( k < count )
+    {
+        const size_t n = count - k;
+        double _magnitude[g_Lanes], _phase[g_Lanes];
+        ApplyLanes(Pad(_magnitude, NULL != magnitude ? magnitude + k : NULL, n), Pad(_phase, NULL != phase ? phase + k : NULL, n), format);
+        Unpad(NULL != magnitude ? magnitude + k : NULL, _magnitude, n);
+        Unpad(NULL != phase ? phase + k : NULL, _phase, n);
+    }
+    return NO_ERROR;
+}
+
+} // namespace spectrum {
+} // namespace masp {
@@ -0,0 +1,161 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "types.h"
+#include "status.h"
+#include "debug.h"
+#include "masp/Stft.h"
+
+namespace masp {
+namespace spectrum {
+
+Stft::Stft(const mcon::Vector<double>& window, size_t hop, bool isFullLayout)
+    : m_Window(window)
+    , m_Hop(hop)
+    , m_IsFullLayout(isFullLayout)
+    , m_RealPlan(0 == hop || 1 == window.GetLength() % 2 ? 0 : window.GetLength())
+    , m_Plan(0 == hop || 0 == window.GetLength() % 2 ? 0 : window.GetLength())
+    , m_Ring(window.GetLength())
+    , m_Position(0)
+    , m_Remaining(0)
+    , m_FrameCount(0)
+    , m_Frame(window.GetLength())
+    , m_Real(window.GetLength())
+    , m_Imag(window.GetLength())
+    , m_Work(std::max(m_RealPlan.GetWorkLength(), m_Plan.GetWorkLength()))
+{
+    Reset();
+}
+
+Stft::~Stft()
+{
+}
+
+void Stft::Reset(size_t paddingLength)
+{
+    const size_t N = GetLength();
+    ASSERT(paddingLength < N || 0 == N);
+    m_Ring = 0;
+    m_Position = 0;
+    m_FrameCount = 0;
+    m_Remaining = N;
+    if ( 0 < N )
+    {
+        m_Remaining -= std::min(paddingLength, N - 1);
+    }
+}
+
+bool Stft::Next(const double*& samples, size_t& count)
+{
+    const size_t N = GetLength();
+    if ( IsNull() )
+    {
+        return false;
+    }
+    double* ring = m_Ring;
+    while ( 0 < count )
+    {
+        // Up to the next frame and to the end of the ring.
+        const size_t length = std::min(std::min(count, m_Remaining), N - m_Position);
+        if ( NULL == samples )
+        {
+            memset(ring + m_Position, 0, length * sizeof(double));
+        }
+        else
+        {
+            memcpy(ring + m_Position, samples, length * sizeof(double));
+            samples += length;
+        }
+        count -= length;
+        m_Position = (m_Position + length) % N;
+        m_Remaining -= length;
+        if ( 0 == m_Remaining )
+        {
+            Transform();
+            m_Remaining = m_Hop;
+            ++m_FrameCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t Stft::Process(const double samples[], size_t count, Callback callback, void* context)
+{
+    size_t frames = 0;
+    while ( Next(samples, count) )
+    {
+        if ( NULL != callback )
+        {
+            callback(m_Real, m_Imag, m_FrameCount - 1, context);
+        }
+        ++frames;
+    }
+    return frames;
+}
+
+void Stft::Transform(void)
+{
+    const size_t N = GetLength();
+    const double* ring = m_Ring;
+    const double* window = m_Window;
+    double* frame = m_Frame;
+    double* real = m_Real;
+    double* imag = m_Imag;
+    // From the oldest sample.
+    const size_t head = N - m_Position;
+    for (size_t i = 0; i < head; ++i)
+    {
+        frame[i] = ring[m_Position + i] * window[i];
+    }
+    for (size_t i = head; i < N; ++i)
+    {
+        frame[i] = ring[i - head] * window[i];
+    }
+    if ( false == m_RealPlan.IsNull() )
+    {
+        m_RealPlan.Forward(real, imag, frame, m_Work);
+        if ( m_IsFullLayout )
+        {
+            for (size_t k = 1; k < N / 2; ++k)
+            {
+                real[N - k] = real[k];
+                imag[N - k] = - imag[k];
+            }
+        }
+    }
+    else
+    {
+        memcpy(real, frame, N * sizeof(double));
+        memset(imag, 0, N * sizeof(double));
+        m_Plan.Execute(real, imag, m_Work);
+    }
+}
+
+} // namespace spectrum {
+} // namespace masp {
@@ -0,0 +1,219 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "types.h"
+#include "status.h"
+#include "debug.h"
+#include "masp/Spectrum.h"
+#include "masp/Welch.h"
+
+namespace {
+
+// The blocks of the segments, each summed by a thread.
+const size_t g_MaxBlockCount = 64;
+const size_t g_MinBlockLength = 16;
+// Segments x L, above which the threads are used by default.
+const size_t g_WelchParallelThreshold = 256 * 1024;
+
+// The length of the plans of the even L when isEven or of the odd L
+// otherwise, 0 for the others.
+size_t GetPlanLength(size_t L, size_t overlap, bool isEven, bool isUsed)
+{
+    return overlap >= L || (0 == L % 2) != isEven || false == isUsed ? 0 : L;
+}
+
+template <typename Type>
+struct Segments
+{
+    const double* window;
+    size_t length;
+    const masp::ft::BasicRealFftPlan<Type>* pRealPlan;
+    const masp::ft::BasicFftPlan<Type>* pPlan;
+    const double* samples;
+    size_t hop;
+    size_t count;
+    size_t blockLength;
+    // The sums of |X|^2 of the bins [0, L/2] of the blocks.
+    mcon::Matrix<double>* pSums;
+};
+
+inline void AddPower(double sum[], const double real[], const double imag[], size_t count)
+{
+    masp::spectrum::PolarFormat power;
+    power.isPower = true;
+    masp::spectrum::ConvertToPolar(sum, NULL, real, imag, count, power, true);
+}
+
+inline void AddPower(double sum[], const float real[], const float imag[], size_t count)
+{
+    for (size_t k = 0; k < count; ++k)
+    {
+        const double re = real[k];
+        const double im = imag[k];
+        sum[k] += re * re + im * im;
+    }
+}
+
+template <typename Type>
+void SumBlocks(const Segments<Type>& segments, size_t begin, size_t end)
+{
+    const size_t L = segments.length;
+    const size_t binCount = L / 2 + 1;
+    const masp::ft::BasicRealFftPlan<Type>& realPlan = *segments.pRealPlan;
+    const masp::ft::BasicFftPlan<Type>& plan = *segments.pPlan;
+    const size_t workLength = std::max(realPlan.GetWorkLength(), plan.GetWorkLength());
+    Type* frame = new Type[3 * L + workLength];
+    Type* real = frame + L;
+    Type* imag = real + L;
+    Type* work = 0 < workLength ? imag + L : NULL;
+    for (size_t b = begin; b < end; ++b)
+    {
+        double* sum = (*segments.pSums)[b];
+        memset(sum, 0, binCount * sizeof(double));
+        const size_t last = std::min(segments.count, (b + 1) * segments.blockLength);
+        for (size_t s = b * segments.blockLength; s < last; ++s)
+        {
+            const double* x = segments.samples + s * segments.hop;
+            for (size_t i = 0; i < L; ++i)
+            {
+                frame[i] = static_cast<Type>(x[i] * segments.window[i]);
+            }
+            if ( false == realPlan.IsNull() )
+            {
+                realPlan.Forward(real, imag, frame, work);
+            }
+            else
+            {
+                memcpy(real, frame, L * sizeof(Type));
+                memset(imag, 0, L * sizeof(Type));
+                plan.Execute(real, imag, work);
+            }
+            AddPower(sum, real, imag, binCount);
+        }
+    }
+    delete[] frame;
+}
+
+} // anonymous namespace
+
+namespace masp {
+namespace spectrum {
+
+Welch::Welch(const mcon::Vector<double>& window, size_t overlap, Scaling scaling, bool isOneSided, Precision precision)
+    : m_Window(window)
+    , m_Overlap(overlap)
+    , m_Scaling(scaling)
+    , m_IsOneSided(isOneSided)
+    , m_Precision(precision)
+    , m_RealPlan(GetPlanLength(window.GetLength(), overlap, true, Precision_Double == precision))
+    , m_Plan(GetPlanLength(window.GetLength(), overlap, false, Precision_Double == precision))
+    , m_RealPlanf(GetPlanLength(window.GetLength(), overlap, true, Precision_Single == precision))
+    , m_Planf(GetPlanLength(window.GetLength(), overlap, false, Precision_Single == precision))
+{
+}
+
+Welch::~Welch()
+{
+}
+
+status_t Welch::Estimate(mcon::Vector<double>& spectrum, const double samples[], size_t count, double samplingRate, size_t threadCount) const
+{
+    const size_t segmentCount = GetSegmentCount(count);
+    if ( 0 == segmentCount || NULL == samples || samplingRate <= 0 )
+    {
+        return -ERROR_ILLEGAL;
+    }
+    const size_t L = GetLength();
+    const size_t binCount = L / 2 + 1;
+    const size_t blockLength = std::max(g_MinBlockLength, (segmentCount + g_MaxBlockCount - 1) / g_MaxBlockCount);
+    const size_t blockCount = (segmentCount + blockLength - 1) / blockLength;
+    mcon::Matrix<double> sums(blockCount, binCount);
+    if ( false == spectrum.Resize(GetBinCount()) || sums.IsNull() )
+    {
+        return -ERROR_CANNOT_ALLOCATE_MEMORY;
+    }
+    // The blocks are shared by the threads, each taking a contiguous range.
+    threadCount = mcon::GetThreadCount(threadCount, segmentCount * L, g_WelchParallelThreshold);
+    if ( Precision_Single == m_Precision )
+    {
+        const Segments<float> segments =
+        {
+            m_Window, L, &m_RealPlanf, &m_Planf, samples, GetHop(), segmentCount, blockLength, &sums
+        };
+        mcon::ForRanges(SumBlocks<float>, segments, blockCount, threadCount);
+    }
+    else
+    {
+        const Segments<double> segments =
+        {
+            m_Window, L, &m_RealPlan, &m_Plan, samples, GetHop(), segmentCount, blockLength, &sums
+        };
+        mcon::ForRanges(SumBlocks<double>, segments, blockCount, threadCount);
+    }
+
+    mcon::Vector<double> power(sums[0]);
+    for (size_t b = 1; b < blockCount; ++b)
+    {
+        power += sums[b];
+    }
+    const double windowSum = m_Window.GetSum();
+    double scale = 1.0 / (windowSum * windowSum);
+    if ( Scaling_Density == m_Scaling )
+    {
+        scale = 1.0 / (samplingRate * m_Window.GetDotProduct(m_Window));
+    }
+    power *= scale / segmentCount;
+    for (size_t k = 0; k < binCount; ++k)
+    {
+        double p = power[k];
+        if ( m_IsOneSided && 0 < k && 2 * k != L )
+        {
+            p *= 2;
+        }
+        if ( Scaling_Amplitude == m_Scaling )
+        {
+            p = sqrt(p);
+        }
+        spectrum[k] = p;
+        // X[L - k] = conj(X[k]) for the two-sided.
+        if ( false == m_IsOneSided && 0 < k )
+        {
+            spectrum[L - k] = p;
+        }
+    }
+    return NO_ERROR;
+}
+
+status_t Welch::Estimate(mcon::Vector<double>& spectrum, const mcon::VectordBase& signal, double samplingRate, size_t threadCount) const
+{
+    return Estimate(spectrum, signal, signal.GetLength(), samplingRate, threadCount);
+}
+
+} // namespace spectrum {
+} // namespace masp {
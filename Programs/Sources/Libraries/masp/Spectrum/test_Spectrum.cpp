@@ -0,0 +1,562 @@
+
+#include <stdio.h>
+#include <math.h>
+
+#include <algorithm>
+
+#include "status.h"
+#include "debug.h"
+#include "masp.h"
+
+namespace {
+
+struct Frames
+{
+    mcon::Matrix<double>* pFrames;
+    size_t binCount;
+    size_t count;
+};
+
+void StoreFrame(const double real[], const double imag[], size_t frameIndex, void* context)
+{
+    Frames* frames = reinterpret_cast<Frames*>(context);
+    mcon::Matrix<double>& m = *frames->pFrames;
+    if ( frameIndex != frames->count || 2 * frameIndex + 1 >= m.GetRowLength() )
+    {
+        return;
+    }
+    for (size_t k = 0; k < frames->binCount; ++k)
+    {
+        m[2 * frameIndex + 0][k] = real[k];
+        m[2 * frameIndex + 1][k] = imag[k];
+    }
+    ++frames->count;
+}
+
+// The spectrum of the frame from start, where the samples out of the
+// signal are zeros.
+void GetExpected(mcon::Matrix<double>& expected, const mcon::Vector<double>& signal, const mcon::Vector<double>& window, int start)
+{
+    const int N = window.GetLength();
+    mcon::Vector<double> part(N);
+    for (int i = 0; i < N; ++i)
+    {
+        const int n = start + i;
+        part[i] = (0 <= n && n < static_cast<int>(signal.GetLength()) ? signal[n] : 0.0) * window[i];
+    }
+    masp::ft::Fft(expected, part);
+}
+
+// X(k) = sum_n x[n] e^(-j 2 pi k n / N) of the count samples from start,
+// where the samples before the signal are zeros.
+void GetDft(double& real, double& imag, const mcon::Vector<double>& signal, int start, size_t count, double k, size_t N)
+{
+    real = imag = 0;
+    for (size_t n = 0; n < count; ++n)
+    {
+        const int m = start + static_cast<int>(n);
+        const double x = 0 <= m ? signal[m] : 0.0;
+        const double w = -2 * M_PI * fmod(k * n, static_cast<double>(N)) / N;
+        real += x * cos(w);
+        imag += x * sin(w);
+    }
+}
+
+struct Tracking
+{
+    const mcon::Vector<double>* pSignal;
+    const size_t* bins;
+    size_t binCount;
+    size_t length;
+    size_t count;
+    double err;
+};
+
+void CheckBins(const double real[], const double imag[], size_t sampleIndex, void* context)
+{
+    Tracking* tracking = reinterpret_cast<Tracking*>(context);
+    if ( sampleIndex != tracking->count++ || 0 != sampleIndex % 7 )
+    {
+        return;
+    }
+    for (size_t i = 0; i < tracking->binCount; ++i)
+    {
+        double er, ei;
+        GetDft(er, ei, *tracking->pSignal, static_cast<int>(sampleIndex + 1 - tracking->length), tracking->length, tracking->bins[i], tracking->length);
+        tracking->err = std::max(tracking->err, fabs(real[i] - er) + fabs(imag[i] - ei));
+    }
+}
+
+}
+
+static void test_stft(void)
+{
+    LOG("* [Stft]\n");
+    {
+        const mcon::Vector<double> window0(0);
+        const masp::spectrum::Stft stft0(window0, 4);
+        CHECK_VALUE(stft0.IsNull(), true);
+        mcon::Vector<double> window(8);
+        masp::window::Hanning(window);
+        masp::spectrum::Stft stft(window, 0);
+        CHECK_VALUE(stft.IsNull(), true);
+        const double* samples = window;
+        size_t count = window.GetLength();
+        CHECK_VALUE(stft.Next(samples, count), false);
+    }
+    const int L = 1000;
+    mcon::Vector<double> signal(L);
+    for (int i = 0; i < L; ++i)
+    {
+        signal[i] = sin(0.05 * i) + 0.3 * sin(0.71 * i * i / L);
+    }
+    // Even and odd lengths, hops shorter than, equal to and longer than N,
+    // with and without the padding at the head.
+    const int lengths[] = {64, 63};
+    const int hops[] = {16, 21, 64, 100};
+    // Irregular blocks.
+    const int blocks[] = {1, 7, 33, 130, 5, 256};
+    for (unsigned int i = 0; i < sizeof(lengths)/sizeof(int); ++i)
+    {
+        const int N = lengths[i];
+        mcon::Vector<double> window(N);
+        masp::window::Hanning(window);
+        for (unsigned int j = 0; j < sizeof(hops)/sizeof(int); ++j)
+        {
+            const int hop = hops[j];
+            for (int padding = 0; padding < N; padding += N / 2)
+            {
+                LOG("    N=%d, hop=%d, padding=%d\n", N, hop, padding);
+                masp::spectrum::Stft stft(window, hop, true);
+                CHECK_VALUE(stft.GetBinCount(), N);
+                stft.Reset(padding);
+                const int frameCount = (L + padding - N) / hop + 1;
+                mcon::Matrix<double> spectra(2 * frameCount, N);
+                Frames frames = {&spectra, stft.GetBinCount(), 0};
+                size_t total = 0;
+                for (int ofs = 0, b = 0; ofs < L; ++b)
+                {
+                    const int count = std::min(L - ofs, blocks[b % (sizeof(blocks)/sizeof(int))]);
+                    total += stft.Process(&signal[ofs], count, StoreFrame, &frames);
+                    ofs += count;
+                }
+                CHECK_VALUE(total, frameCount);
+                CHECK_VALUE(stft.GetFrameCount(), frameCount);
+                CHECK_VALUE(frames.count, frameCount);
+
+                double err = 0;
+                mcon::Matrix<double> expected;
+                for (int f = 0; f < frameCount; ++f)
+                {
+                    GetExpected(expected, signal, window, f * hop - padding);
+                    for (int k = 0; k < N; ++k)
+                    {
+                        err = std::max(err, fabs(expected[0][k] - spectra[2 * f][k]) + fabs(expected[1][k] - spectra[2 * f + 1][k]));
+                    }
+                }
+                CHECK_VALUE(err, 0);
+            }
+        }
+    }
+    // The bins [0, N/2] by Next(), with the zeros at the end.
+    {
+        const int N = 64;
+        const int hop = N / 2;
+        mcon::Vector<double> window(N);
+        masp::window::Hamming(window);
+        masp::spectrum::Stft stft(window, hop);
+        CHECK_VALUE(stft.GetBinCount(), N / 2 + 1);
+        stft.Reset(N / 2);
+        const double* samples = signal;
+        size_t count = L;
+        const double* zeros = NULL;
+        size_t zeroCount = N / 2;
+        double err = 0;
+        int f = 0;
+        mcon::Matrix<double> expected;
+        for ( ; stft.Next(samples, count) || stft.Next(zeros, zeroCount); ++f)
+        {
+            GetExpected(expected, signal, window, f * hop - N / 2);
+            for (int k = 0; k <= N / 2; ++k)
+            {
+                err = std::max(err, fabs(expected[0][k] - stft.GetReal()[k]) + fabs(expected[1][k] - stft.GetImag()[k]));
+            }
+        }
+        CHECK_VALUE(count, 0);
+        CHECK_VALUE(zeroCount, 0);
+        CHECK_VALUE(f, (L + N / 2) / hop);
+        CHECK_VALUE(err, 0);
+    }
+}
+
+static void test_polar(void)
+{
+    LOG("* [ConvertToPolar]\n");
+    const size_t L = 1003;
+    // Offset by 1 from the alignment of the vectors.
+    mcon::Vector<double> _real(L + 1), _imag(L + 1), _magnitude(L + 1), _phase(L + 1);
+    double* real = _real;
+    double* imag = _imag;
+    double* magnitude = _magnitude;
+    double* phase = _phase;
+    ++real, ++imag, ++magnitude, ++phase;
+    for (size_t k = 0; k < L; ++k)
+    {
+        // All the quadrants and the axes over the magnitudes of 1e-20 to 1e+19.
+        const double r = pow(10.0, static_cast<int>(k % 40) - 20);
+        const double theta = 0.37 * k;
+        real[k] = k % 7 == 3 ? 0.0 : r * cos(theta);
+        imag[k] = k % 11 == 5 ? 0.0 : r * sin(theta);
+    }
+    real[0] = imag[0] = 0.0;
+    real[1] = -1.0, imag[1] = 0.0;
+    real[2] = 0.0, imag[2] = -2.0;
+    real[3] = -3.0, imag[3] = -3.0;
+
+    CHECK_VALUE(masp::spectrum::ConvertToPolar(NULL, NULL, real, imag, L), -ERROR_ILLEGAL);
+    CHECK_VALUE(masp::spectrum::ConvertToPolar(magnitude, phase, NULL, imag, L), -ERROR_ILLEGAL);
+    CHECK_VALUE(masp::spectrum::ApplyPolarFormat(NULL, NULL, L, masp::spectrum::PolarFormat()), -ERROR_ILLEGAL);
+    {
+        CHECK_VALUE(masp::spectrum::ConvertToPolar(magnitude, phase, real, imag, L), NO_ERROR);
+        double errMagnitude = 0, errPhase = 0;
+        for (size_t k = 0; k < L; ++k)
+        {
+            const double m = sqrt(real[k] * real[k] + imag[k] * imag[k]);
+            errMagnitude = std::max(errMagnitude, fabs(magnitude[k] - m) / std::max(m, 1e-300));
+            errPhase = std::max(errPhase, fabs(phase[k] - atan2(imag[k], real[k])));
+        }
+        CHECK_VALUE(errMagnitude < 1e-15, true);
+        CHECK_VALUE(errPhase < 1e-15, true);
+        CHECK_VALUE(phase[0], 0.0);
+        CHECK_VALUE(phase[1], M_PI);
+        CHECK_VALUE(phase[2], -M_PI / 2);
+        CHECK_VALUE(phase[3], -M_PI * 3 / 4);
+        CHECK_VALUE(magnitude[3], 3.0 * sqrt(2.0));
+
+        // Accumulated onto the first ones.
+        // CHECK_VALUE() evaluates the call more than once.
+        const status_t status = masp::spectrum::ConvertToPolar(magnitude, phase, real, imag, L, masp::spectrum::PolarFormat(), true);
+        CHECK_VALUE(status, NO_ERROR);
+        errMagnitude = errPhase = 0;
+        for (size_t k = 0; k < L; ++k)
+        {
+            const double m = sqrt(real[k] * real[k] + imag[k] * imag[k]);
+            errMagnitude = std::max(errMagnitude, fabs(magnitude[k] - 2 * m) / std::max(m, 1e-300));
+            errPhase = std::max(errPhase, fabs(phase[k] - 2 * atan2(imag[k], real[k])));
+        }
+        CHECK_VALUE(errMagnitude < 1e-15, true);
+        CHECK_VALUE(errPhase < 1e-14, true);
+    }
+    {
+        // Power in decibels and degrees, and magnitude only.
+        masp::spectrum::PolarFormat format;
+        format.isPower = true;
+        format.scale = 0.25;
+        format.decibel = 10.0;
+        format.isDegree = true;
+        CHECK_VALUE(masp::spectrum::ConvertToPolar(magnitude, phase, real, imag, L, format), NO_ERROR);
+        double errMagnitude = 0, errPhase = 0;
+        for (size_t k = 1; k < L; ++k)
+        {
+            const double m = 10.0 * log10(0.25 * (real[k] * real[k] + imag[k] * imag[k]));
+            errMagnitude = std::max(errMagnitude, fabs(magnitude[k] - m) / std::max(fabs(m), 1.0));
+            errPhase = std::max(errPhase, fabs(phase[k] - atan2(imag[k], real[k]) * 180.0 / M_PI));
+        }
+        CHECK_VALUE(errMagnitude < 1e-14, true);
+        CHECK_VALUE(errPhase < 1e-12, true);
+        CHECK_VALUE(isinf(magnitude[0]) && magnitude[0] < 0, true);
+        CHECK_VALUE(phase[1], 180.0);
+
+        phase[L - 1] = 7.0;
+        format.isPower = false;
+        format.decibel = 20.0;
+        CHECK_VALUE(masp::spectrum::ConvertToPolar(magnitude, NULL, real, imag, L, format), NO_ERROR);
+        CHECK_VALUE(phase[L - 1], 7.0);
+        CHECK_VALUE(magnitude[3], 20.0 * log10(0.25 * 3.0 * sqrt(2.0)));
+    }
+    {
+        // The sums converted afterwards, as ConvertToPolar() with the format.
+        masp::spectrum::PolarFormat format;
+        format.scale = 1.0 / 3.0;
+        format.decibel = 20.0;
+        format.isDegree = true;
+        mcon::Vector<double> expectedMagnitude(L), expectedPhase(L);
+        masp::spectrum::ConvertToPolar(expectedMagnitude, expectedPhase, real, imag, L, format);
+        masp::spectrum::ConvertToPolar(magnitude, phase, real, imag, L);
+        const status_t status = masp::spectrum::ApplyPolarFormat(magnitude, phase, L, format);
+        CHECK_VALUE(status, NO_ERROR);
+        double err = 0;
+        for (size_t k = 1; k < L; ++k)
+        {
+            err = std::max(err, fabs(magnitude[k] - expectedMagnitude[k]) + fabs(phase[k] - expectedPhase[k]));
+        }
+        CHECK_VALUE(err < 1e-12, true);
+    }
+}
+
+static void test_welch(void)
+{
+    LOG("* [Welch]\n");
+    const size_t S = 20000;
+    mcon::Vector<double> signal(S);
+    for (size_t n = 0; n < S; ++n)
+    {
+        // A sinusoid on the bin 5 of 64 and the others off the bins.
+        signal[n] = 3.0 * cos(2 * M_PI * 5 * n / 64) + 0.5 * sin(0.9 * n) + 0.25 * cos(1.3 * n * n / S);
+    }
+    mcon::Vector<double> spectrum;
+    {
+        const mcon::Vector<double> window0(0);
+        mcon::Vector<double> window(64);
+        masp::window::Rectangular(window);
+        const masp::spectrum::Welch welch0(window0, 0);
+        const masp::spectrum::Welch welch1(window, 64);
+        const masp::spectrum::Welch welch(window, 32);
+        CHECK_VALUE(welch0.IsNull(), true);
+        CHECK_VALUE(welch1.IsNull(), true);
+        CHECK_VALUE(welch.GetHop(), 32);
+        CHECK_VALUE(welch.GetBinCount(), 33);
+        CHECK_VALUE(welch.GetSegmentCount(63), 0);
+        CHECK_VALUE(welch.GetSegmentCount(127), 2);
+        CHECK_VALUE(welch.GetSegmentCount(128), 3);
+        CHECK_VALUE(welch0.Estimate(spectrum, signal), -ERROR_ILLEGAL);
+        CHECK_VALUE(welch1.Estimate(spectrum, signal), -ERROR_ILLEGAL);
+        CHECK_VALUE(welch.Estimate(spectrum, &signal[0], 63, 1.0, 0), -ERROR_ILLEGAL);
+        CHECK_VALUE(welch.Estimate(spectrum, NULL, S, 1.0, 0), -ERROR_ILLEGAL);
+        CHECK_VALUE(welch.Estimate(spectrum, signal, 0.0), -ERROR_ILLEGAL);
+    }
+    {
+        // A * cos on a bin is A^2 / 4 on each side, and A / sqrt(2) as
+        // the one-sided amplitude.
+        mcon::Vector<double> window(64);
+        masp::window::Rectangular(window);
+        const masp::spectrum::Welch power(window, 0, masp::spectrum::Welch::Scaling_Power, false);
+        const masp::spectrum::Welch amplitude(window, 0, masp::spectrum::Welch::Scaling_Amplitude);
+        mcon::Vector<double> tone(64 * 10);
+        for (size_t n = 0; n < tone.GetLength(); ++n)
+        {
+            tone[n] = 3.0 * cos(2 * M_PI * 5 * n / 64);
+        }
+        CHECK_VALUE(power.Estimate(spectrum, tone), NO_ERROR);
+        CHECK_VALUE(spectrum.GetLength(), 64);
+        CHECK_VALUE(spectrum[5], 9.0 / 4);
+        CHECK_VALUE(spectrum[59], 9.0 / 4);
+        CHECK_VALUE(spectrum[6], 0.0);
+        CHECK_VALUE(amplitude.Estimate(spectrum, tone), NO_ERROR);
+        CHECK_VALUE(spectrum.GetLength(), 33);
+        CHECK_VALUE(spectrum[5], 3.0 / sqrt(2.0));
+
+        // The two-sided density sums up to the mean square with the
+        // rectangular window (Parseval).
+        const double fs = 8000.0;
+        const masp::spectrum::Welch density(window, 16, masp::spectrum::Welch::Scaling_Density, false);
+        CHECK_VALUE(density.Estimate(spectrum, signal, fs), NO_ERROR);
+        const size_t segmentCount = density.GetSegmentCount(S);
+        double meanSquare = 0;
+        for (size_t s = 0; s < segmentCount; ++s)
+        {
+            for (size_t i = 0; i < 64; ++i)
+            {
+                meanSquare += signal[s * 48 + i] * signal[s * 48 + i];
+            }
+        }
+        meanSquare /= segmentCount * 64;
+        CHECK_VALUE(spectrum.GetSum() * fs / 64, meanSquare);
+    }
+    const size_t lengths[] = {64, 45, 100};
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i)
+    {
+        // Against the FFT of each segment.
+        const size_t L = lengths[i];
+        const size_t overlap = L / 3;
+        const double fs = 48000.0;
+        mcon::Vector<double> window(L);
+        masp::window::Hanning(window);
+        const masp::spectrum::Welch welch(window, overlap);
+        const size_t segmentCount = welch.GetSegmentCount(S);
+        mcon::Vector<double> expected(L / 2 + 1);
+        expected = 0;
+        mcon::Vector<double> part(L);
+        mcon::Matrix<double> complex;
+        for (size_t s = 0; s < segmentCount; ++s)
+        {
+            for (size_t n = 0; n < L; ++n)
+            {
+                part[n] = signal[s * (L - overlap) + n] * window[n];
+            }
+            masp::ft::Fft(complex, part);
+            for (size_t k = 0; k <= L / 2; ++k)
+            {
+                expected[k] += (complex[0][k] * complex[0][k] + complex[1][k] * complex[1][k]) * (0 < k && 2 * k != L ? 2 : 1);
+            }
+        }
+        expected *= 1.0 / (segmentCount * fs * window.GetDotProduct(window));
+        CHECK_VALUE(welch.Estimate(spectrum, signal, fs, 1), NO_ERROR);
+        double err = 0;
+        for (size_t k = 0; k <= L / 2; ++k)
+        {
+            err = std::max(err, fabs(spectrum[k] - expected[k]) / expected.GetMaximumAbsolute());
+        }
+        LOG("    L=%d, segments=%d\n", static_cast<int>(L), static_cast<int>(segmentCount));
+        CHECK_VALUE(err < 1e-12, true);
+
+        // The FFT of float, relative to the peak.
+        const masp::spectrum::Welch single(window, overlap, masp::spectrum::Welch::Scaling_Density, true, masp::spectrum::Welch::Precision_Single);
+        CHECK_VALUE(single.GetPrecision(), masp::spectrum::Welch::Precision_Single);
+        CHECK_VALUE(single.IsNull(), false);
+        CHECK_VALUE(single.Estimate(spectrum, signal, fs, 2), NO_ERROR);
+        err = 0;
+        for (size_t k = 0; k <= L / 2; ++k)
+        {
+            err = std::max(err, fabs(spectrum[k] - expected[k]) / expected.GetMaximumAbsolute());
+        }
+        LOG("    single: err=%g\n", err);
+        CHECK_VALUE(err < 1e-6, true);
+    }
+    {
+        // Identical for any number of the threads.
+        const size_t L = 16;
+        mcon::Vector<double> window(L);
+        masp::window::Blackman(window);
+        const masp::spectrum::Welch welch(window, 12, masp::spectrum::Welch::Scaling_Power, false);
+        mcon::Vector<double> serial;
+        welch.Estimate(serial, signal, 1.0, 1);
+        const size_t threadCounts[] = {0, 2, 3, 8, 100};
+        for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); ++t)
+        {
+            welch.Estimate(spectrum, signal, 1.0, threadCounts[t]);
+            double err = 0;
+            for (size_t k = 0; k < L; ++k)
+            {
+                err = std::max(err, fabs(spectrum[k] - serial[k]));
+            }
+            LOG("    threads=%d\n", static_cast<int>(threadCounts[t]));
+            CHECK_VALUE(err, 0);
+        }
+    }
+}
+
+static void test_goertzel(void)
+{
+    LOG("* [Goertzel]\n");
+    const size_t S = 1000;
+    mcon::Vector<double> signal(S);
+    for (size_t n = 0; n < S; ++n)
+    {
+        signal[n] = sin(0.05 * n) + 0.3 * cos(2.1 * n + 0.5) + 0.1 * ((n * 7919) % 13);
+    }
+    {
+        const double bins[] = {1.0};
+        const masp::spectrum::Goertzel goertzel0(bins, 1, 0);
+        const masp::spectrum::Goertzel goertzel1(bins, 0, 100);
+        CHECK_VALUE(goertzel0.IsNull(), true);
+        CHECK_VALUE(goertzel1.IsNull(), true);
+    }
+    const double bins[] = {0.0, 1.0, 5.5, 17.0, 250.25, 499.0, 500.0};
+    const size_t K = sizeof(bins) / sizeof(bins[0]);
+    masp::spectrum::Goertzel goertzel(bins, K, S);
+    CHECK_VALUE(goertzel.GetBinCount(), K);
+    double real[K], imag[K];
+    // Blocks of N and of 700 samples, fed in chunks.
+    const size_t blocks[] = {S, 700};
+    for (size_t b = 0; b < 2; ++b)
+    {
+        goertzel.Reset();
+        const double* samples = signal;
+        goertzel.Process(samples, 1);
+        goertzel.Process(samples + 1, 99);
+        goertzel.Process(samples + 100, blocks[b] - 100);
+        CHECK_VALUE(goertzel.GetSampleCount(), blocks[b]);
+        goertzel.GetSpectrum(real, imag);
+        double err = 0;
+        for (size_t i = 0; i < K; ++i)
+        {
+            double er, ei;
+            GetDft(er, ei, signal, 0, blocks[b], bins[i], S);
+            err = std::max(err, fabs(real[i] - er) + fabs(imag[i] - ei));
+        }
+        LOG("    L=%d\n", static_cast<int>(blocks[b]));
+        CHECK_VALUE(err < 1e-9, true);
+    }
+    goertzel.Reset();
+    goertzel.GetSpectrum(real, imag);
+    CHECK_VALUE(real[1], 0);
+    CHECK_VALUE(imag[1], 0);
+}
+
+static void test_sliding_dft(void)
+{
+    LOG("* [SlidingDft]\n");
+    {
+        const size_t bins[] = {1};
+        const masp::spectrum::SlidingDft sdft0(bins, 1, 0);
+        const masp::spectrum::SlidingDft sdft1(bins, 0, 64);
+        CHECK_VALUE(sdft0.IsNull(), true);
+        CHECK_VALUE(sdft1.IsNull(), true);
+    }
+    const size_t S = 2000;
+    mcon::Vector<double> signal(S);
+    for (size_t n = 0; n < S; ++n)
+    {
+        signal[n] = cos(2 * M_PI * 3 * n / 64) + 0.5 * sin(0.7 * n) + 0.01 * (n % 17);
+    }
+    const size_t lengths[] = {64, 45};
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i)
+    {
+        // The bins after each sample from the start, in chunks.
+        const size_t N = lengths[i];
+        const size_t bins[] = {0, 1, 3, 22, N / 2, N - 1};
+        const size_t K = sizeof(bins) / sizeof(bins[0]);
+        masp::spectrum::SlidingDft sdft(bins, K, N);
+        CHECK_VALUE(sdft.GetBinCount(), K);
+        Tracking tracking = {&signal, bins, K, N, 0, 0.0};
+        const double* samples = signal;
+        sdft.Process(samples, 10, CheckBins, &tracking);
+        sdft.Process(samples + 10, 1, CheckBins, &tracking);
+        sdft.Process(samples + 11, S - 11, CheckBins, &tracking);
+        LOG("    N=%d\n", static_cast<int>(N));
+        CHECK_VALUE(tracking.count, S);
+        CHECK_VALUE(sdft.GetSampleCount(), S);
+        CHECK_VALUE(tracking.err < 1e-10, true);
+
+        // The same state without the callback, and after Reset().
+        masp::spectrum::SlidingDft other(bins, K, N);
+        other.Process(samples, S);
+        double err = 0;
+        for (size_t k = 0; k < K; ++k)
+        {
+            err = std::max(err, fabs(other.GetReal()[k] - sdft.GetReal()[k]) + fabs(other.GetImag()[k] - sdft.GetImag()[k]));
+        }
+        CHECK_VALUE(err, 0);
+        sdft.Reset();
+        CHECK_VALUE(sdft.GetReal()[1], 0);
+        CHECK_VALUE(sdft.GetSampleCount(), 0);
+    }
+    {
+        // Stays bounded over a long stream.
+        const size_t N = 100;
+        const size_t bins[] = {7, 13};
+        masp::spectrum::SlidingDft sdft(bins, 2, N);
+        for (size_t r = 0; r < 500; ++r)
+        {
+            sdft.Process(signal, S);
+        }
+        double err = 0;
+        for (size_t k = 0; k < 2; ++k)
+        {
+            double er, ei;
+            GetDft(er, ei, signal, S - N, N, bins[k], N);
+            err = std::max(err, fabs(sdft.GetReal()[k] - er) + fabs(sdft.GetImag()[k] - ei));
+        }
+        CHECK_VALUE(err < 1e-10, true);
+    }
+}
+
+void test_Spectrum(void)
+{
+    test_stft();
+    test_polar();
+    test_welch();
+    test_goertzel();
+    test_sliding_dft();
+}
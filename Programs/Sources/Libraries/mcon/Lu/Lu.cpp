@@ -0,0 +1,274 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <x86intrin.h>
+
+#include "debug.h"
+#include "mcon.h"
+#include "../Row.h"
+
+namespace {
+
+    using mcon::AxpyRow;
+    using mcon::DotRow;
+
+    inline double* GetRow(mcon::Matrix<double>& m, size_t i) { return m[i]; }
+    inline const double* GetRow(const mcon::Matrix<double>& m, size_t i) { return m[i]; }
+    inline float* GetRow(mcon::Matrix<float>& m, size_t i) { return &m[i][0]; }
+    inline const float* GetRow(const mcon::Matrix<float>& m, size_t i) { return &m[i][0]; }
+
+    // Right-looking decomposition in place, where L (without the unit
+    // diagonal) and U share the matrix. Returns false if singular.
+    template <typename Type>
+    bool Decompose(mcon::Matrix<Type>& a, size_t* pivots)
+    {
+        const size_t n = a.GetRowLength();
+        for (size_t k = 0; k < n; ++k)
+        {
+            size_t p = k;
+            Type maximum = 0;
+            for (size_t i = k; i < n; ++i)
+            {
+                const Type v = fabs(a[i][k]);
+                if ( v > maximum )
+                {
+                    maximum = v;
+                    p = i;
+                }
+            }
+            if ( !(maximum > 0) )
+            {
+                return false;
+            }
+            pivots[k] = p;
+            Type* rowK = GetRow(a, k);
+            if ( p != k )
+            {
+                std::swap_ranges(rowK, rowK + n, GetRow(a, p));
+            }
+            const Type pivot = rowK[k];
+            for (size_t i = k + 1; i < n; ++i)
+            {
+                Type* row = GetRow(a, i);
+                row[k] /= pivot;
+                AxpyRow(row + k + 1, -row[k], rowK + k + 1, n - k - 1);
+            }
+        }
+        return true;
+    }
+
+    // x = U^(-1) L^(-1) P x
+    template <typename Type>
+    void Substitute(const mcon::Matrix<Type>& lu, const size_t* pivots, Type* x)
+    {
+        const size_t n = lu.GetRowLength();
+        for (size_t k = 0; k < n; ++k)
+        {
+            std::swap(x[k], x[pivots[k]]);
+        }
+        for (size_t i = 1; i < n; ++i)
+        {
+            x[i] -= DotRow(GetRow(lu, i), x, i);
+        }
+        for (size_t i = n; i > 0; --i)
+        {
+            const Type* row = GetRow(lu, i - 1);
+            x[i - 1] = (x[i - 1] - DotRow(row + i, x + i, n - i)) / row[i - 1];
+        }
+    }
+
+} // anonymous
+
+namespace mcon {
+
+Lu::Lu()
+    : m_Precision(Precision_Double)
+    , m_Length(0)
+    , m_Norm(0)
+    , m_Original()
+    , m_Factor()
+    , m_FactorSingle()
+    , m_Pivots(NULL)
+{
+}
+
+Lu::~Lu()
+{
+    Clear();
+}
+
+void Lu::Clear(void)
+{
+    if ( NULL != m_Pivots )
+    {
+        delete[] m_Pivots;
+        m_Pivots = NULL;
+    }
+    m_Original.Resize(0, 0);
+    m_Factor.Resize(0, 0);
+    m_FactorSingle.Resize(0, 0);
+    m_Precision = Precision_Double;
+    m_Length = 0;
+    m_Norm = 0;
+}
+
+bool Lu::FactorizeDouble(void)
+{
+    m_Precision = Precision_Double;
+    m_FactorSingle.Resize(0, 0);
+    if ( !Decompose(m_Factor, m_Pivots) )
+    {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool Lu::Factorize(const Matrix<double>& A, Precision precision)
+{
+    Clear();
+    const size_t n = A.GetRowLength();
+    if ( A.IsNull() || n != A.GetColumnLength() )
+    {
+        return false;
+    }
+    m_Length = n;
+    m_Pivots = new size_t[n];
+    if ( Precision_Double == precision )
+    {
+        m_Factor = A;
+        return FactorizeDouble();
+    }
+
+    // Decomposed in float unless A does not fit in float.
+    m_FactorSingle.Resize(n, n);
+    bool isInRange = true;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double sum = 0;
+        float* row = GetRow(m_FactorSingle, i);
+        for (size_t j = 0; j < n; ++j)
+        {
+            const double v = A[i][j];
+            sum += fabs(v);
+            isInRange &= (fabs(v) < FLT_MAX);
+            row[j] = static_cast<float>(v);
+        }
+        m_Norm = std::max(m_Norm, sum);
+    }
+    m_Original = A;
+    m_Precision = Precision_Mixed;
+    if ( isInRange && Decompose(m_FactorSingle, m_Pivots) )
+    {
+        return true;
+    }
+    DEBUG_LOG("Falling back to the double precision.\n");
+    m_Factor = A;
+    return FactorizeDouble();
+}
+
+bool Lu::Solve(Vector<double>& x, const VectordBase& b, size_t* pRefinementCount)
+{
+    const size_t n = m_Length;
+    if ( IsNull() || b.GetLength() != n )
+    {
+        return false;
+    }
+    if ( NULL != pRefinementCount )
+    {
+        *pRefinementCount = 0;
+    }
+    if ( Precision_Double == m_Precision )
+    {
+        x = b;
+        Substitute(m_Factor, m_Pivots, static_cast<double*>(x));
+        return true;
+    }
+
+    Vector<float> c(n);
+    float* const pc = &c[0];
+    for (size_t i = 0; i < n; ++i)
+    {
+        pc[i] = static_cast<float>(b[i]);
+    }
+    Substitute(m_FactorSingle, m_Pivots, pc);
+    x.Resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] = pc[i];
+    }
+
+    // x += A^(-1) (b - A x) until ||b - A x|| < sqrt(n) eps ||A|| ||x||,
+    // where only the correction is solved in float.
+    const double tolerance = sqrt(static_cast<double>(n)) * DBL_EPSILON * m_Norm;
+    Vector<double> r(n);
+    for (size_t iteration = 0; iteration <= g_MaxRefinementCount; ++iteration)
+    {
+        r.Copy(b);
+        Gemv(r, m_Original, x, -1.0, 1.0);
+        const double residual = r.GetMaximumAbsolute();
+        if ( residual <= tolerance * x.GetMaximumAbsolute() )
+        {
+            if ( NULL != pRefinementCount )
+            {
+                *pRefinementCount = iteration;
+            }
+            return true;
+        }
+        if ( !(residual < HUGE_VAL) || iteration == g_MaxRefinementCount )
+        {
+            break;
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            pc[i] = static_cast<float>(r[i]);
+        }
+        Substitute(m_FactorSingle, m_Pivots, pc);
+        for (size_t i = 0; i < n; ++i)
+        {
+            x[i] += pc[i];
+        }
+    }
+
+    // Not converged, so that A is decomposed again in double.
+    DEBUG_LOG("Refinement did not converge, falling back to the double precision.\n");
+    m_Factor = m_Original;
+    m_Original.Resize(0, 0);
+    if ( !FactorizeDouble() )
+    {
+        return false;
+    }
+    if ( NULL != pRefinementCount )
+    {
+        *pRefinementCount = 0;
+    }
+    x = b;
+    Substitute(m_Factor, m_Pivots, static_cast<double*>(x));
+    return true;
+}
+
+} // namespace mcon {
@@ -0,0 +1,124 @@
+
+#include <math.h>
+
+#include "debug.h"
+
+#include "mutl.h"
+#include "mcon.h"
+
+namespace {
+
+double Element(size_t i, size_t M, size_t j, size_t N)
+{
+    UNUSED(M);
+    return sin(0.37 * (i + 1) * (j + 2)) + cos(0.11 * i) + ((i == j) ? N * 0.5 : 0.0);
+}
+
+// ||A x - b|| / ||b||
+double GetResidual(const mcon::Matrixd& A, const mcon::VectordBase& x, const mcon::VectordBase& b)
+{
+    mcon::Vectord r(b);
+    mcon::Gemv(r, A, x, 1.0, -1.0);
+    return r.GetNorm() / b.GetNorm();
+}
+
+} // anonymous
+
+void benchmark_Lu(void)
+{
+    enum {
+        ID_INVERSE,
+        ID_DOUBLE,
+        ID_MIXED,
+        NUM_IDS
+    };
+
+    mutl::Stopwatch sw;
+    const int samples[] = { // N x N
+         128,
+         256,
+         512,
+        1024,
+    };
+    const unsigned int numPatterns = sizeof(samples) / sizeof(int);
+    double scores[NUM_IDS][numPatterns];
+    double residuals[NUM_IDS][numPatterns];
+
+    LOG("Benchmark started.\n");
+    for ( unsigned int i = 0; i < numPatterns; ++i )
+    {
+        const int n = samples[i];
+        LOG("Benchmark with the length of %d ... ", n);
+        mcon::Matrixd A(n, n);
+        A.Initialize(Element);
+        mcon::Vectord b(n);
+        for ( int k = 0; k < n; ++k )
+        {
+            b[k] = cos(0.1 * k);
+        }
+        {
+            mcon::Vectord x(n);
+            sw.Push();
+            mcon::Gemv(x, A.Inverse(), b);
+            scores[ID_INVERSE][i] = sw.Tick();
+            residuals[ID_INVERSE][i] = GetResidual(A, x, b);
+        }
+        {
+            mcon::Vectord x;
+            mcon::Lu lu;
+            sw.Push();
+            lu.Factorize(A);
+            lu.Solve(x, b);
+            scores[ID_DOUBLE][i] = sw.Tick();
+            residuals[ID_DOUBLE][i] = GetResidual(A, x, b);
+        }
+        {
+            mcon::Vectord x;
+            mcon::Lu lu;
+            size_t count = 0;
+            sw.Push();
+            lu.Factorize(A, mcon::Lu::Precision_Mixed);
+            lu.Solve(x, b, &count);
+            scores[ID_MIXED][i] = sw.Tick();
+            residuals[ID_MIXED][i] = GetResidual(A, x, b);
+            LOG("(%d refinements) ", static_cast<int>(count));
+        }
+        LOG("Done\n");
+    }
+    const char* testNames[NUM_IDS] = {
+        "Inverse",
+        "LU (double)",
+        "LU (mixed)"
+    };
+    printf("Samples [ms]");
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        printf(",%d", samples[k]);
+    }
+    printf("\n");
+    for ( int id = 0; id < NUM_IDS; ++id )
+    {
+        printf("%s", testNames[id]);
+        for ( unsigned int k = 0; k < numPatterns; ++k )
+        {
+            printf(",%g", scores[id][k] * 1000);
+        }
+        printf("\n");
+    }
+    printf("Residual ||Ax-b||/||b||");
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        printf(",%d", samples[k]);
+    }
+    printf("\n");
+    for ( int id = 0; id < NUM_IDS; ++id )
+    {
+        printf("%s", testNames[id]);
+        for ( unsigned int k = 0; k < numPatterns; ++k )
+        {
+            printf(",%g", residuals[id][k]);
+        }
+        printf("\n");
+    }
+    LOG("END\n");
+}
@@ -0,0 +1,17 @@
+#include "mcon.h"
+
+extern void test_Lu(void);
+extern void benchmark_Lu(void);
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 2)
+    {
+        test_Lu();
+    }
+    else
+    {
+        benchmark_Lu();
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+
+#include <algorithm>
+#include <math.h>
+
+#include "mcon.h"
+#include "../TestHelper.h"
+
+namespace {
+
+// Diagonally dominant, so that A is well conditioned.
+double DominantElement(size_t i, size_t M, size_t j, size_t N)
+{
+    UNUSED(M);
+    return sin(0.37 * (i + 1) * (j + 2)) + cos(0.11 * i) + ((i == j) ? N * 0.5 : 0.0);
+}
+
+double Hilbert(size_t i, size_t M, size_t j, size_t N)
+{
+    UNUSED(M);
+    UNUSED(N);
+    return 1.0 / (i + j + 1);
+}
+
+// ||A x - b|| / ||b||
+double GetResidual(const mcon::Matrixd& A, const mcon::VectordBase& x, const mcon::VectordBase& b)
+{
+    mcon::Vectord r(b);
+    mcon::Gemv(r, A, x, 1.0, -1.0);
+    return r.GetNorm() / b.GetNorm();
+}
+
+} // anonymous
+
+void test_Lu(void)
+{
+    LOG("* [Empty]\n");
+    {
+        mcon::Lu lu;
+        CHECK_VALUE(lu.IsNull(), true);
+        mcon::Matrixd A;
+        CHECK_VALUE(lu.Factorize(A), false);
+        A.Resize(2, 3);
+        A = 1.0;
+        CHECK_VALUE(lu.Factorize(A), false);
+        mcon::Vectord x;
+        mcon::Vectord b(2);
+        CHECK_VALUE(lu.Solve(x, b), false);
+    }
+    LOG("* [Double]\n");
+    {
+        const size_t lengths[] = {1, 3, 8, 33, 100};
+        for (size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+        {
+            const size_t n = lengths[i];
+            LOG("    n=%d\n", static_cast<int>(n));
+            mcon::Matrixd A(n, n);
+            A.Initialize(DominantElement);
+            mcon::Vectord b(n);
+            b.Initialize(Signal);
+            b += 1.0;
+
+            mcon::Lu lu;
+            bool status = lu.Factorize(A);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(lu.GetLength(), n);
+            CHECK_VALUE(lu.GetPrecision(), mcon::Lu::Precision_Double);
+            mcon::Vectord x;
+            size_t count = 1;
+            status = lu.Solve(x, b, &count);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(count, 0);
+            CHECK_VALUE(GetResidual(A, x, b), 0);
+
+            // Compared with the inverse matrix.
+            mcon::Vectord y(n);
+            mcon::Gemv(y, A.Inverse(), b);
+            y -= x;
+            CHECK_VALUE(y.GetMaximumAbsolute(), 0);
+        }
+    }
+    LOG("* [Mixed]\n");
+    {
+        const size_t lengths[] = {1, 3, 8, 33, 100, 300};
+        for (size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+        {
+            const size_t n = lengths[i];
+            LOG("    n=%d\n", static_cast<int>(n));
+            mcon::Matrixd A(n, n);
+            A.Initialize(DominantElement);
+            mcon::Vectord b(n);
+            b.Initialize(Signal);
+            b += 1.0;
+
+            mcon::Lu lu;
+            bool status = lu.Factorize(A, mcon::Lu::Precision_Mixed);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(lu.GetPrecision(), mcon::Lu::Precision_Mixed);
+            mcon::Vectord x;
+            size_t count = 0;
+            status = lu.Solve(x, b, &count);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(lu.GetPrecision(), mcon::Lu::Precision_Mixed);
+            CHECK_VALUE(count > 0 || n == 1, true);
+            CHECK_VALUE(GetResidual(A, x, b) < 1.0e-14, true);
+
+            mcon::Lu reference;
+            reference.Factorize(A);
+            mcon::Vectord y;
+            reference.Solve(y, b);
+            y -= x;
+            CHECK_VALUE(y.GetMaximumAbsolute(), 0);
+        }
+    }
+    LOG("* [Fallback]\n");
+    {
+        // Too ill-conditioned for float, cond(A) ~ 1e16.
+        const size_t n = 12;
+        mcon::Matrixd A(n, n);
+        A.Initialize(Hilbert);
+        mcon::Vectord b(n);
+        b = 1.0;
+
+        mcon::Lu lu;
+        bool status = lu.Factorize(A, mcon::Lu::Precision_Mixed);
+        CHECK_VALUE(status, true);
+        mcon::Vectord x;
+        size_t count = 1;
+        status = lu.Solve(x, b, &count);
+        CHECK_VALUE(status, true);
+        CHECK_VALUE(lu.GetPrecision(), mcon::Lu::Precision_Double);
+        CHECK_VALUE(count, 0);
+
+        mcon::Lu reference;
+        reference.Factorize(A);
+        mcon::Vectord y;
+        reference.Solve(y, b);
+        y -= x;
+        CHECK_VALUE(y.GetMaximumAbsolute(), 0);
+        // The following solves use the double one.
+        count = 1;
+        status = lu.Solve(x, b, &count);
+        CHECK_VALUE(status, true);
+        CHECK_VALUE(count, 0);
+    }
+    LOG("* [Singular]\n");
+    {
+        mcon::Matrixd A(3, 3);
+        A.Initialize(DominantElement);
+        A[2] = A[0];
+        mcon::Lu lu;
+        bool status = lu.Factorize(A);
+        CHECK_VALUE(status, false);
+        CHECK_VALUE(lu.IsNull(), true);
+        A = 0;
+        status = lu.Factorize(A, mcon::Lu::Precision_Mixed);
+        CHECK_VALUE(status, false);
+    }
+}
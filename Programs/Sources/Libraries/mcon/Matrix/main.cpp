@@ -216,6 +216,67 @@ static void test_transpose(void)
     }
 }
 
+static void test_matrix_storage(void)
+{
+    const size_t row = 5;
+    const size_t col = 3;
+    mcon::Matrix<TestType> m(row, col);
+    m.Initialize( initializer );
+
+    // The rows are aligned and placed in order in a single block.
+    for (size_t k = 0; k < row; ++k )
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(static_cast<void*>(m[k]));
+        const uintptr_t misalignment = address % 32;
+        CHECK_VALUE(misalignment, 0);
+        if (k > 0)
+        {
+            CHECK_VALUE(address > reinterpret_cast<uintptr_t>(static_cast<void*>(m[k-1])), true);
+        }
+    }
+
+    // Copy and assignment
+    mcon::Matrix<TestType> copied(m);
+    mcon::Matrix<TestType> assigned(1, 1);
+    assigned = m;
+    CHECK_VALUE(copied.GetRowLength(), row);
+    CHECK_VALUE(assigned.GetColumnLength(), col);
+    bool isMatched = true;
+    for (size_t k = 0; k < row; ++k )
+    {
+        for (size_t n = 0; n < col; ++n )
+        {
+            isMatched &= (copied[k][n] == m[k][n]) && (assigned[k][n] == m[k][n]);
+        }
+    }
+    CHECK_VALUE(isMatched, true);
+    copied[0][0] = -1;
+    CHECK_VALUE(m[0][0], initializer(0, row, 0, col));
+
+    // A row can be assigned but not resized.
+    mcon::Vector<TestType> v(col);
+    v = 7;
+    m[1] = v;
+    CHECK_VALUE(m[1][col-1], 7);
+    CHECK_VALUE(m[1].Resize(col + 1), false);
+    CHECK_VALUE(m[1].GetLength(), col);
+
+    // The rows are kept when only the row length is changed.
+    bool status = m.Resize(row + 2, col);
+    CHECK_VALUE(status, true);
+    CHECK_VALUE(m.GetRowLength(), row + 2);
+    CHECK_VALUE(m[1][0], 7);
+    CHECK_VALUE(m[row-1][col-1], initializer(row-1, row, col-1, col));
+    status = m.Resize(2, col + 1);
+    CHECK_VALUE(status, true);
+    CHECK_VALUE(m.GetRowLength(), 2);
+    CHECK_VALUE(m[1].GetLength(), col + 1);
+
+    status = m.Resize(0, 0);
+    CHECK_VALUE(status, true);
+    CHECK_VALUE(m.IsNull(), true);
+}
+
 int main(void)
 {
     test_transpose();
@@ -223,5 +284,6 @@ int main(void)
     test_matrix_determinant();
     test_matrix_inverse();
     test_Matrix();
+    test_matrix_storage();
     return 0;
 }
@@ -23,12 +23,15 @@
  */
 
 
+#include <algorithm>
 #include <new>
 #include <stdint.h>
 #include <sys/types.h>
+#include <x86intrin.h>
 
 #include "debug.h"
 #include "mcon.h"
+#include "../Row.h"
 
 namespace {
 
@@ -38,6 +41,98 @@ namespace {
         while (reinterpret_cast<uintptr_t>(aligned) % align) { ++aligned; }
         return const_cast<double*>(reinterpret_cast<const double*>(aligned));
     }
+    // Transpose is processed tile by tile to keep both of the source and
+    // the destination in the cache.
+    const size_t g_TransposeTileSize = 32;
+    // Transpose uses threads when the element count is larger than this.
+    const size_t g_TransposeParallelThreshold = 1024 * 1024;
+
+    inline void Load4x4(__m256d r[4], const mcon::Matrix<double>& m, size_t row, size_t col)
+    {
+        for (size_t k = 0; k < 4; ++k)
+        {
+            r[k] = _mm256_load_pd(static_cast<double*>(m[row + k]) + col);
+        }
+    }
+
+    inline void Store4x4(mcon::Matrix<double>& m, size_t row, size_t col, const __m256d r[4])
+    {
+        for (size_t k = 0; k < 4; ++k)
+        {
+            _mm256_store_pd(static_cast<double*>(m[row + k]) + col, r[k]);
+        }
+    }
+
+    // Transposes a 4x4 block in the registers.
+    inline void Transpose4x4(__m256d r[4])
+    {
+        const __m256d t0 = _mm256_unpacklo_pd(r[0], r[1]); // a0 b0 a2 b2
+        const __m256d t1 = _mm256_unpackhi_pd(r[0], r[1]); // a1 b1 a3 b3
+        const __m256d t2 = _mm256_unpacklo_pd(r[2], r[3]); // c0 d0 c2 d2
+        const __m256d t3 = _mm256_unpackhi_pd(r[2], r[3]); // c1 d1 c3 d3
+        r[0] = _mm256_permute2f128_pd(t0, t2, 0x20); // a0 b0 c0 d0
+        r[1] = _mm256_permute2f128_pd(t1, t3, 0x20); // a1 b1 c1 d1
+        r[2] = _mm256_permute2f128_pd(t0, t2, 0x31); // a2 b2 c2 d2
+        r[3] = _mm256_permute2f128_pd(t1, t3, 0x31); // a3 b3 c3 d3
+    }
+
+    // Transposes rows [rowBegin, rowEnd) of src into dst.
+    // rowBegin must be a multiple of 4 to keep the stores aligned.
+    void TransposeRows(mcon::Matrix<double>& dst, const mcon::Matrix<double>& src, size_t rowBegin, size_t rowEnd)
+    {
+        const size_t tile = g_TransposeTileSize;
+        const size_t columnLength = src.GetColumnLength();
+        for (size_t ib = rowBegin; ib < rowEnd; ib += tile)
+        {
+            const size_t ie = std::min(ib + tile, rowEnd);
+            for (size_t jb = 0; jb < columnLength; jb += tile)
+            {
+                const size_t je = std::min(jb + tile, columnLength);
+                size_t i = ib;
+                for ( ; i + 4 <= ie; i += 4)
+                {
+                    size_t j = jb;
+                    for ( ; j + 4 <= je; j += 4)
+                    {
+                        __m256d r[4];
+                        Load4x4(r, src, i, j);
+                        Transpose4x4(r);
+                        Store4x4(dst, j, i, r);
+                    }
+                    for ( ; j < je; ++j)
+                    {
+                        for (size_t k = 0; k < 4; ++k)
+                        {
+                            dst[j][i + k] = src[i + k][j];
+                        }
+                    }
+                }
+                for ( ; i < ie; ++i)
+                {
+                    for (size_t j = jb; j < je; ++j)
+                    {
+                        dst[j][i] = src[i][j];
+                    }
+                }
+            }
+        }
+    }
+
+    // The matrices of Transpose(), shared by the threads in tiles of rows.
+    struct Transposition
+    {
+        mcon::Matrix<double>* dst;
+        const mcon::Matrix<double>* src;
+    };
+
+    // Transposes the row tiles [tileBegin, tileEnd).
+    void TransposeTiles(const Transposition& transposition, size_t tileBegin, size_t tileEnd)
+    {
+        const size_t tile = g_TransposeTileSize;
+        const size_t rowLength = transposition.src->GetRowLength();
+        TransposeRows(*transposition.dst, *transposition.src, std::min(rowLength, tileBegin * tile), std::min(rowLength, tileEnd * tile));
+    }
+
 } // anonymous
 
 namespace mcon {
@@ -161,17 +256,83 @@ Matrix<double>& Matrix<double>::operator=(const Matrix<double>& m)
 }
 
 
-Matrix<double> Matrix<double>::Transpose(void) const
+Matrix<double> Matrix<double>::Transpose(size_t threadCount) const
 {
     Matrix<double> transposed(GetColumnLength(), GetRowLength());
-    for (size_t i = 0; i < GetRowLength(); ++i)
+    if ( !IsNull() )
+    {
+        Transpose(transposed, threadCount);
+    }
+    return transposed;
+}
+
+bool Matrix<double>::Transpose(Matrix<double>& transposed, size_t threadCount) const
+{
+    if ( IsNull() || this == &transposed )
+    {
+        return false;
+    }
+    if ( (transposed.GetRowLength() != GetColumnLength() || transposed.GetColumnLength() != GetRowLength())
+        && false == transposed.Resize(GetColumnLength(), GetRowLength()) )
+    {
+        return false;
+    }
+    const size_t tile = g_TransposeTileSize;
+    const size_t tileCount = (GetRowLength() + tile - 1) / tile;
+    threadCount = GetThreadCount(threadCount, GetRowLength() * GetColumnLength(), g_TransposeParallelThreshold);
+    // Each thread takes a contiguous range of row tiles.
+    const Transposition transposition = { &transposed, this };
+    ForRanges(TransposeTiles, transposition, tileCount, threadCount);
+    return true;
+}
+
+bool Matrix<double>::TransposeSelf(void)
+{
+    if ( GetRowLength() != GetColumnLength() )
     {
-        for (size_t j = 0; j < GetColumnLength(); ++j)
+        return false;
+    }
+    const size_t n = GetRowLength();
+    const size_t n4 = n & ~static_cast<size_t>(3);
+    const size_t tile = g_TransposeTileSize;
+    Matrix<double>& m = *this;
+    // Pairs of 4x4 blocks, (i, j) and (j, i), are swapped.
+    for (size_t ib = 0; ib < n4; ib += tile)
+    {
+        const size_t ie = std::min(ib + tile, n4);
+        for (size_t jb = ib; jb < n4; jb += tile)
         {
-            transposed[j][i] = (*this)[i][j];
+            const size_t je = std::min(jb + tile, n4);
+            for (size_t i = ib; i < ie; i += 4)
+            {
+                for (size_t j = (jb == ib ? i : jb); j < je; j += 4)
+                {
+                    __m256d a[4];
+                    Load4x4(a, m, i, j);
+                    Transpose4x4(a);
+                    if (i == j)
+                    {
+                        Store4x4(m, i, i, a);
+                        continue;
+                    }
+                    __m256d b[4];
+                    Load4x4(b, m, j, i);
+                    Transpose4x4(b);
+                    Store4x4(m, j, i, a);
+                    Store4x4(m, i, j, b);
+                }
+            }
         }
     }
-    return transposed;
+    // The remaining columns (and rows) which are out of 4x4 blocks.
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = std::max(i + 1, n4); j < n; ++j)
+        {
+            std::swap(m[i][j], m[j][i]);
+        }
+    }
+    return true;
 }
 
 
@@ -197,18 +358,66 @@ Matrix<double> Matrix<double>::Multiply(const Matrix<double>& m) const
         }
     }
 #else
-    Matrix<double> transposed(m.T());
+    // Rows of m are accumulated so that m is never transposed.
+    multiplied = 0;
     for (size_t row = 0; row < multiplied.GetRowLength(); ++row)
     {
-        for (size_t col = 0; col < multiplied.GetColumnLength(); ++col)
+        for (size_t k = 0; k < GetColumnLength(); ++k)
         {
-            multiplied[row][col] = (*this)[row].Dot(transposed[col]);
+            AxpyRow(multiplied[row], (*this)[row][k], m[k], m.GetColumnLength());
         }
     }
 #endif
     return multiplied;
 }
 
+Matrix<double> Matrix<double>::Multiply(const TransposedMatrixd& m) const
+{
+    const Matrix<double>& original = m.GetOriginal();
+    if ( GetColumnLength() != original.GetColumnLength() )
+    {
+        Matrix<double> null;
+        return null;
+    }
+    // (this * m^T)[row][col] is a dot product of rows.
+    Matrix<double> multiplied(GetRowLength(), original.GetRowLength());
+    for (size_t row = 0; row < multiplied.GetRowLength(); ++row)
+    {
+        for (size_t col = 0; col < multiplied.GetColumnLength(); ++col)
+        {
+            multiplied[row][col] = (*this)[row].Dot(original[col]);
+        }
+    }
+    return multiplied;
+}
+
+Matrix<double> TransposedMatrixd::Multiply(const Matrix<double>& m) const
+{
+    if ( GetColumnLength() != m.GetRowLength() )
+    {
+        Matrix<double> null;
+        return null;
+    }
+    // (A^T * m)[row] = sum_k A[k][row] * m[k]
+    Matrix<double> multiplied(GetRowLength(), m.GetColumnLength());
+    multiplied = 0;
+    for (size_t k = 0; k < m_Original.GetRowLength(); ++k)
+    {
+        const VectordBase& a = m_Original[k];
+        for (size_t row = 0; row < multiplied.GetRowLength(); ++row)
+        {
+            AxpyRow(multiplied[row], a[row], m[k], m.GetColumnLength());
+        }
+    }
+    return multiplied;
+}
+
+Matrix<double> TransposedMatrixd::Multiply(const TransposedMatrixd& m) const
+{
+    // A^T * B^T = (B * A)^T
+    return m.GetOriginal().Multiply(m_Original).Transpose();
+}
+
 
 Matrix<double> Matrix<double>::GetCofactorMatrix(size_t row, size_t col) const
 {
@@ -434,4 +643,131 @@ const Matrix<double> Matrix<double>::SubMatrix(
     return m;
 }
 
+bool Axpy(VectordBase& y, double alpha, const VectordBase& x)
+{
+    if ( y.GetLength() != x.GetLength() )
+    {
+        return false;
+    }
+    AxpyRow(y, alpha, x, y.GetLength());
+    return true;
+}
+
+bool Gemv(VectordBase& y, const Matrix<double>& A, const VectordBase& x, double alpha, double beta)
+{
+    if ( A.GetColumnLength() != x.GetLength() || A.GetRowLength() != y.GetLength() )
+    {
+        return false;
+    }
+    for (size_t i = 0; i < A.GetRowLength(); ++i)
+    {
+        const double v = alpha * A[i].Dot(x);
+        // y is not referred with beta = 0 so that it can be uninitialized.
+        y[i] = (0 == beta) ? v : v + beta * y[i];
+    }
+    return true;
+}
+
+bool Gemv(VectordBase& y, const TransposedMatrixd& A, const VectordBase& x, double alpha, double beta)
+{
+    const Matrix<double>& original = A.GetOriginal();
+    if ( A.GetColumnLength() != x.GetLength() || A.GetRowLength() != y.GetLength() )
+    {
+        return false;
+    }
+    // y = beta * y + sum_k (alpha * x[k]) * A[k]
+    if (0 == beta)
+    {
+        y = 0;
+    }
+    else
+    {
+        y *= beta;
+    }
+    for (size_t k = 0; k < original.GetRowLength(); ++k)
+    {
+        AxpyRow(y, alpha * x[k], original[k], y.GetLength());
+    }
+    return true;
+}
+
+bool Ger(Matrix<double>& A, double alpha, const VectordBase& x, const VectordBase& y)
+{
+    if ( A.GetRowLength() != x.GetLength() || A.GetColumnLength() != y.GetLength() )
+    {
+        return false;
+    }
+    for (size_t i = 0; i < A.GetRowLength(); ++i)
+    {
+        AxpyRow(A[i], alpha * x[i], y, y.GetLength());
+    }
+    return true;
+}
+
+bool Syr(Matrix<double>& A, double alpha, const VectordBase& x)
+{
+    const size_t n = x.GetLength();
+    if ( A.GetRowLength() != n || A.GetColumnLength() != n )
+    {
+        return false;
+    }
+    // (x[i] * x[j]) * alpha is evaluated so that A[i][j] and A[j][i]
+    // get bitwise the same update.
+    const double* const px = x;
+    const __m256d av = _mm256_set1_pd(alpha);
+    for (size_t i = 0; i < n; ++i)
+    {
+        double* const row = A[i];
+        const double xi = px[i];
+        const __m256d xiv = _mm256_set1_pd(xi);
+        size_t k = 0;
+        for ( ; k + 4 <= n; k += 4)
+        {
+            const __m256d xv = _mm256_loadu_pd(px + k);
+            const __m256d rv = _mm256_load_pd(row + k);
+            _mm256_store_pd(row + k, _mm256_add_pd(rv, _mm256_mul_pd(_mm256_mul_pd(xiv, xv), av)));
+        }
+        for ( ; k < n; ++k)
+        {
+            row[k] += (xi * px[k]) * alpha;
+        }
+    }
+    return true;
+}
+
+bool Syr2(Matrix<double>& A, double alpha, const VectordBase& x, const VectordBase& y)
+{
+    const size_t n = x.GetLength();
+    if ( A.GetRowLength() != n || A.GetColumnLength() != n || y.GetLength() != n )
+    {
+        return false;
+    }
+    // (x[i] * y[j] + y[i] * x[j]) * alpha is symmetric in i and j bitwise.
+    const double* const px = x;
+    const double* const py = y;
+    const __m256d av = _mm256_set1_pd(alpha);
+    for (size_t i = 0; i < n; ++i)
+    {
+        double* const row = A[i];
+        const double xi = px[i];
+        const double yi = py[i];
+        const __m256d xiv = _mm256_set1_pd(xi);
+        const __m256d yiv = _mm256_set1_pd(yi);
+        size_t k = 0;
+        for ( ; k + 4 <= n; k += 4)
+        {
+            const __m256d xv = _mm256_loadu_pd(px + k);
+            const __m256d yv = _mm256_loadu_pd(py + k);
+            const __m256d sv = _mm256_add_pd(_mm256_mul_pd(xiv, yv), _mm256_mul_pd(yiv, xv));
+            const __m256d rv = _mm256_load_pd(row + k);
+            _mm256_store_pd(row + k, _mm256_add_pd(rv, _mm256_mul_pd(sv, av)));
+        }
+        for ( ; k < n; ++k)
+        {
+            row[k] += (xi * py[k] + yi * px[k]) * alpha;
+        }
+    }
+    return true;
+}
+
 } // namespace mcon {
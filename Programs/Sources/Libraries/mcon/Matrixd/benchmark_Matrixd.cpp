@@ -54,9 +54,9 @@ void benchmark_Matrixd(void)
         int id = 0;
         {
             sw.Push();
-            g_Global = md1.T()[0][0];
+            g_Global = md1.Transpose()[0][0];
             const double recordMatrixd = sw.Tick();
-            g_Global = mc1.T()[0][0];
+            g_Global = mc1.Transpose()[0][0];
             const double recordMatrix  = sw.Tick();
             scores[id][i] = recordMatrix/recordMatrixd;
             ++id;
@@ -116,3 +116,104 @@ void benchmark_Matrixd(void)
     }
     LOG("END\n");
 }
+
+namespace {
+
+// The straightforward one for comparison.
+void TransposeNaive(mcon::Matrixd& transposed, const mcon::Matrixd& m)
+{
+    for (size_t i = 0; i < m.GetRowLength(); ++i)
+    {
+        for (size_t j = 0; j < m.GetColumnLength(); ++j)
+        {
+            transposed[j][i] = m[i][j];
+        }
+    }
+}
+
+} // anonymous
+
+void benchmark_MatrixdTranspose(void)
+{
+    enum {
+        ID_NAIVE,
+        ID_BLOCKED,
+        ID_THREADED,
+        ID_SELF,
+        NUM_IDS
+    };
+
+    mutl::Stopwatch sw;
+    const int samples[] = { // N x N
+        1 * KiB,
+        2 * KiB,
+        4 * KiB,
+        8 * KiB,
+    };
+    const unsigned int numPatterns = sizeof(samples) / sizeof(int);
+    double scores[NUM_IDS][numPatterns];
+
+    LOG("Benchmark started.\n");
+    for ( unsigned int i = 0; i < numPatterns; ++i )
+    {
+        const int n = samples[i];
+        LOG("Benchmark with the length of %d ... ", n);
+        mcon::Matrixd m(n, n);
+        for ( int k = 0; k < n; ++k )
+        {
+            for ( int l = 0; l < n; ++l )
+            {
+                m[k][l] = k - l;
+            }
+        }
+        // Every variant writes into the same preallocated matrix.
+        mcon::Matrixd transposed(n, n);
+        {
+            sw.Push();
+            TransposeNaive(transposed, m);
+            scores[ID_NAIVE][i] = sw.Tick();
+            g_Global = transposed[0][1];
+        }
+        {
+            sw.Push();
+            m.Transpose(transposed, 1);
+            scores[ID_BLOCKED][i] = sw.Tick();
+            g_Global = transposed[0][1];
+        }
+        {
+            sw.Push();
+            m.Transpose(transposed);
+            scores[ID_THREADED][i] = sw.Tick();
+            g_Global = transposed[0][1];
+        }
+        {
+            sw.Push();
+            m.TransposeSelf();
+            scores[ID_SELF][i] = sw.Tick();
+            g_Global = m[0][1];
+        }
+        LOG("Done\n");
+    }
+    const char* testNames[NUM_IDS] = {
+        "Naive",
+        "Blocked",
+        "Threaded",
+        "TransposeSelf"
+    };
+    printf("Samples [ms]");
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        printf(",%d", samples[k]);
+    }
+    printf("\n");
+    for ( int id = 0; id < NUM_IDS; ++id )
+    {
+        printf("%s", testNames[id]);
+        for ( unsigned int k = 0; k < numPatterns; ++k )
+        {
+            printf(",%g", scores[id][k] * 1000);
+        }
+        printf("\n");
+    }
+    LOG("END\n");
+}
@@ -3,11 +3,18 @@
 
 extern void test_Matrixd(void);
 extern void benchmark_Matrixd(void);
+extern void benchmark_MatrixdTranspose(void);
 
-int main(void)
+int main(int argc, const char* argv[])
 {
-    test_Matrixd();
-    //benchmark_Matrixd();
-
+    if (argc < 2)
+    {
+        test_Matrixd();
+    }
+    else
+    {
+        //benchmark_Matrixd();
+        benchmark_MatrixdTranspose();
+    }
     return 0;
 }
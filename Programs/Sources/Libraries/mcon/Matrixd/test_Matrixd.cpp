@@ -1,5 +1,9 @@
 
+#include <algorithm>
+#include <math.h>
+
 #include "mcon.h"
+#include "../TestHelper.h"
 
 void DumpMatrix(const mcon::Matrix<double>&m, const char* fmt = NULL)
 {
@@ -304,6 +308,83 @@ void test_Matrixd(void)
             }
         }
     }
+    {
+        // Blocked, remainders of blocks and threads.
+        const size_t sizes[][2] = { {37, 70}, {64, 64}, {70, 37}, {3, 129} };
+        for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); ++s)
+        {
+            const size_t row = sizes[s][0];
+            const size_t col = sizes[s][1];
+            mcon::Matrixd m(row, col);
+            for (size_t i = 0; i < row; ++i)
+            {
+                for (size_t j = 0; j < col; ++j)
+                {
+                    m[i][j] = i * 1000.0 + j;
+                }
+            }
+            for (size_t threadCount = 1; threadCount <= 3; threadCount += 2)
+            {
+                const mcon::Matrixd mt(m.Transpose(threadCount));
+                CHECK_VALUE(mt.GetRowLength(), col);
+                CHECK_VALUE(mt.GetColumnLength(), row);
+                bool isMatched = true;
+                for (size_t i = 0; i < col; ++i)
+                {
+                    for (size_t j = 0; j < row; ++j)
+                    {
+                        isMatched &= (mt[i][j] == m[j][i]);
+                    }
+                }
+                CHECK_VALUE(isMatched, true);
+            }
+            // Into an existing matrix, resized when its size differs.
+            mcon::Matrixd mt(row, col);
+            const bool status = m.Transpose(mt);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(mt.GetRowLength(), col);
+            CHECK_VALUE(mt.GetColumnLength(), row);
+            bool isMatched = true;
+            for (size_t i = 0; i < col; ++i)
+            {
+                for (size_t j = 0; j < row; ++j)
+                {
+                    isMatched &= (mt[i][j] == m[j][i]);
+                }
+            }
+            CHECK_VALUE(isMatched, true);
+            CHECK_VALUE(m.Transpose(m), false);
+        }
+    }
+    LOG("* [TransposeSelf]\n");
+    {
+        const size_t sizes[] = {1, 5, 37, 64};
+        for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); ++s)
+        {
+            const size_t n = sizes[s];
+            mcon::Matrixd m(n, n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                for (size_t j = 0; j < n; ++j)
+                {
+                    m[i][j] = i * 1000.0 + j;
+                }
+            }
+            const bool status = m.TransposeSelf();
+            CHECK_VALUE(status, true);
+            bool isMatched = true;
+            for (size_t i = 0; i < n; ++i)
+            {
+                for (size_t j = 0; j < n; ++j)
+                {
+                    isMatched &= (m[i][j] == j * 1000.0 + i);
+                }
+            }
+            CHECK_VALUE(isMatched, true);
+        }
+        mcon::Matrixd m(3, 4);
+        CHECK_VALUE(m.TransposeSelf(), false);
+    }
 
     LOG("* [Multiply]\n");
     {
@@ -474,6 +555,175 @@ void test_Matrixd(void)
             CHECK_VALUE(ms2.IsNull(), true);
         }
     }
+    LOG("* [TransposedMatrixd]\n");
+    {
+        const size_t row = 5;
+        const size_t col = 7;
+        mcon::Matrixd a(row, col);
+        mcon::Matrixd b(row, col);
+        for (size_t i = 0; i < row; ++i)
+        {
+            for (size_t j = 0; j < col; ++j)
+            {
+                a[i][j] = (i + 1) * 0.5 - j * 0.25;
+                b[i][j] = 1.0 / (i + j + 1);
+            }
+        }
+        const mcon::Matrixd at(a.Transpose());
+        const mcon::Matrixd bt(b.Transpose());
+        {
+            const mcon::TransposedMatrixd t(a.T());
+            CHECK_VALUE(t.GetRowLength(), col);
+            CHECK_VALUE(t.GetColumnLength(), row);
+            CHECK_VALUE(t(col - 1, 0), a[0][col - 1]);
+            CHECK_VALUE(&t.T() == &a, true);
+            // Materialization
+            mcon::Matrixd m;
+            m = a.T();
+            const mcon::Matrixd m2(a.T());
+            CHECK_VALUE(GetMaximumDifference(m, at), 0);
+            CHECK_VALUE(GetMaximumDifference(m2, at), 0);
+        }
+        {
+            // A * B^T
+            const mcon::Matrixd expected(a.Multiply(bt));
+            const mcon::Matrixd m(a.Multiply(b.T()));
+            CHECK_VALUE(m.GetRowLength(), row);
+            CHECK_VALUE(m.GetColumnLength(), row);
+            CHECK_VALUE(GetMaximumDifference(m, expected), 0);
+            CHECK_VALUE(a.Multiply(at.T()).IsNull(), true);
+        }
+        {
+            // A^T * B
+            const mcon::Matrixd expected(at.Multiply(b));
+            const mcon::Matrixd m(a.T().Multiply(b));
+            CHECK_VALUE(m.GetRowLength(), col);
+            CHECK_VALUE(m.GetColumnLength(), col);
+            CHECK_VALUE(GetMaximumDifference(m, expected), 0);
+            CHECK_VALUE(a.T().Multiply(at).IsNull(), true);
+        }
+        {
+            // A^T * B^T
+            const mcon::Matrixd expected(at.Multiply(b));
+            const mcon::Matrixd m(a.T().Multiply(bt.T()));
+            CHECK_VALUE(GetMaximumDifference(m, expected), 0);
+        }
+        {
+            // y = A^T x
+            mcon::Vectord x(row);
+            for (size_t i = 0; i < row; ++i)
+            {
+                x[i] = i - 2.0;
+            }
+            const mcon::Matrixd expected(at.Multiply(mcon::Matrixd(x, true)));
+            mcon::Vectord y(col);
+            y = 1.0;
+            const bool status = mcon::Gemv(y, a.T(), x, 2.0, 0.5);
+            CHECK_VALUE(status, true);
+            for (size_t i = 0; i < col; ++i)
+            {
+                CHECK_VALUE(y[i], 2.0 * expected[i][0] + 0.5);
+            }
+        }
+    }
+    LOG("* [Axpy/Gemv/Ger/Syr/Syr2]\n");
+    {
+        const size_t row = 7;
+        const size_t col = 6;
+        mcon::Matrixd a(row, col);
+        mcon::Matrixd s(col, col);
+        mcon::Vectord x(col);
+        mcon::Vectord y(row);
+        mcon::Vectord z(col);
+        bool status;
+        for (size_t i = 0; i < row; ++i)
+        {
+            for (size_t j = 0; j < col; ++j)
+            {
+                a[i][j] = (i + 1) * 0.5 - j * 0.25;
+            }
+            y[i] = i * 0.125 + 1;
+        }
+        for (size_t i = 0; i < col; ++i)
+        {
+            for (size_t j = 0; j < col; ++j)
+            {
+                s[i][j] = 1.0 / (i + j + 1);
+            }
+            x[i] = i * 0.5 - 1;
+            z[i] = 2.0 - i * 0.25;
+        }
+        {
+            mcon::Vectord w(x);
+            status = mcon::Axpy(w, 3.0, z);
+            CHECK_VALUE(status, true);
+            for (size_t i = 0; i < col; ++i)
+            {
+                CHECK_VALUE(w[i], x[i] + 3.0 * z[i]);
+            }
+            status = mcon::Axpy(w, 3.0, y);
+            CHECK_VALUE(status, false);
+        }
+        {
+            const mcon::Matrixd ax(a.Multiply(mcon::Matrixd(x, true)));
+            mcon::Vectord w(row);
+            status = mcon::Gemv(w, a, x);
+            CHECK_VALUE(status, true);
+            for (size_t i = 0; i < row; ++i)
+            {
+                CHECK_VALUE(w[i], ax[i][0]);
+            }
+            mcon::Vectord v(y);
+            status = mcon::Gemv(v, a, x, 2.0, -1.0);
+            CHECK_VALUE(status, true);
+            for (size_t i = 0; i < row; ++i)
+            {
+                CHECK_VALUE(v[i], 2.0 * ax[i][0] - y[i]);
+            }
+            status = mcon::Gemv(w, a, y);
+            CHECK_VALUE(status, false);
+        }
+        {
+            const mcon::Matrixd yx(mcon::Matrixd(y, true).Multiply(mcon::Matrixd(x)));
+            mcon::Matrixd b(a);
+            status = mcon::Ger(b, 0.5, y, x);
+            CHECK_VALUE(status, true);
+            for (size_t i = 0; i < row; ++i)
+            {
+                for (size_t j = 0; j < col; ++j)
+                {
+                    CHECK_VALUE(b[i][j], a[i][j] + 0.5 * yx[i][j]);
+                }
+            }
+            status = mcon::Ger(b, 0.5, x, y);
+            CHECK_VALUE(status, false);
+        }
+        {
+            const mcon::Matrixd xx(mcon::Matrixd(x, true).Multiply(mcon::Matrixd(x)));
+            const mcon::Matrixd xz(mcon::Matrixd(x, true).Multiply(mcon::Matrixd(z)));
+            mcon::Matrixd s1(s);
+            mcon::Matrixd s2(s);
+            status = mcon::Syr(s1, -0.5, x);
+            CHECK_VALUE(status, true);
+            status = mcon::Syr2(s2, 0.25, x, z);
+            CHECK_VALUE(status, true);
+            bool isSymmetric = true;
+            for (size_t i = 0; i < col; ++i)
+            {
+                for (size_t j = 0; j < col; ++j)
+                {
+                    CHECK_VALUE(s1[i][j], s[i][j] - 0.5 * xx[i][j]);
+                    CHECK_VALUE(s2[i][j], s[i][j] + 0.25 * (xz[i][j] + xz[j][i]));
+                    isSymmetric &= (s1[i][j] == s1[j][i] && s2[i][j] == s2[j][i]);
+                }
+            }
+            CHECK_VALUE(isSymmetric, true);
+            status = mcon::Syr(a, 1.0, x);
+            CHECK_VALUE(status, false);
+            status = mcon::Syr2(s1, 1.0, x, y);
+            CHECK_VALUE(status, false);
+        }
+    }
 
     return ;
 }
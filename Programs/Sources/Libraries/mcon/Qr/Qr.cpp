@@ -0,0 +1,359 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#include "debug.h"
+#include "mcon.h"
+#include "../Row.h"
+
+namespace {
+
+    // Columns are reflected in panels of this width.
+    const size_t g_QrPanelSize = 32;
+    // TSQR is chosen when the element count is larger than this...
+    const size_t g_TsqrParallelThreshold = 256 * 1024;
+    // ... and each of the row blocks has at least this times as many rows
+    // as the columns.
+    const size_t g_TsqrRowRatio = 4;
+
+} // anonymous
+
+namespace mcon {
+
+Qr::Qr()
+    : m_Factor()
+    , m_Tau()
+    , m_Diagonal()
+    , m_RowLength(0)
+    , m_ColumnLength(0)
+    , m_Blocks(NULL)
+    , m_BlockCount(0)
+{
+}
+
+Qr::~Qr()
+{
+    Clear();
+}
+
+void Qr::Clear(void)
+{
+    if (NULL != m_Blocks)
+    {
+        delete[] m_Blocks;
+        m_Blocks = NULL;
+    }
+    m_BlockCount = 0;
+    m_Factor.Resize(0, 0);
+    m_Tau.Resize(0);
+    m_Diagonal.Resize(0);
+    m_RowLength = 0;
+    m_ColumnLength = 0;
+}
+
+bool Qr::Factorize(const Matrix<double>& A, size_t threadCount)
+{
+    Clear();
+    if ( A.IsNull() || A.GetRowLength() < A.GetColumnLength() )
+    {
+        return false;
+    }
+    m_Factor = A.Transpose();
+    m_RowLength = A.GetRowLength();
+    m_ColumnLength = A.GetColumnLength();
+    return Decompose(threadCount);
+}
+
+bool Qr::Factorize(const TransposedMatrixd& A, size_t threadCount)
+{
+    Clear();
+    if ( A.IsNull() || A.GetRowLength() < A.GetColumnLength() )
+    {
+        return false;
+    }
+    m_Factor = A.GetOriginal();
+    m_RowLength = A.GetRowLength();
+    m_ColumnLength = A.GetColumnLength();
+    return Decompose(threadCount);
+}
+
+bool Qr::Decompose(size_t threadCount)
+{
+    const size_t N = m_ColumnLength;
+    const size_t M = m_RowLength;
+    threadCount = GetThreadCount(threadCount, M * N, g_TsqrParallelThreshold);
+    const size_t blockCount = std::min(threadCount, M / (g_TsqrRowRatio * N));
+    if ( blockCount <= 1 )
+    {
+        DecomposeBlocked();
+        return true;
+    }
+
+    // Each thread decomposes a contiguous range of rows.
+    m_Blocks = new Qr[blockCount];
+    m_BlockCount = blockCount;
+    ForRanges(DecomposeBlocks, *this, blockCount, blockCount);
+
+    // The R factors are stacked and decomposed once again.
+    Matrix<double> stacked(N, N * blockCount);
+    stacked = 0;
+    for (size_t t = 0; t < blockCount; ++t)
+    {
+        const Qr& block = m_Blocks[t];
+        for (size_t j = 0; j < N; ++j)
+        {
+            double* row = static_cast<double*>(stacked[j]) + N * t;
+            memcpy(row, block.m_Factor[j], j * sizeof(double));
+            row[j] = block.m_Diagonal[j];
+        }
+    }
+    m_Factor = stacked;
+    DecomposeBlocked();
+    return true;
+}
+
+void Qr::DecomposeBlocks(const Qr& qr, size_t begin, size_t end)
+{
+    for (size_t t = begin; t < end; ++t)
+    {
+        const size_t rowBegin = qr.m_RowLength * t / qr.m_BlockCount;
+        const size_t rowEnd = qr.m_RowLength * (t + 1) / qr.m_BlockCount;
+        qr.m_Blocks[t].DecomposeBlock(qr.m_Factor, rowBegin, rowEnd);
+    }
+}
+
+void Qr::DecomposeBlock(const Matrix<double>& At, size_t begin, size_t end)
+{
+    m_RowLength = end - begin;
+    m_ColumnLength = At.GetRowLength();
+    m_Factor.Resize(m_ColumnLength, m_RowLength);
+    for (size_t j = 0; j < m_ColumnLength; ++j)
+    {
+        memcpy(m_Factor[j], static_cast<const double*>(At[j]) + begin, m_RowLength * sizeof(double));
+    }
+    DecomposeBlocked();
+}
+
+void Qr::DecomposeBlocked(void)
+{
+    Matrix<double>& W = m_Factor;
+    const size_t N = W.GetRowLength();
+    const size_t M = W.GetColumnLength();
+    const size_t panel = g_QrPanelSize;
+    Matrix<double> T(panel, panel);
+    Vector<double> s(panel);
+
+    m_Tau.Resize(N);
+    m_Diagonal.Resize(N);
+
+    for (size_t kb = 0; kb < N; kb += panel)
+    {
+        const size_t width = std::min(panel, N - kb);
+
+        // Unblocked decomposition of the panel.
+        for (size_t i = 0; i < width; ++i)
+        {
+            const size_t k = kb + i;
+            double* v = static_cast<double*>(W[k]) + k;
+            const size_t length = M - k;
+            const double norm = sqrt(DotRow(v, v, length));
+            if ( 0 == norm )
+            {
+                m_Tau[k] = 0;
+                m_Diagonal[k] = 0;
+                continue;
+            }
+            // The sign avoids cancellation in v[0] = x[0] - alpha.
+            const double alpha = v[0] > 0 ? -norm : norm;
+            v[0] -= alpha;
+            const double tau = 2.0 / DotRow(v, v, length);
+            m_Tau[k] = tau;
+            m_Diagonal[k] = alpha;
+            for (size_t j = k + 1; j < kb + width; ++j)
+            {
+                double* w = static_cast<double*>(W[j]) + k;
+                AxpyRow(w, -tau * DotRow(v, w, length), v, length);
+            }
+        }
+        if ( kb + width >= N )
+        {
+            break;
+        }
+
+        // H_0 H_1 ... H_(b-1) = I - V T V^T, where T is upper triangular.
+        for (size_t i = 0; i < width; ++i)
+        {
+            const size_t k = kb + i;
+            const double* vi = static_cast<const double*>(W[k]) + k;
+            for (size_t r = 0; r < i; ++r)
+            {
+                s[r] = DotRow(static_cast<const double*>(W[kb + r]) + k, vi, M - k);
+            }
+            for (size_t r = 0; r < i; ++r)
+            {
+                double sum = 0;
+                for (size_t q = r; q < i; ++q)
+                {
+                    sum += T[r][q] * s[q];
+                }
+                T[r][i] = -m_Tau[k] * sum;
+            }
+            T[i][i] = m_Tau[k];
+        }
+
+        // The trailing columns are updated by (I - V T^T V^T).
+        for (size_t j = kb + width; j < N; ++j)
+        {
+            double* w = W[j];
+            for (size_t i = 0; i < width; ++i)
+            {
+                const size_t k = kb + i;
+                s[i] = DotRow(static_cast<const double*>(W[k]) + k, w + k, M - k);
+            }
+            for (size_t i = width; i > 0; --i)
+            {
+                double sum = 0;
+                for (size_t r = 0; r < i; ++r)
+                {
+                    sum += T[r][i - 1] * s[r];
+                }
+                s[i - 1] = sum;
+            }
+            for (size_t i = 0; i < width; ++i)
+            {
+                const size_t k = kb + i;
+                AxpyRow(w + k, -s[i], static_cast<const double*>(W[k]) + k, M - k);
+            }
+        }
+    }
+}
+
+void Qr::ApplyTransposedQ(double* c) const
+{
+    const size_t M = m_Factor.GetColumnLength();
+    for (size_t k = 0; k < m_Factor.GetRowLength(); ++k)
+    {
+        if ( 0 != m_Tau[k] )
+        {
+            const double* v = static_cast<const double*>(m_Factor[k]) + k;
+            AxpyRow(c + k, -m_Tau[k] * DotRow(v, c + k, M - k), v, M - k);
+        }
+    }
+}
+
+bool Qr::IsFullRank(void) const
+{
+    if ( IsNull() )
+    {
+        return false;
+    }
+    const double maximum = m_Diagonal.GetMaximumAbsolute();
+    const double tolerance = maximum * std::max(m_RowLength, m_ColumnLength) * DBL_EPSILON;
+    for (size_t k = 0; k < m_ColumnLength; ++k)
+    {
+        if ( fabs(m_Diagonal[k]) <= tolerance )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Qr::Solve(Vector<double>& x, const VectordBase& b, double* pResidual) const
+{
+    if ( b.GetLength() != m_RowLength || !IsFullRank() )
+    {
+        return false;
+    }
+    const size_t N = m_ColumnLength;
+    double residual = 0;
+    Vector<double> c;
+    if ( 0 == m_BlockCount )
+    {
+        c.Resize(m_RowLength);
+        memcpy(c, b, m_RowLength * sizeof(double));
+        ApplyTransposedQ(c);
+    }
+    else
+    {
+        // Q^T of each block, and then of the stacked R factors.
+        c.Resize(N * m_BlockCount);
+        size_t begin = 0;
+        for (size_t t = 0; t < m_BlockCount; ++t)
+        {
+            const Qr& block = m_Blocks[t];
+            Vector<double> cb(block.m_RowLength);
+            memcpy(cb, static_cast<const double*>(b) + begin, block.m_RowLength * sizeof(double));
+            block.ApplyTransposedQ(cb);
+            memcpy(static_cast<double*>(c) + N * t, cb, N * sizeof(double));
+            const double* tail = static_cast<const double*>(cb) + N;
+            residual += DotRow(tail, tail, block.m_RowLength - N);
+            begin += block.m_RowLength;
+        }
+        ApplyTransposedQ(c);
+    }
+    const double* tail = static_cast<const double*>(c) + N;
+    residual += DotRow(tail, tail, c.GetLength() - N);
+
+    // R x = (Q^T b)[0:N]
+    x.Resize(N);
+    for (size_t k = N; k > 0; --k)
+    {
+        const size_t i = k - 1;
+        double sum = c[i];
+        for (size_t j = k; j < N; ++j)
+        {
+            sum -= m_Factor[j][i] * x[j];
+        }
+        x[i] = sum / m_Diagonal[i];
+    }
+    if ( NULL != pResidual )
+    {
+        *pResidual = sqrt(residual);
+    }
+    return true;
+}
+
+Matrix<double> Qr::GetR(void) const
+{
+    const size_t N = m_ColumnLength;
+    Matrix<double> R(N, N);
+    R = 0;
+    for (size_t i = 0; i < N; ++i)
+    {
+        R[i][i] = m_Diagonal[i];
+        for (size_t j = i + 1; j < N; ++j)
+        {
+            R[i][j] = m_Factor[j][i];
+        }
+    }
+    return R;
+}
+
+} // namespace mcon {
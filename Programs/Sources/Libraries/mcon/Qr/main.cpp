@@ -0,0 +1,11 @@
+
+#include "mcon.h"
+
+extern void test_Qr(void);
+
+int main(void)
+{
+    test_Qr();
+
+    return 0;
+}
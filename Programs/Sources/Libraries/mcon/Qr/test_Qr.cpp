@@ -0,0 +1,191 @@
+
+#include <algorithm>
+#include <math.h>
+
+#include "mcon.h"
+#include "../TestHelper.h"
+
+namespace {
+
+// Shifted on the diagonal, so that the matrix has the full rank.
+double ShiftedElement(size_t i, size_t M, size_t j, size_t N)
+{
+    UNUSED(M);
+    UNUSED(N);
+    return sin(0.37 * (i + 1) * (j + 2)) + cos(0.11 * i) + ((i == j) ? 2.0 : 0.0);
+}
+
+// x = (A^T A)^(-1) A^T b
+mcon::Vectord SolveNormalEquation(const mcon::Matrixd& A, const mcon::VectordBase& b)
+{
+    const mcon::Matrixd inv(A.T().Multiply(A).Inverse());
+    mcon::Vectord Atb(A.GetColumnLength());
+    mcon::Gemv(Atb, A.T(), b);
+    mcon::Vectord x(A.GetColumnLength());
+    mcon::Gemv(x, inv, Atb);
+    return x;
+}
+
+} // anonymous
+
+void test_Qr(void)
+{
+    LOG("* [Empty]\n");
+    {
+        mcon::Qr qr;
+        CHECK_VALUE(qr.IsNull(), true);
+        CHECK_VALUE(qr.IsFullRank(), false);
+        mcon::Matrixd A;
+        CHECK_VALUE(qr.Factorize(A), false);
+        A.Resize(2, 3);
+        A = 1.0;
+        CHECK_VALUE(qr.Factorize(A), false);
+        mcon::Vectord x;
+        mcon::Vectord b(2);
+        CHECK_VALUE(qr.Solve(x, b), false);
+    }
+    LOG("* [Square]\n");
+    {
+        const size_t n = 5;
+        mcon::Matrixd A(n, n);
+        A.Initialize(ShiftedElement);
+        mcon::Vectord b(n);
+        b.Initialize(Signal);
+        b += 1.0;
+
+        mcon::Qr qr;
+        bool status = qr.Factorize(A);
+        CHECK_VALUE(status, true);
+        CHECK_VALUE(qr.GetRowLength(), n);
+        CHECK_VALUE(qr.GetColumnLength(), n);
+        CHECK_VALUE(qr.IsFullRank(), true);
+
+        // A^T A = R^T R
+        const mcon::Matrixd R(qr.GetR());
+        CHECK_VALUE(GetMaximumDifference(R.T().Multiply(R), A.T().Multiply(A)), 0);
+        bool isUpper = true;
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                isUpper &= (0 == R[i][j]);
+            }
+        }
+        CHECK_VALUE(isUpper, true);
+
+        mcon::Vectord x;
+        double residual = 1.0;
+        status = qr.Solve(x, b, &residual);
+        CHECK_VALUE(status, true);
+        CHECK_VALUE(x.GetLength(), n);
+        CHECK_VALUE(residual, 0);
+        mcon::Vectord Ax(n);
+        mcon::Gemv(Ax, A, x);
+        Ax -= b;
+        CHECK_VALUE(Ax.GetMaximumAbsolute(), 0);
+    }
+    LOG("* [Least squares]\n");
+    {
+        // (M, N): the panel width is 32.
+        const size_t sizes[][2] = { {1, 1}, {7, 3}, {40, 33}, {200, 70}, {300, 100} };
+        for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+        {
+            const size_t M = sizes[i][0];
+            const size_t N = sizes[i][1];
+            LOG("    M=%d, N=%d\n", static_cast<int>(M), static_cast<int>(N));
+            mcon::Matrixd A(M, N);
+            A.Initialize(ShiftedElement);
+            mcon::Vectord b(M);
+            b.Initialize(Signal);
+            b += 1.0;
+
+            mcon::Qr qr;
+            bool status = qr.Factorize(A, 1);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(qr.GetBlockCount(), 1);
+            mcon::Vectord x;
+            double residual = 0;
+            status = qr.Solve(x, b, &residual);
+            CHECK_VALUE(status, true);
+
+            mcon::Vectord expected(SolveNormalEquation(A, b));
+            expected -= x;
+            CHECK_VALUE(expected.GetMaximumAbsolute() / x.GetMaximumAbsolute(), 0);
+
+            mcon::Vectord r(M);
+            mcon::Gemv(r, A, x);
+            r -= b;
+            CHECK_VALUE(r.GetNorm(), residual);
+
+            // The residual is orthogonal to the columns.
+            mcon::Vectord Atr(N);
+            mcon::Gemv(Atr, A.T(), r);
+            CHECK_VALUE(Atr.GetMaximumAbsolute(), 0);
+        }
+    }
+    LOG("* [TSQR]\n");
+    {
+        const size_t M = 2000;
+        const size_t N = 40;
+        mcon::Matrixd At(N, M);
+        for (size_t j = 0; j < N; ++j)
+        {
+            for (size_t i = 0; i < M; ++i)
+            {
+                At[j][i] = ShiftedElement(i, M, j, N);
+            }
+        }
+        mcon::Vectord b(M);
+        b.Initialize(Signal);
+
+        mcon::Qr serial;
+        bool status = serial.Factorize(At.T(), 1);
+        CHECK_VALUE(status, true);
+        mcon::Vectord xs;
+        double rs = 0;
+        status = serial.Solve(xs, b, &rs);
+        CHECK_VALUE(status, true);
+
+        const size_t counts[] = {2, 3, 4, 100};
+        for (size_t i = 0; i < sizeof(counts)/sizeof(counts[0]); ++i)
+        {
+            LOG("    threads=%d\n", static_cast<int>(counts[i]));
+            mcon::Qr qr;
+            status = qr.Factorize(At.T(), counts[i]);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(qr.GetBlockCount(), std::min(counts[i], M / (4 * N)));
+            CHECK_VALUE(qr.GetRowLength(), M);
+            CHECK_VALUE(qr.GetColumnLength(), N);
+            mcon::Vectord x;
+            double residual = 0;
+            status = qr.Solve(x, b, &residual);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(residual, rs);
+            x -= xs;
+            CHECK_VALUE(x.GetMaximumAbsolute(), 0);
+
+            // R differs from the serial one only in the signs of its rows.
+            const mcon::Matrixd R(qr.GetR());
+            const mcon::Matrixd Rs(serial.GetR());
+            CHECK_VALUE(GetMaximumDifference(R.T().Multiply(R), Rs.T().Multiply(Rs)), 0);
+        }
+    }
+    LOG("* [Rank deficient]\n");
+    {
+        mcon::Matrixd A(6, 3);
+        A.Initialize(ShiftedElement);
+        for (size_t i = 0; i < A.GetRowLength(); ++i)
+        {
+            A[i][2] = A[i][0] * 2.0 - A[i][1];
+        }
+        mcon::Qr qr;
+        bool status = qr.Factorize(A);
+        CHECK_VALUE(status, true);
+        CHECK_VALUE(qr.IsFullRank(), false);
+        mcon::Vectord x;
+        mcon::Vectord b(6);
+        b = 1.0;
+        status = qr.Solve(x, b);
+        CHECK_VALUE(status, false);
+    }
+}
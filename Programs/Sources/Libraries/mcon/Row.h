@@ -0,0 +1,109 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <x86intrin.h>
+
+// AVX kernels on contiguous rows shared by the modules of mcon. This is
+// not installed; the modules include it by the relative path.
+
+namespace mcon {
+
+// y[k] += a * x[k] for k in [0, n)
+inline void AxpyRow(double* y, double a, const double* x, size_t n)
+{
+    const __m256d av = _mm256_set1_pd(a);
+    size_t k = 0;
+    for ( ; k + 4 <= n; k += 4)
+    {
+        const __m256d yv = _mm256_loadu_pd(y + k);
+        _mm256_storeu_pd(y + k, _mm256_add_pd(yv, _mm256_mul_pd(av, _mm256_loadu_pd(x + k))));
+    }
+    for ( ; k < n; ++k)
+    {
+        y[k] += a * x[k];
+    }
+}
+
+inline void AxpyRow(float* y, float a, const float* x, size_t n)
+{
+    const __m256 av = _mm256_set1_ps(a);
+    size_t k = 0;
+    for ( ; k + 8 <= n; k += 8)
+    {
+        const __m256 yv = _mm256_loadu_ps(y + k);
+        _mm256_storeu_ps(y + k, _mm256_add_ps(yv, _mm256_mul_ps(av, _mm256_loadu_ps(x + k))));
+    }
+    for ( ; k < n; ++k)
+    {
+        y[k] += a * x[k];
+    }
+}
+
+// Returns the sum of the four lanes, paired as (0 + 1) + (2 + 3).
+inline double SumLanes(__m256d v)
+{
+    double s[4];
+    _mm256_storeu_pd(s, v);
+    return (s[0] + s[1]) + (s[2] + s[3]);
+}
+
+// Returns sum_k a[k] * b[k] for k in [0, n)
+inline double DotRow(const double* a, const double* b, size_t n)
+{
+    __m256d sum = _mm256_setzero_pd();
+    size_t k = 0;
+    for ( ; k + 4 <= n; k += 4)
+    {
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k)));
+    }
+    double dot = SumLanes(sum);
+    for ( ; k < n; ++k)
+    {
+        dot += a[k] * b[k];
+    }
+    return dot;
+}
+
+inline float DotRow(const float* a, const float* b, size_t n)
+{
+    __m256 sum = _mm256_setzero_ps();
+    size_t k = 0;
+    for ( ; k + 8 <= n; k += 8)
+    {
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k)));
+    }
+    float s[8];
+    _mm256_storeu_ps(s, sum);
+    float dot = ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+    for ( ; k < n; ++k)
+    {
+        dot += a[k] * b[k];
+    }
+    return dot;
+}
+
+} // mcon
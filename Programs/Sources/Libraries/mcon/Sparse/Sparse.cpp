@@ -0,0 +1,442 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <string.h>
+
+#include "debug.h"
+#include "mcon.h"
+
+namespace mcon {
+
+/*--------------------------------------------------------------------
+ * Diagonal
+ *--------------------------------------------------------------------*/
+
+Diagonal::Diagonal(size_t length)
+    : m_Diagonal(length)
+{
+}
+
+Diagonal::Diagonal(const VectordBase& d)
+    : m_Diagonal(d)
+{
+}
+
+Diagonal::Diagonal(const Diagonal& d)
+    : m_Diagonal(d.m_Diagonal)
+{
+}
+
+Diagonal::~Diagonal()
+{
+}
+
+Diagonal& Diagonal::operator=(const Diagonal& d)
+{
+    m_Diagonal = d.m_Diagonal;
+    return *this;
+}
+
+Vector<double> Diagonal::Multiply(const VectordBase& x) const
+{
+    if ( x.GetLength() != GetLength() || IsNull() )
+    {
+        return Vector<double>();
+    }
+    Vector<double> y(x);
+    y *= m_Diagonal;
+    return y;
+}
+
+Matrix<double> Diagonal::Multiply(const Matrix<double>& A) const
+{
+    if ( A.GetRowLength() != GetLength() || IsNull() )
+    {
+        return Matrix<double>();
+    }
+    Matrix<double> DA(A);
+    for (size_t i = 0; i < DA.GetRowLength(); ++i)
+    {
+        DA[i] *= m_Diagonal[i];
+    }
+    return DA;
+}
+
+Matrix<double> Diagonal::MultiplyGram(const Matrix<double>& A) const
+{
+    if ( A.GetColumnLength() != GetLength() || IsNull() )
+    {
+        return Matrix<double>();
+    }
+    const size_t M = A.GetRowLength();
+    // A D scales the columns, and then the rows of (A D) and A are
+    // paired for the upper triangle in O(M^2 N / 2).
+    Matrix<double> AD(A);
+    for (size_t i = 0; i < M; ++i)
+    {
+        AD[i] *= m_Diagonal;
+    }
+    Matrix<double> G(M, M);
+    for (size_t i = 0; i < M; ++i)
+    {
+        for (size_t j = i; j < M; ++j)
+        {
+            G[i][j] = AD[i].Dot(A[j]);
+            G[j][i] = G[i][j];
+        }
+    }
+    return G;
+}
+
+Matrix<double> Diagonal::ToMatrix(void) const
+{
+    const size_t N = GetLength();
+    Matrix<double> m(N, N);
+    m = 0;
+    for (size_t i = 0; i < N; ++i)
+    {
+        m[i][i] = m_Diagonal[i];
+    }
+    return m;
+}
+
+/*--------------------------------------------------------------------
+ * SparseMatrix
+ *--------------------------------------------------------------------*/
+
+SparseMatrix::SparseMatrix(size_t rowLength, size_t columnLength)
+    : m_RowLength(0)
+    , m_ColumnLength(0)
+    , m_Count(0)
+    , m_Capacity(0)
+    , m_LastRow(0)
+    , m_RowOffsets(NULL)
+    , m_Columns(NULL)
+    , m_Values(NULL)
+{
+    bool status = Allocate(rowLength, columnLength, 0);
+    UNUSED(status);
+    ASSERT(true == status);
+}
+
+SparseMatrix::SparseMatrix(const Matrix<double>& m, double threshold)
+    : m_RowLength(0)
+    , m_ColumnLength(0)
+    , m_Count(0)
+    , m_Capacity(0)
+    , m_LastRow(0)
+    , m_RowOffsets(NULL)
+    , m_Columns(NULL)
+    , m_Values(NULL)
+{
+    bool status = Allocate(m.GetRowLength(), m.GetColumnLength(), 0);
+    UNUSED(status);
+    ASSERT(true == status);
+    for (size_t i = 0; i < m.GetRowLength(); ++i)
+    {
+        for (size_t j = 0; j < m.GetColumnLength(); ++j)
+        {
+            const double v = m[i][j];
+            if ( v > threshold || -v > threshold )
+            {
+                Append(i, j, v);
+            }
+        }
+    }
+}
+
+SparseMatrix::SparseMatrix(const SparseMatrix& m)
+    : m_RowLength(0)
+    , m_ColumnLength(0)
+    , m_Count(0)
+    , m_Capacity(0)
+    , m_LastRow(0)
+    , m_RowOffsets(NULL)
+    , m_Columns(NULL)
+    , m_Values(NULL)
+{
+    *this = m;
+}
+
+SparseMatrix::~SparseMatrix()
+{
+    Release();
+}
+
+SparseMatrix& SparseMatrix::operator=(const SparseMatrix& m)
+{
+    if ( this == &m )
+    {
+        return *this;
+    }
+    Release();
+    bool status = Allocate(m.GetRowLength(), m.GetColumnLength(), m.GetNonZeroCount());
+    UNUSED(status);
+    ASSERT(true == status);
+    m_Count = m.m_Count;
+    m_LastRow = m.m_LastRow;
+    memcpy(m_RowOffsets, m.m_RowOffsets, (m_RowLength + 1) * sizeof(size_t));
+    memcpy(m_Columns, m.m_Columns, m_Count * sizeof(size_t));
+    memcpy(m_Values, m.m_Values, m_Count * sizeof(double));
+    return *this;
+}
+
+bool SparseMatrix::Allocate(size_t rowLength, size_t columnLength, size_t capacity)
+{
+    m_RowLength = rowLength;
+    m_ColumnLength = columnLength;
+    m_Count = 0;
+    m_LastRow = 0;
+    m_RowOffsets = new size_t[rowLength + 1];
+    if ( NULL == m_RowOffsets )
+    {
+        return false;
+    }
+    m_RowOffsets[0] = 0;
+    return Reserve(capacity);
+}
+
+void SparseMatrix::Release(void)
+{
+    delete[] m_RowOffsets;
+    delete[] m_Columns;
+    delete[] m_Values;
+    m_RowOffsets = NULL;
+    m_Columns = NULL;
+    m_Values = NULL;
+    m_Capacity = 0;
+    m_Count = 0;
+}
+
+bool SparseMatrix::Reserve(size_t capacity)
+{
+    if ( capacity <= m_Capacity )
+    {
+        return true;
+    }
+    size_t* columns = new size_t[capacity];
+    double* values = new double[capacity];
+    if ( NULL == columns || NULL == values )
+    {
+        delete[] columns;
+        delete[] values;
+        return false;
+    }
+    if ( 0 < m_Count )
+    {
+        memcpy(columns, m_Columns, m_Count * sizeof(size_t));
+        memcpy(values, m_Values, m_Count * sizeof(double));
+    }
+    delete[] m_Columns;
+    delete[] m_Values;
+    m_Columns = columns;
+    m_Values = values;
+    m_Capacity = capacity;
+    return true;
+}
+
+double SparseMatrix::operator()(size_t row, size_t column) const
+{
+    ASSERT(row < GetRowLength() && column < GetColumnLength());
+    const size_t* begin = m_Columns + GetRowBegin(row);
+    const size_t* end = m_Columns + GetRowEnd(row);
+    const size_t* found = std::lower_bound(begin, end, column);
+    return (found != end && *found == column) ? m_Values[found - m_Columns] : 0.0;
+}
+
+bool SparseMatrix::Append(size_t row, size_t column, double value)
+{
+    if ( row >= m_RowLength || column >= m_ColumnLength )
+    {
+        return false;
+    }
+    if ( 0 < m_Count && (row < m_LastRow || (row == m_LastRow && column <= m_Columns[m_Count - 1])) )
+    {
+        return false;
+    }
+    if ( m_Count == m_Capacity && !Reserve(std::max(static_cast<size_t>(16), m_Capacity * 2)) )
+    {
+        return false;
+    }
+    // The rows skipped over are closed as empty.
+    for (size_t r = m_LastRow + 1; r <= row; ++r)
+    {
+        m_RowOffsets[r] = m_Count;
+    }
+    m_LastRow = row;
+    m_Columns[m_Count] = column;
+    m_Values[m_Count] = value;
+    ++m_Count;
+    return true;
+}
+
+Vector<double> SparseMatrix::Multiply(const VectordBase& x) const
+{
+    Vector<double> y;
+    if ( x.GetLength() != GetColumnLength() || IsNull() )
+    {
+        return y;
+    }
+    y.Resize(GetRowLength());
+    for (size_t r = 0; r < GetRowLength(); ++r)
+    {
+        double sum = 0;
+        for (size_t e = GetRowBegin(r); e < GetRowEnd(r); ++e)
+        {
+            sum += m_Values[e] * x[m_Columns[e]];
+        }
+        y[r] = sum;
+    }
+    return y;
+}
+
+Vector<double> SparseMatrix::MultiplyTransposed(const VectordBase& x) const
+{
+    Vector<double> y;
+    if ( x.GetLength() != GetRowLength() || IsNull() )
+    {
+        return y;
+    }
+    y.Resize(GetColumnLength());
+    y = 0;
+    for (size_t r = 0; r < GetRowLength(); ++r)
+    {
+        for (size_t e = GetRowBegin(r); e < GetRowEnd(r); ++e)
+        {
+            y[m_Columns[e]] += m_Values[e] * x[r];
+        }
+    }
+    return y;
+}
+
+Matrix<double> SparseMatrix::Multiply(const Matrix<double>& B) const
+{
+    if ( B.GetRowLength() != GetColumnLength() || IsNull() )
+    {
+        return Matrix<double>();
+    }
+    Matrix<double> AB(GetRowLength(), B.GetColumnLength());
+    AB = 0;
+    for (size_t r = 0; r < GetRowLength(); ++r)
+    {
+        for (size_t e = GetRowBegin(r); e < GetRowEnd(r); ++e)
+        {
+            mcon::Axpy(AB[r], m_Values[e], B[m_Columns[e]]);
+        }
+    }
+    return AB;
+}
+
+Matrix<double> SparseMatrix::MultiplyGram(const Matrix<double>& B) const
+{
+    if ( B.GetColumnLength() != GetRowLength() || GetRowLength() != GetColumnLength() || IsNull() )
+    {
+        return Matrix<double>();
+    }
+    const size_t K = B.GetRowLength();
+    // B A costs O(K nnz), and then its rows are paired with those of B.
+    Matrix<double> BA(K, GetColumnLength());
+    BA = 0;
+    for (size_t k = 0; k < K; ++k)
+    {
+        VectordBase& dst = BA[k];
+        const VectordBase& src = B[k];
+        for (size_t r = 0; r < GetRowLength(); ++r)
+        {
+            const double b = src[r];
+            if ( 0 == b )
+            {
+                continue;
+            }
+            for (size_t e = GetRowBegin(r); e < GetRowEnd(r); ++e)
+            {
+                dst[m_Columns[e]] += b * m_Values[e];
+            }
+        }
+    }
+    Matrix<double> G(K, K);
+    for (size_t k = 0; k < K; ++k)
+    {
+        for (size_t l = 0; l < K; ++l)
+        {
+            G[k][l] = BA[k].Dot(B[l]);
+        }
+    }
+    return G;
+}
+
+Matrix<double> SparseMatrix::MultiplyGram(const ToeplitzOperator& B) const
+{
+    if ( B.GetColumnLength() != GetRowLength() || GetRowLength() != GetColumnLength() || IsNull() || B.IsNull() )
+    {
+        return Matrix<double>();
+    }
+    const size_t K = B.GetRowLength();
+    // G[k][l] = sum of B[k][r] A[r][c] B[l][c] over the non-zero A[r][c],
+    // where only B[k][r] and B[l][c] inside the signal contribute.
+    Matrix<double> G(K, K);
+    G = 0;
+    for (size_t r = 0; r < GetRowLength(); ++r)
+    {
+        for (size_t e = GetRowBegin(r); e < GetRowEnd(r); ++e)
+        {
+            const size_t c = m_Columns[e];
+            for (size_t k = 0; k < K; ++k)
+            {
+                const double a = B(k, r) * m_Values[e];
+                if ( 0 == a )
+                {
+                    continue;
+                }
+                VectordBase& row = G[k];
+                for (size_t l = 0; l < K; ++l)
+                {
+                    row[l] += a * B(l, c);
+                }
+            }
+        }
+    }
+    return G;
+}
+
+Matrix<double> SparseMatrix::ToMatrix(void) const
+{
+    if ( IsNull() )
+    {
+        return Matrix<double>();
+    }
+    Matrix<double> m(GetRowLength(), GetColumnLength());
+    m = 0;
+    for (size_t r = 0; r < GetRowLength(); ++r)
+    {
+        for (size_t e = GetRowBegin(r); e < GetRowEnd(r); ++e)
+        {
+            m[r][m_Columns[e]] = m_Values[e];
+        }
+    }
+    return m;
+}
+
+} // namespace mcon {
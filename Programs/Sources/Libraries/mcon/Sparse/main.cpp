@@ -0,0 +1,11 @@
+
+#include "mcon.h"
+
+extern void test_Sparse(void);
+
+int main(void)
+{
+    test_Sparse();
+
+    return 0;
+}
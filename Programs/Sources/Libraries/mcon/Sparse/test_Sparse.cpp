@@ -0,0 +1,153 @@
+
+#include <algorithm>
+#include <math.h>
+
+#include "mcon.h"
+#include "../TestHelper.h"
+
+namespace {
+
+double Weight(size_t k, size_t n)
+{
+    UNUSED(n);
+    return 1.0 + 0.5 * sin(0.3 * k);
+}
+
+// A tridiagonal matrix.
+mcon::SparseMatrix GetBanded(size_t N)
+{
+    mcon::SparseMatrix A(N, N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        if ( i > 0 )
+        {
+            A.Append(i, i - 1, -0.5);
+        }
+        A.Append(i, i, 2.0 + Weight(i, N));
+        if ( i + 1 < N )
+        {
+            A.Append(i, i + 1, -0.5);
+        }
+    }
+    return A;
+}
+
+} // anonymous
+
+void test_Sparse(void)
+{
+    LOG("* [Diagonal]\n");
+    {
+        const size_t M = 7;
+        const size_t N = 20;
+        mcon::Vectord w(N);
+        w.Initialize(Weight);
+        const mcon::Diagonal D(w);
+        const mcon::Matrixd dense(D.ToMatrix());
+        CHECK_VALUE(D.GetLength(), N);
+        CHECK_VALUE(D(3, 3), w[3]);
+        CHECK_VALUE(D(3, 4), 0);
+
+        mcon::Matrixd A(M, N);
+        A.Initialize(Element);
+        const mcon::Matrixd expected(A.Multiply(dense).Multiply(A.T()));
+        const mcon::Matrixd G(D.MultiplyGram(A));
+        CHECK_VALUE(GetMaximumDifference(G, expected), 0);
+        bool isSymmetric = true;
+        for (size_t i = 0; i < M; ++i)
+        {
+            for (size_t j = 0; j < M; ++j)
+            {
+                isSymmetric &= (G[i][j] == G[j][i]);
+            }
+        }
+        CHECK_VALUE(isSymmetric, true);
+
+        const mcon::Matrixd At(A.Transpose());
+        CHECK_VALUE(GetMaximumDifference(D.Multiply(At), dense.Multiply(At)), 0);
+
+        mcon::Vectord x(N);
+        x.Initialize(Weight);
+        mcon::Vectord y(D.Multiply(x));
+        mcon::Vectord yd(N);
+        mcon::Gemv(yd, dense, x);
+        y -= yd;
+        CHECK_VALUE(y.GetMaximumAbsolute(), 0);
+
+        CHECK_VALUE(D.MultiplyGram(At).IsNull(), true);
+        CHECK_VALUE(D.Multiply(A).IsNull(), true);
+        CHECK_VALUE(mcon::Diagonal().Multiply(x).IsNull(), true);
+    }
+    LOG("* [Sparse]\n");
+    {
+        mcon::SparseMatrix S;
+        CHECK_VALUE(S.IsNull(), true);
+        CHECK_VALUE(S.GetNonZeroCount(), 0);
+
+        mcon::SparseMatrix A(4, 5);
+        bool status = A.Append(0, 1, 1.0);
+        CHECK_VALUE(status, true);
+        status = A.Append(2, 0, 2.0);
+        CHECK_VALUE(status, true);
+        status = A.Append(2, 4, 3.0);
+        CHECK_VALUE(status, true);
+        // Out of order or out of range.
+        status = A.Append(2, 4, 4.0);
+        CHECK_VALUE(status, false);
+        status = A.Append(1, 0, 4.0);
+        CHECK_VALUE(status, false);
+        status = A.Append(3, 5, 4.0);
+        CHECK_VALUE(status, false);
+        CHECK_VALUE(A.GetNonZeroCount(), 3);
+        CHECK_VALUE(A(0, 1), 1.0);
+        CHECK_VALUE(A(1, 1), 0.0);
+        CHECK_VALUE(A(2, 0), 2.0);
+        CHECK_VALUE(A(2, 3), 0.0);
+        CHECK_VALUE(A(2, 4), 3.0);
+        CHECK_VALUE(A(3, 4), 0.0);
+
+        const mcon::Matrixd dense(A.ToMatrix());
+        const mcon::SparseMatrix B(dense);
+        CHECK_VALUE(B.GetNonZeroCount(), 3);
+        CHECK_VALUE(GetMaximumDifference(B.ToMatrix(), dense), 0);
+        mcon::SparseMatrix C(B);
+        C = A;
+        CHECK_VALUE(GetMaximumDifference(C.ToMatrix(), dense), 0);
+    }
+    LOG("* [Sparse multiplication]\n");
+    {
+        const size_t M = 9;
+        const size_t N = 30;
+        const mcon::SparseMatrix W(GetBanded(N));
+        const mcon::Matrixd dense(W.ToMatrix());
+        CHECK_VALUE(W.GetNonZeroCount(), 3 * N - 2);
+
+        mcon::Vectord x(N);
+        x.Initialize(Weight);
+        mcon::Vectord y(W.Multiply(x));
+        mcon::Vectord yd(N);
+        mcon::Gemv(yd, dense, x);
+        y -= yd;
+        CHECK_VALUE(y.GetMaximumAbsolute(), 0);
+
+        mcon::Vectord z(W.MultiplyTransposed(x));
+        mcon::Gemv(yd, dense.T(), x);
+        z -= yd;
+        CHECK_VALUE(z.GetMaximumAbsolute(), 0);
+
+        mcon::Matrixd A(M, N);
+        A.Initialize(Element);
+        const mcon::Matrixd At(A.Transpose());
+        CHECK_VALUE(GetMaximumDifference(W.Multiply(At), dense.Multiply(At)), 0);
+        CHECK_VALUE(GetMaximumDifference(W.MultiplyGram(A), A.Multiply(dense).Multiply(At)), 0);
+        for (int hankel = 0; hankel < 2; ++hankel)
+        {
+            const mcon::ToeplitzOperator B(x(0, N - 4), M, N, hankel != 0);
+            CHECK_VALUE(GetMaximumDifference(W.MultiplyGram(B), W.MultiplyGram(B.ToMatrix())), 0);
+        }
+
+        CHECK_VALUE(W.MultiplyGram(At).IsNull(), true);
+        CHECK_VALUE(W.Multiply(A).IsNull(), true);
+        CHECK_VALUE(W.Multiply(y(0, N - 1)).IsNull(), true);
+    }
+}
@@ -0,0 +1,309 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <x86intrin.h>
+
+#include "debug.h"
+#include "mcon.h"
+#include "../Row.h"
+
+namespace {
+
+    using mcon::SumLanes;
+
+    // The block of K which the micro kernel walks through at once, so
+    // that the six rows of A stay in L1.
+    const size_t g_SyrkDepth = 512;
+    // The block of the rows of A which are reused from L2 against each
+    // pair of the rows.
+    const size_t g_SyrkWidth = 64;
+
+    // c[r][s] = a[r] . b[s] for the 2 x 4 rows, where each a[r] is
+    // loaded once for the four b[s] and 8 of the 16 registers hold the
+    // sums.
+    inline void DotTile(double c[2][4], const double* const a[2], const double* const b[4], size_t n)
+    {
+        __m256d s00 = _mm256_setzero_pd(), s01 = _mm256_setzero_pd(), s02 = _mm256_setzero_pd(), s03 = _mm256_setzero_pd();
+        __m256d s10 = _mm256_setzero_pd(), s11 = _mm256_setzero_pd(), s12 = _mm256_setzero_pd(), s13 = _mm256_setzero_pd();
+        size_t k = 0;
+        for ( ; k + 4 <= n; k += 4)
+        {
+            const __m256d a0 = _mm256_loadu_pd(a[0] + k);
+            const __m256d a1 = _mm256_loadu_pd(a[1] + k);
+            __m256d bv = _mm256_loadu_pd(b[0] + k);
+            s00 = _mm256_add_pd(s00, _mm256_mul_pd(a0, bv));
+            s10 = _mm256_add_pd(s10, _mm256_mul_pd(a1, bv));
+            bv = _mm256_loadu_pd(b[1] + k);
+            s01 = _mm256_add_pd(s01, _mm256_mul_pd(a0, bv));
+            s11 = _mm256_add_pd(s11, _mm256_mul_pd(a1, bv));
+            bv = _mm256_loadu_pd(b[2] + k);
+            s02 = _mm256_add_pd(s02, _mm256_mul_pd(a0, bv));
+            s12 = _mm256_add_pd(s12, _mm256_mul_pd(a1, bv));
+            bv = _mm256_loadu_pd(b[3] + k);
+            s03 = _mm256_add_pd(s03, _mm256_mul_pd(a0, bv));
+            s13 = _mm256_add_pd(s13, _mm256_mul_pd(a1, bv));
+        }
+        c[0][0] = SumLanes(s00); c[0][1] = SumLanes(s01); c[0][2] = SumLanes(s02); c[0][3] = SumLanes(s03);
+        c[1][0] = SumLanes(s10); c[1][1] = SumLanes(s11); c[1][2] = SumLanes(s12); c[1][3] = SumLanes(s13);
+        for ( ; k < n; ++k)
+        {
+            for (size_t r = 0; r < 2; ++r)
+            {
+                for (size_t s = 0; s < 4; ++s)
+                {
+                    c[r][s] += a[r][k] * b[s][k];
+                }
+            }
+        }
+    }
+
+} // anonymous
+
+namespace mcon {
+
+SymmetricMatrix::SymmetricMatrix(size_t length)
+    : m_Length(length)
+    , m_Packed(length * (length + 1) / 2)
+{
+}
+
+SymmetricMatrix::SymmetricMatrix(const Matrix<double>& m)
+    : m_Length(0)
+    , m_Packed()
+{
+    if ( m.IsNull() || m.GetRowLength() != m.GetColumnLength() )
+    {
+        return;
+    }
+    Resize(m.GetRowLength());
+    for (size_t i = 0; i < m_Length; ++i)
+    {
+        const double* src = m[i];
+        std::copy(src + i, src + m_Length, GetRow(i));
+    }
+}
+
+SymmetricMatrix::SymmetricMatrix(const SymmetricMatrix& m)
+    : m_Length(m.m_Length)
+    , m_Packed(m.m_Packed)
+{
+}
+
+SymmetricMatrix::~SymmetricMatrix()
+{
+}
+
+SymmetricMatrix& SymmetricMatrix::operator=(const SymmetricMatrix& m)
+{
+    m_Length = m.m_Length;
+    m_Packed = m.m_Packed;
+    return *this;
+}
+
+SymmetricMatrix& SymmetricMatrix::operator=(double v)
+{
+    m_Packed = v;
+    return *this;
+}
+
+bool SymmetricMatrix::Resize(size_t length)
+{
+    if ( !m_Packed.Resize(length * (length + 1) / 2) )
+    {
+        return false;
+    }
+    m_Length = length;
+    return true;
+}
+
+Vector<double> SymmetricMatrix::Multiply(const VectordBase& x) const
+{
+    const size_t n = GetLength();
+    if ( IsNull() || x.GetLength() != n )
+    {
+        return Vector<double>();
+    }
+    // The row i contributes to y[i] by the dot product and to y[j > i]
+    // as the column i of the lower part.
+    Vector<double> y(n);
+    y = 0;
+    const double* px = x;
+    double* py = y;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double* row = GetRow(i);
+        py[i] += DotRow(row, px + i, n - i);
+        AxpyRow(py + i + 1, px[i], row + 1, n - i - 1);
+    }
+    return y;
+}
+
+bool SymmetricMatrix::Solve(Vector<double>& x, const VectordBase& b) const
+{
+    const size_t n = GetLength();
+    if ( IsNull() || b.GetLength() != n )
+    {
+        return false;
+    }
+    // A = U^T U in place of a copy, where the row k of U is scaled and
+    // subtracted from the trailing rows along the packed rows.
+    SymmetricMatrix U(*this);
+    for (size_t k = 0; k < n; ++k)
+    {
+        double* uk = U.GetRow(k);
+        if ( !(uk[0] > 0) )
+        {
+            return false;
+        }
+        const double d = sqrt(uk[0]);
+        const double rd = 1.0 / d;
+        uk[0] = d;
+        for (size_t j = 1; j < n - k; ++j)
+        {
+            uk[j] *= rd;
+        }
+        for (size_t i = k + 1; i < n; ++i)
+        {
+            AxpyRow(U.GetRow(i), -uk[i - k], uk + i - k, n - i);
+        }
+    }
+    x = b;
+    double* const px = x;
+    // U^T y = b
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double* u = U.GetRow(i);
+        px[i] /= u[0];
+        AxpyRow(px + i + 1, -px[i], u + 1, n - i - 1);
+    }
+    // U x = y
+    for (size_t i = n; i > 0; --i)
+    {
+        const double* u = U.GetRow(i - 1);
+        px[i - 1] = (px[i - 1] - DotRow(u + 1, px + i, n - i)) / u[0];
+    }
+    return true;
+}
+
+Matrix<double> SymmetricMatrix::ToMatrix(void) const
+{
+    const size_t n = GetLength();
+    if ( IsNull() )
+    {
+        return Matrix<double>();
+    }
+    Matrix<double> m(n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double* row = GetRow(i);
+        for (size_t j = i; j < n; ++j)
+        {
+            m[i][j] = row[j - i];
+            m[j][i] = row[j - i];
+        }
+    }
+    return m;
+}
+
+bool Syrk(SymmetricMatrix& C, const Matrix<double>& A, double alpha, double beta)
+{
+    const size_t n = A.GetRowLength();
+    const size_t K = A.GetColumnLength();
+    if ( A.IsNull() )
+    {
+        return false;
+    }
+    if ( 0 == beta )
+    {
+        if ( C.GetLength() != n && !C.Resize(n) )
+        {
+            return false;
+        }
+        C = 0;
+    }
+    else if ( C.GetLength() != n )
+    {
+        return false;
+    }
+    else if ( 1.0 != beta )
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            double* row = C.GetRow(i);
+            for (size_t j = 0; j < n - i; ++j)
+            {
+                row[j] *= beta;
+            }
+        }
+    }
+
+    // The upper triangle is covered by 2 x 4 tiles, (i, i + 1) x
+    // (j, ..., j + 3) with j >= i, blocked along K and the columns.
+    // The elements of the tiles below the diagonal are discarded.
+    for (size_t kb = 0; kb < K; kb += g_SyrkDepth)
+    {
+        const size_t depth = std::min(g_SyrkDepth, K - kb);
+        for (size_t jb = 0; jb < n; jb += g_SyrkWidth)
+        {
+            const size_t jEnd = std::min(jb + g_SyrkWidth, n);
+            for (size_t i = 0; i < jEnd; i += 2)
+            {
+                const size_t rows = std::min<size_t>(2, n - i);
+                const double* a[2] = { A[i] + kb, A[i + rows - 1] + kb };
+                size_t j = std::max(jb, i - i % 4);
+                for ( ; j + 4 <= jEnd; j += 4)
+                {
+                    const double* b[4] = { A[j] + kb, A[j + 1] + kb, A[j + 2] + kb, A[j + 3] + kb };
+                    double c[2][4];
+                    DotTile(c, a, b, depth);
+                    for (size_t r = 0; r < rows; ++r)
+                    {
+                        for (size_t s = 0; s < 4; ++s)
+                        {
+                            if ( i + r <= j + s )
+                            {
+                                C(i + r, j + s) += alpha * c[r][s];
+                            }
+                        }
+                    }
+                }
+                for ( ; j < jEnd; ++j)
+                {
+                    for (size_t r = 0; r < rows; ++r)
+                    {
+                        if ( i + r <= j )
+                        {
+                            C(i + r, j) += alpha * DotRow(a[r], A[j] + kb, depth);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace mcon {
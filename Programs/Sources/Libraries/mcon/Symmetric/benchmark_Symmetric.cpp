@@ -0,0 +1,68 @@
+
+#include <math.h>
+
+#include "debug.h"
+
+#include "mutl.h"
+#include "mcon.h"
+#include "../TestHelper.h"
+
+void benchmark_Symmetric(void)
+{
+    enum {
+        ID_MULTIPLY,
+        ID_SYRK,
+        NUM_IDS
+    };
+
+    mutl::Stopwatch sw;
+    const int samples[] = { // N x 2N
+         128,
+         256,
+         512,
+        1024,
+    };
+    const unsigned int numPatterns = sizeof(samples) / sizeof(int);
+    double scores[NUM_IDS][numPatterns];
+
+    LOG("Benchmark started.\n");
+    for ( unsigned int i = 0; i < numPatterns; ++i )
+    {
+        const int n = samples[i];
+        LOG("Benchmark with the length of %d ... ", n);
+        mcon::Matrixd A(n, 2 * n);
+        A.Initialize(Element);
+        {
+            sw.Push();
+            const mcon::Matrixd G(A.Multiply(A.T()));
+            scores[ID_MULTIPLY][i] = sw.Tick();
+        }
+        {
+            mcon::SymmetricMatrix C;
+            sw.Push();
+            mcon::Syrk(C, A);
+            scores[ID_SYRK][i] = sw.Tick();
+        }
+        LOG("Done\n");
+    }
+    const char* testNames[NUM_IDS] = {
+        "A.Multiply(A.T())",
+        "Syrk"
+    };
+    printf("Samples [ms]");
+    for ( unsigned int k = 0; k < numPatterns; ++k )
+    {
+        printf(",%d", samples[k]);
+    }
+    printf("\n");
+    for ( int id = 0; id < NUM_IDS; ++id )
+    {
+        printf("%s", testNames[id]);
+        for ( unsigned int k = 0; k < numPatterns; ++k )
+        {
+            printf(",%g", scores[id][k] * 1000);
+        }
+        printf("\n");
+    }
+    LOG("END\n");
+}
@@ -0,0 +1,17 @@
+#include "mcon.h"
+
+extern void test_Symmetric(void);
+extern void benchmark_Symmetric(void);
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 2)
+    {
+        test_Symmetric();
+    }
+    else
+    {
+        benchmark_Symmetric();
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+
+#include <algorithm>
+#include <math.h>
+
+#include "mcon.h"
+#include "../TestHelper.h"
+
+void test_Symmetric(void)
+{
+    LOG("* [Storage]\n");
+    {
+        mcon::SymmetricMatrix S;
+        CHECK_VALUE(S.IsNull(), true);
+        S.Resize(4);
+        CHECK_VALUE(S.GetLength(), 4);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            for (size_t j = i; j < 4; ++j)
+            {
+                S(i, j) = i * 10 + j;
+            }
+        }
+        CHECK_VALUE(S(0, 3), 3);
+        CHECK_VALUE(S(3, 0), 3);
+        CHECK_VALUE(S(2, 1), 12);
+        CHECK_VALUE(S(3, 3), 33);
+        CHECK_VALUE(S.GetRow(2)[1], 23);
+        // Packed rows are contiguous.
+        CHECK_VALUE(S.GetRow(1) - S.GetRow(0), 4);
+        CHECK_VALUE(S.GetRow(3) - S.GetRow(2), 2);
+
+        const mcon::Matrixd m(S.ToMatrix());
+        bool isSymmetric = true;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            for (size_t j = 0; j < 4; ++j)
+            {
+                isSymmetric &= (m[i][j] == S(i, j)) && (m[i][j] == m[j][i]);
+            }
+        }
+        CHECK_VALUE(isSymmetric, true);
+        const mcon::SymmetricMatrix T(m);
+        CHECK_VALUE(GetDifference(T.ToMatrix(), m), 0);
+
+        mcon::Vectord x(4);
+        x.Initialize(Signal);
+        mcon::Vectord y(4);
+        mcon::Gemv(y, m, x);
+        y -= S.Multiply(x);
+        CHECK_VALUE(y.GetMaximumAbsolute(), 0);
+    }
+    LOG("* [Syrk]\n");
+    {
+        // Around the tile and the block boundaries.
+        const size_t rows[] = {1, 2, 3, 5, 8, 13, 64, 67, 130};
+        const size_t columns[] = {1, 7, 600};
+        for (size_t i = 0; i < sizeof(rows)/sizeof(rows[0]); ++i)
+        {
+            for (size_t k = 0; k < sizeof(columns)/sizeof(columns[0]); ++k)
+            {
+                const size_t n = rows[i];
+                const size_t K = columns[k];
+                mcon::Matrixd A(n, K);
+                A.Initialize(Element);
+                mcon::SymmetricMatrix C;
+                const bool status = mcon::Syrk(C, A);
+                LOG("    %dx%d: ", static_cast<int>(n), static_cast<int>(K));
+                CHECK_VALUE(status, true);
+                CHECK_VALUE(GetDifference(C.ToMatrix(), A.Multiply(A.T())), 0);
+            }
+        }
+        // alpha and beta
+        mcon::Matrixd A(10, 20);
+        A.Initialize(Element);
+        mcon::SymmetricMatrix C(10);
+        C = 1.0;
+        bool status = mcon::Syrk(C, A, 2.0, 0.5);
+        CHECK_VALUE(status, true);
+        mcon::Matrixd G(A.Multiply(A.T()) * 2.0);
+        G += 0.5;
+        CHECK_VALUE(GetDifference(C.ToMatrix(), G), 0);
+
+        mcon::SymmetricMatrix D(3);
+        CHECK_VALUE(mcon::Syrk(D, A, 1.0, 1.0), false);
+        mcon::Matrixd E;
+        CHECK_VALUE(mcon::Syrk(D, E), false);
+    }
+    LOG("* [Solve]\n");
+    {
+        const size_t lengths[] = {1, 3, 8, 33};
+        for (size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+        {
+            const size_t n = lengths[i];
+            LOG("    n=%d\n", static_cast<int>(n));
+            mcon::Matrixd A(n, n + 5);
+            A.Initialize(Element);
+            mcon::SymmetricMatrix S;
+            mcon::Syrk(S, A);
+            mcon::Vectord b(n);
+            b.Initialize(Signal);
+            b += 1.0;
+            mcon::Vectord x;
+            const bool status = S.Solve(x, b);
+            CHECK_VALUE(status, true);
+            mcon::Vectord r(b);
+            mcon::Gemv(r, S.ToMatrix(), x, 1.0, -1.0);
+            CHECK_VALUE(r.GetNorm() / b.GetNorm(), 0);
+        }
+        mcon::SymmetricMatrix S(2);
+        S(0, 0) = 1; S(0, 1) = 2; S(1, 1) = 1;
+        mcon::Vectord x;
+        mcon::Vectord b(2);
+        b = 1.0;
+        CHECK_VALUE(S.Solve(x, b), false);
+        mcon::Vectord c(3);
+        CHECK_VALUE(S.Solve(x, c), false);
+    }
+}
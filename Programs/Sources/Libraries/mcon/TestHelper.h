@@ -0,0 +1,86 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <math.h>
+
+#include "debug.h"
+#include "mcon.h"
+
+// Inputs and comparisons shared by the tests of the modules of mcon. This
+// is not installed; the tests include it by the relative path.
+
+namespace {
+
+// A matrix element for Matrix::Initialize().
+inline double Element(size_t i, size_t M, size_t j, size_t N)
+{
+    UNUSED(M);
+    UNUSED(N);
+    return sin(0.37 * (i + 1) * (j + 2)) + cos(0.11 * i * j);
+}
+
+// A signal for Vector::Initialize().
+inline double Signal(size_t k, size_t n)
+{
+    return sin(2.0 * M_PI * 3 * k / n) + 0.5 * cos(2.0 * M_PI * 7 * k / n) + 0.1 * k / n;
+}
+
+// max |a - b|, or -1 for the different sizes.
+inline double GetMaximumDifference(const mcon::Matrixd& a, const mcon::Matrixd& b)
+{
+    if ( a.GetRowLength() != b.GetRowLength() || a.GetColumnLength() != b.GetColumnLength() )
+    {
+        return -1;
+    }
+    double diff = 0;
+    for (size_t i = 0; i < a.GetRowLength(); ++i)
+    {
+        for (size_t j = 0; j < a.GetColumnLength(); ++j)
+        {
+            diff = std::max(diff, fabs(a[i][j] - b[i][j]));
+        }
+    }
+    return diff;
+}
+
+// max |A - B| / max |B|
+inline double GetDifference(const mcon::Matrixd& A, const mcon::Matrixd& B)
+{
+    double difference = 0;
+    double maximum = 0;
+    for (size_t i = 0; i < B.GetRowLength(); ++i)
+    {
+        for (size_t j = 0; j < B.GetColumnLength(); ++j)
+        {
+            difference = std::max(difference, fabs(A[i][j] - B[i][j]));
+            maximum = std::max(maximum, fabs(B[i][j]));
+        }
+    }
+    return difference / maximum;
+}
+
+} // anonymous
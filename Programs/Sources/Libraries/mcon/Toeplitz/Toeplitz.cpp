@@ -0,0 +1,727 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "debug.h"
+#include "mcon.h"
+
+namespace {
+
+const double g_Pi(M_PI);
+
+size_t GetPowerOf2(size_t n)
+{
+    size_t size = 1;
+    while (size < n)
+    {
+        size <<= 1;
+    }
+    return size;
+}
+
+/*--------------------------------------------------------------------
+ * Fourier
+ *
+ * A minimum DFT engine only for the superfast solver. Lengths other
+ * than powers of 2 are handled by Bluestein's algorithm.
+ * masp has FFTs, but mcon can't depend on masp.
+ *--------------------------------------------------------------------*/
+class Fourier
+{
+public:
+    explicit Fourier(size_t length);
+    ~Fourier() {}
+
+    // In-place transform. The inverse one is scaled by 1/length.
+    void Transform(double re[], double im[], bool inverse);
+
+private:
+    void TransformPowerOf2(double re[], double im[], bool inverse) const;
+
+    size_t m_Length;
+    size_t m_Size;
+    mcon::Vector<double> m_Cos;
+    mcon::Vector<double> m_Sin;
+    // For Bluestein's algorithm.
+    mcon::Vector<double> m_ChirpRe;
+    mcon::Vector<double> m_ChirpIm;
+    mcon::Vector<double> m_KernelRe;
+    mcon::Vector<double> m_KernelIm;
+    mcon::Vector<double> m_WorkRe;
+    mcon::Vector<double> m_WorkIm;
+};
+
+Fourier::Fourier(size_t length)
+    : m_Length(length)
+    , m_Size(GetPowerOf2(length))
+    , m_Cos()
+    , m_Sin()
+    , m_ChirpRe()
+    , m_ChirpIm()
+    , m_KernelRe()
+    , m_KernelIm()
+    , m_WorkRe()
+    , m_WorkIm()
+{
+    if (m_Size != m_Length)
+    {
+        // Circular convolution of the length 2n-1 at least.
+        m_Size = GetPowerOf2(2 * m_Length - 1);
+    }
+    m_Cos.Resize(m_Size / 2 + 1);
+    m_Sin.Resize(m_Size / 2 + 1);
+    for (size_t k = 0; k < m_Cos.GetLength(); ++k)
+    {
+        m_Cos[k] = cos(2.0 * g_Pi * k / m_Size);
+        m_Sin[k] = sin(2.0 * g_Pi * k / m_Size);
+    }
+    if (m_Size == m_Length)
+    {
+        return;
+    }
+    const size_t n = m_Length;
+    m_ChirpRe.Resize(n);
+    m_ChirpIm.Resize(n);
+    m_KernelRe.Resize(m_Size);
+    m_KernelIm.Resize(m_Size);
+    m_WorkRe.Resize(m_Size);
+    m_WorkIm.Resize(m_Size);
+    m_KernelRe = 0;
+    m_KernelIm = 0;
+    for (size_t k = 0; k < n; ++k)
+    {
+        // k^2 is reduced by 2n to keep the precision of the argument.
+        const size_t k2 = static_cast<size_t>( (static_cast<uint64_t>(k) * k) % (2 * n) );
+        const double theta = g_Pi * k2 / n;
+        m_ChirpRe[k] = cos(theta);
+        m_ChirpIm[k] = - sin(theta);
+        m_KernelRe[k] = m_ChirpRe[k];
+        m_KernelIm[k] = - m_ChirpIm[k];
+        if (k > 0)
+        {
+            m_KernelRe[m_Size - k] = m_ChirpRe[k];
+            m_KernelIm[m_Size - k] = - m_ChirpIm[k];
+        }
+    }
+    TransformPowerOf2(m_KernelRe, m_KernelIm, false);
+}
+
+void Fourier::TransformPowerOf2(double re[], double im[], bool inverse) const
+{
+    const size_t n = m_Size;
+    // Bit-reverse
+    for (size_t i = 1, j = 0; i < n; ++i)
+    {
+        size_t bit = n >> 1;
+        for ( ; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            const double tr = re[i];
+            const double ti = im[i];
+            re[i] = re[j];
+            im[i] = im[j];
+            re[j] = tr;
+            im[j] = ti;
+        }
+    }
+    // Decimation in time.
+    const double sign = inverse ? 1.0 : -1.0;
+    for (size_t length = 2; length <= n; length <<= 1)
+    {
+        const size_t half = length / 2;
+        const size_t step = n / length;
+        for (size_t i = 0; i < n; i += length)
+        {
+            for (size_t k = 0; k < half; ++k)
+            {
+                const double wr = m_Cos[k * step];
+                const double wi = sign * m_Sin[k * step];
+                const size_t p = i + k;
+                const size_t q = p + half;
+                const double xr = re[q] * wr - im[q] * wi;
+                const double xi = re[q] * wi + im[q] * wr;
+                re[q] = re[p] - xr;
+                im[q] = im[p] - xi;
+                re[p] += xr;
+                im[p] += xi;
+            }
+        }
+    }
+    if (inverse)
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+            re[k] /= n;
+            im[k] /= n;
+        }
+    }
+}
+
+void Fourier::Transform(double re[], double im[], bool inverse)
+{
+    if (m_Size == m_Length)
+    {
+        TransformPowerOf2(re, im, inverse);
+        return;
+    }
+    // Bluestein: X[k] = w[k] * sum_n (x[n] w[n]) conj(w[k-n])
+    // The inverse is done as conj(DFT(conj(x))) / n.
+    const size_t n = m_Length;
+    const double sign = inverse ? -1.0 : 1.0;
+    double* const wr = m_WorkRe;
+    double* const wi = m_WorkIm;
+    m_WorkRe = 0;
+    m_WorkIm = 0;
+    for (size_t k = 0; k < n; ++k)
+    {
+        const double xr = re[k];
+        const double xi = sign * im[k];
+        wr[k] = xr * m_ChirpRe[k] - xi * m_ChirpIm[k];
+        wi[k] = xr * m_ChirpIm[k] + xi * m_ChirpRe[k];
+    }
+    TransformPowerOf2(wr, wi, false);
+    for (size_t k = 0; k < m_Size; ++k)
+    {
+        const double xr = wr[k];
+        const double xi = wi[k];
+        wr[k] = xr * m_KernelRe[k] - xi * m_KernelIm[k];
+        wi[k] = xr * m_KernelIm[k] + xi * m_KernelRe[k];
+    }
+    TransformPowerOf2(wr, wi, true);
+    const double scale = inverse ? 1.0 / n : 1.0;
+    for (size_t k = 0; k < n; ++k)
+    {
+        const double yr = wr[k] * m_ChirpRe[k] - wi[k] * m_ChirpIm[k];
+        const double yi = wr[k] * m_ChirpIm[k] + wi[k] * m_ChirpRe[k];
+        re[k] = yr * scale;
+        im[k] = sign * yi * scale;
+    }
+}
+
+/*--------------------------------------------------------------------
+ * CirculantOperator
+ *
+ * Applies a symmetric circulant matrix (or its inverse) which is
+ * diagonalized by the DFT.
+ *--------------------------------------------------------------------*/
+class CirculantOperator
+{
+public:
+    // column is the first column of the circulant.
+    CirculantOperator(const mcon::VectordBase& column)
+        : m_Fourier(column.GetLength())
+        , m_Eigen(column.GetLength())
+        , m_Re(column.GetLength())
+        , m_Im(column.GetLength())
+    {
+        m_Re = column;
+        m_Im = 0;
+        m_Fourier.Transform(m_Re, m_Im, false);
+        // Eigenvalues are real since the circulant is symmetric.
+        m_Eigen = m_Re;
+    }
+
+    inline const mcon::VectordBase& GetEigenvalues(void) const { return m_Eigen; }
+    inline mcon::VectordBase& GetEigenvalues(void) { return m_Eigen; }
+
+    // y[0:length) = C x[0:length), where x is zero-padded to the order.
+    void Multiply(double y[], const double x[], size_t length, bool inverse)
+    {
+        const size_t n = m_Re.GetLength();
+        m_Re = 0;
+        m_Im = 0;
+        memcpy(m_Re, x, length * sizeof(double));
+        m_Fourier.Transform(m_Re, m_Im, false);
+        if (inverse)
+        {
+            m_Re /= m_Eigen;
+            m_Im /= m_Eigen;
+        }
+        else
+        {
+            m_Re *= m_Eigen;
+            m_Im *= m_Eigen;
+        }
+        m_Fourier.Transform(m_Re, m_Im, true);
+        memcpy(y, m_Re, std::min(n, length) * sizeof(double));
+    }
+
+private:
+    Fourier m_Fourier;
+    mcon::Vector<double> m_Eigen;
+    mcon::Vector<double> m_Re;
+    mcon::Vector<double> m_Im;
+};
+
+} // anonymous
+
+namespace mcon {
+
+Toeplitz::Toeplitz(size_t length)
+    : m_Row(length)
+{
+}
+
+Toeplitz::Toeplitz(const VectordBase& r)
+    : m_Row(r)
+{
+}
+
+Toeplitz::Toeplitz(const Toeplitz& t)
+    : m_Row(t.GetRow())
+{
+}
+
+Toeplitz::~Toeplitz()
+{
+}
+
+Toeplitz& Toeplitz::operator=(const Toeplitz& t)
+{
+    m_Row = t.m_Row;
+    return *this;
+}
+
+bool Toeplitz::Solve(Vector<double>& x, const VectordBase& b) const
+{
+    const size_t n = GetLength();
+    const double* const r = m_Row;
+    if ( 0 == n || b.GetLength() != n || r[0] <= 0 )
+    {
+        return false;
+    }
+    if ( false == x.Resize(n) )
+    {
+        return false;
+    }
+    // Normalized to have 1 on the diagonal.
+    const double scale = 1.0 / r[0];
+    x[0] = b[0] * scale;
+    if (1 == n)
+    {
+        return true;
+    }
+    // y is the solution of the Yule-Walker equation.
+    Vector<double> _y(n);
+    double* const y = _y;
+    double alpha = - r[1] * scale;
+    double beta = 1.0;
+    y[0] = alpha;
+    for (size_t k = 1; k < n; ++k)
+    {
+        beta *= (1.0 - alpha * alpha);
+        if ( beta <= 0 )
+        {
+            // Not positive definite.
+            return false;
+        }
+        double dot = 0;
+        for (size_t j = 0; j < k; ++j)
+        {
+            dot += r[j + 1] * x[k - 1 - j];
+        }
+        const double mu = (b[k] - dot) * scale / beta;
+        for (size_t j = 0; j < k; ++j)
+        {
+            x[j] += mu * y[k - 1 - j];
+        }
+        x[k] = mu;
+
+        if (k == n - 1)
+        {
+            break;
+        }
+        dot = 0;
+        for (size_t j = 0; j < k; ++j)
+        {
+            dot += r[j + 1] * y[k - 1 - j];
+        }
+        alpha = - (r[k + 1] + dot) * scale / beta;
+        // y[j] += alpha * y[k-1-j] in-place, pair by pair.
+        for (size_t j = 0, l = k - 1; j <= l; ++j, --l)
+        {
+            const double yj = y[j];
+            const double yl = y[l];
+            y[j] = yj + alpha * yl;
+            if (j != l)
+            {
+                y[l] = yl + alpha * yj;
+            }
+            if (0 == l)
+            {
+                break;
+            }
+        }
+        y[k] = alpha;
+    }
+    return true;
+}
+
+bool Toeplitz::SolveSuperfast(
+    Vector<double>& x,
+    const VectordBase& b,
+    double tolerance,
+    size_t maxIteration
+) const
+{
+    const size_t n = GetLength();
+    if ( 0 == n || b.GetLength() != n || m_Row[0] <= 0 )
+    {
+        return false;
+    }
+    if ( false == x.Resize(n) )
+    {
+        return false;
+    }
+    if ( 0 == maxIteration )
+    {
+        maxIteration = n;
+    }
+
+    // T is embedded into a circulant of 2^k >= 2n for O(n log n) products.
+    Vector<double> embedded(GetPowerOf2(2 * n));
+    embedded = 0;
+    for (size_t k = 0; k < n; ++k)
+    {
+        embedded[k] = m_Row[k];
+        if (k > 0)
+        {
+            embedded[embedded.GetLength() - k] = m_Row[k];
+        }
+    }
+    CirculantOperator t(embedded);
+
+    // T. Chan's optimal circulant preconditioner.
+    Vector<double> chan(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+        chan[k] = ( (n - k) * m_Row[k] + (k > 0 ? k * m_Row[n - k] : 0) ) / n;
+    }
+    CirculantOperator c(chan);
+    if (c.GetEigenvalues().GetMinimum() <= 0)
+    {
+        // Not applicable, which leaves CG unpreconditioned.
+        c.GetEigenvalues() = 1.0;
+    }
+
+    Vector<double> residual(b);
+    Vector<double> z(n);
+    Vector<double> p(n);
+    Vector<double> q(n);
+
+    x = 0;
+    const double norm = b.GetNorm();
+    if (0 == norm)
+    {
+        return true;
+    }
+    c.Multiply(z, residual, n, true);
+    p = z;
+    double rz = residual.Dot(z);
+    for (size_t iteration = 0; iteration < maxIteration; ++iteration)
+    {
+        t.Multiply(q, p, n, false);
+        const double pq = p.Dot(q);
+        if (pq <= 0)
+        {
+            // Not positive definite.
+            return false;
+        }
+        const double alpha = rz / pq;
+        x += p * alpha;
+        residual -= q * alpha;
+        if (residual.GetNorm() < tolerance * norm)
+        {
+            return true;
+        }
+        c.Multiply(z, residual, n, true);
+        const double rzNext = residual.Dot(z);
+        p *= (rzNext / rz);
+        p += z;
+        rz = rzNext;
+    }
+    return false;
+}
+
+Vector<double> Toeplitz::Multiply(const VectordBase& x) const
+{
+    const size_t n = GetLength();
+    Vector<double> y;
+    if ( x.GetLength() != n )
+    {
+        return y;
+    }
+    y.Resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        double v = 0;
+        for (size_t j = 0; j < n; ++j)
+        {
+            v += (*this)(i, j) * x[j];
+        }
+        y[i] = v;
+    }
+    return y;
+}
+
+Matrix<double> Toeplitz::ToMatrix(void) const
+{
+    const size_t n = GetLength();
+    Matrix<double> m(n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            m[i][j] = (*this)(i, j);
+        }
+    }
+    return m;
+}
+
+ToeplitzOperator::ToeplitzOperator(const VectordBase& u, size_t rowLength, size_t columnLength, bool isHankel)
+    : m_Signal()
+    , m_RowLength(rowLength)
+    , m_ColumnLength(columnLength)
+    , m_IsHankel(isHankel)
+{
+    // Samples which never appear in the matrix are not kept.
+    const size_t length = std::min(u.GetLength(), isHankel ? rowLength + columnLength - 1 : columnLength);
+    if (0 < length && m_Signal.Resize(length))
+    {
+        memcpy(m_Signal, u, length * sizeof(double));
+    }
+}
+
+ToeplitzOperator::ToeplitzOperator(const ToeplitzOperator& t)
+    : m_Signal(t.m_Signal)
+    , m_RowLength(t.m_RowLength)
+    , m_ColumnLength(t.m_ColumnLength)
+    , m_IsHankel(t.m_IsHankel)
+{
+}
+
+ToeplitzOperator::~ToeplitzOperator()
+{
+}
+
+ToeplitzOperator& ToeplitzOperator::operator=(const ToeplitzOperator& t)
+{
+    m_Signal = t.m_Signal;
+    m_RowLength = t.m_RowLength;
+    m_ColumnLength = t.m_ColumnLength;
+    m_IsHankel = t.m_IsHankel;
+    return *this;
+}
+
+Vector<double> ToeplitzOperator::Multiply(const VectordBase& x) const
+{
+    const size_t M = GetRowLength();
+    const size_t N = GetColumnLength();
+    const size_t L = m_Signal.GetLength();
+    Vector<double> y;
+    if ( x.GetLength() != N || false == y.Resize(M) )
+    {
+        return y;
+    }
+    const double* const u = m_Signal;
+    for (size_t m = 0; m < M; ++m)
+    {
+        // Sliding dot product between u and x.
+        double sum = 0;
+        if (m_IsHankel)
+        {
+            const size_t end = m < L ? std::min(N, L - m) : 0;
+            for (size_t n = 0; n < end; ++n)
+            {
+                sum += u[n + m] * x[n];
+            }
+        }
+        else
+        {
+            const size_t end = std::min(N, m + L);
+            for (size_t n = m; n < end; ++n)
+            {
+                sum += u[n - m] * x[n];
+            }
+        }
+        y[m] = sum;
+    }
+    return y;
+}
+
+Vector<double> ToeplitzOperator::MultiplyTransposed(const VectordBase& x) const
+{
+    const size_t M = GetRowLength();
+    const size_t N = GetColumnLength();
+    const size_t L = m_Signal.GetLength();
+    Vector<double> y;
+    if ( x.GetLength() != M || false == y.Resize(N) )
+    {
+        return y;
+    }
+    const double* const u = m_Signal;
+    for (size_t n = 0; n < N; ++n)
+    {
+        double sum = 0;
+        if (m_IsHankel)
+        {
+            const size_t end = n < L ? std::min(M, L - n) : 0;
+            for (size_t m = 0; m < end; ++m)
+            {
+                sum += u[n + m] * x[m];
+            }
+        }
+        else
+        {
+            // Convolution of u and x.
+            const size_t begin = n + 1 > L ? n + 1 - L : 0;
+            const size_t end = std::min(M, n + 1);
+            for (size_t m = begin; m < end; ++m)
+            {
+                sum += u[n - m] * x[m];
+            }
+        }
+        y[n] = sum;
+    }
+    return y;
+}
+
+Matrix<double> ToeplitzOperator::Gram(void) const
+{
+    const size_t M = GetRowLength();
+    const ptrdiff_t N = GetColumnLength();
+    const size_t L = m_Signal.GetLength();
+    Matrix<double> g(M, M);
+    if ( g.IsNull() )
+    {
+        return g;
+    }
+    // The first row is given by sliding dot products.
+    const double* const u = m_Signal;
+    for (size_t j = 0; j < M; ++j)
+    {
+        double sum = 0;
+        if (m_IsHankel)
+        {
+            const size_t end = j < L ? std::min<size_t>(N, L - j) : 0;
+            for (size_t n = 0; n < end; ++n)
+            {
+                sum += u[n] * u[n + j];
+            }
+        }
+        else
+        {
+            const size_t end = std::min<size_t>(N, L);
+            for (size_t n = j; n < end; ++n)
+            {
+                sum += u[n] * u[n - j];
+            }
+        }
+        g[0][j] = sum;
+    }
+    // The others are obtained from the upper-left neighbors.
+    //     Toeplitz: G[i+1][j+1] = G[i][j] - u[N-1-i] * u[N-1-j]
+    //     Hankel  : G[i+1][j+1] = G[i][j] - u[i] * u[j] + u[N+i] * u[N+j]
+    for (size_t i = 0; i + 1 < M; ++i)
+    {
+        const ptrdiff_t _i = i;
+        for (size_t j = i; j + 1 < M; ++j)
+        {
+            const ptrdiff_t _j = j;
+            const double update = m_IsHankel ?
+                GetSample(N + _i) * GetSample(N + _j) - GetSample(_i) * GetSample(_j)
+                : - GetSample(N - 1 - _i) * GetSample(N - 1 - _j);
+            g[i + 1][j + 1] = g[i][j] + update;
+        }
+    }
+    for (size_t i = 1; i < M; ++i)
+    {
+        for (size_t j = 0; j < i; ++j)
+        {
+            g[i][j] = g[j][i];
+        }
+    }
+    return g;
+}
+
+Matrix<double> ToeplitzOperator::Gram(const Diagonal& W) const
+{
+    const size_t M = GetRowLength();
+    const ptrdiff_t N = GetColumnLength();
+    const ptrdiff_t L = m_Signal.GetLength();
+    if ( IsNull() || W.GetLength() != GetColumnLength() )
+    {
+        return Matrix<double>();
+    }
+    // A[i][n] = u[n + s], s = -i for Toeplitz and i for Hankel. The
+    // weights differ along n, so that G[i+1][j+1] doesn't follow from
+    // G[i][j] as Gram() does, and each element of the upper triangle is
+    // summed over the range where both of u are inside.
+    const double* const u = m_Signal;
+    const double* const w = W.GetDiagonal();
+    Matrix<double> g(M, M);
+    for (size_t i = 0; i < M; ++i)
+    {
+        const ptrdiff_t si = m_IsHankel ? static_cast<ptrdiff_t>(i) : - static_cast<ptrdiff_t>(i);
+        for (size_t j = i; j < M; ++j)
+        {
+            const ptrdiff_t sj = m_IsHankel ? static_cast<ptrdiff_t>(j) : - static_cast<ptrdiff_t>(j);
+            const ptrdiff_t begin = std::max<ptrdiff_t>(0, std::max(- si, - sj));
+            const ptrdiff_t end = std::min(N, std::min(L - si, L - sj));
+            double sum = 0;
+            for (ptrdiff_t n = begin; n < end; ++n)
+            {
+                sum += w[n] * u[n + si] * u[n + sj];
+            }
+            g[i][j] = sum;
+            g[j][i] = sum;
+        }
+    }
+    return g;
+}
+
+Matrix<double> ToeplitzOperator::ToMatrix(void) const
+{
+    const size_t M = GetRowLength();
+    const size_t N = GetColumnLength();
+    Matrix<double> m(M, N);
+    for (size_t i = 0; i < M; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            m[i][j] = (*this)(i, j);
+        }
+    }
+    return m;
+}
+
+} // namespace mcon {
@@ -0,0 +1,11 @@
+
+#include "mcon.h"
+
+extern void test_Toeplitz(void);
+
+int main(void)
+{
+    test_Toeplitz();
+
+    return 0;
+}
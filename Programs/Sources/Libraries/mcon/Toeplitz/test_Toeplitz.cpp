@@ -0,0 +1,192 @@
+
+#include <algorithm>
+#include <math.h>
+
+#include "mcon.h"
+#include "../TestHelper.h"
+
+namespace {
+
+// Autocorrelation of an AR(1) process, which is positive definite.
+double Ar1(size_t k, size_t n)
+{
+    UNUSED(n);
+    return pow(0.7, static_cast<double>(k));
+}
+
+// ||T x - b|| / ||b||
+double GetResidual(const mcon::Toeplitz& t, const mcon::VectordBase& x, const mcon::VectordBase& b)
+{
+    mcon::Vectord residual(t.Multiply(x));
+    residual -= b;
+    return residual.GetNorm() / b.GetNorm();
+}
+
+} // anonymous
+
+void test_Toeplitz(void)
+{
+    LOG("* [Empty]\n");
+    {
+        mcon::Toeplitz t;
+        CHECK_VALUE(t.IsNull(), true);
+        CHECK_VALUE(t.GetLength(), 0);
+        mcon::Vectord x;
+        mcon::Vectord b;
+        CHECK_VALUE(t.Solve(x, b), false);
+        CHECK_VALUE(t.SolveSuperfast(x, b), false);
+    }
+    LOG("* [Element]\n");
+    {
+        const size_t n = 5;
+        mcon::Vectord r(n);
+        r.Initialize(Ar1);
+        mcon::Toeplitz t(r);
+        mcon::Matrixd m(t.ToMatrix());
+        CHECK_VALUE(t.GetLength(), n);
+        CHECK_VALUE(m.GetRowLength(), n);
+        CHECK_VALUE(m.GetColumnLength(), n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                const size_t k = i < j ? j - i : i - j;
+                if ( t(i, j) != r[k] || m[i][j] != r[k] )
+                {
+                    CHECK_VALUE(t(i, j), r[k]);
+                    CHECK_VALUE(m[i][j], r[k]);
+                }
+            }
+        }
+        mcon::Vectord x(n);
+        x.Initialize(Signal);
+        mcon::Vectord y(t.Multiply(x));
+        mcon::Matrixd xm(x, true);
+        mcon::Matrixd ym(m.Multiply(xm));
+        for (size_t i = 0; i < n; ++i)
+        {
+            CHECK_VALUE(y[i], ym[i][0]);
+        }
+    }
+    LOG("* [Solve]\n");
+    {
+        const size_t lengths[] = {1, 2, 8, 31, 64, 100};
+        for (size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+        {
+            const size_t n = lengths[i];
+            LOG("    n=%d\n", static_cast<int>(n));
+            mcon::Vectord r(n);
+            r.Initialize(Ar1);
+            r *= 3.0;
+            mcon::Toeplitz t(r);
+            mcon::Vectord b(n);
+            b.Initialize(Signal);
+            b += 1.0;
+
+            mcon::Vectord x;
+            CHECK_VALUE(t.Solve(x, b), true);
+            CHECK_VALUE(x.GetLength(), n);
+            CHECK_VALUE(GetResidual(t, x, b), 0);
+
+            // Compared with the dense inverse.
+            const mcon::Matrixd inv(t.ToMatrix().Inverse());
+            double diff = 0;
+            for (size_t k = 0; k < n; ++k)
+            {
+                diff = std::max(diff, fabs(inv[k].Dot(b) - x[k]));
+            }
+            CHECK_VALUE(diff, 0);
+
+            mcon::Vectord xs;
+            CHECK_VALUE(t.SolveSuperfast(xs, b, 1.0e-12), true);
+            CHECK_VALUE(xs.GetLength(), n);
+            CHECK_VALUE(GetResidual(t, xs, b), 0);
+            xs -= x;
+            CHECK_VALUE(xs.GetMaximumAbsolute(), 0);
+        }
+    }
+    LOG("* [Not positive definite]\n");
+    {
+        mcon::Vectord r(3);
+        r[0] = 1.0;
+        r[1] = 2.0;
+        r[2] = 1.0;
+        mcon::Toeplitz t(r);
+        mcon::Vectord b(3);
+        b = 1.0;
+        mcon::Vectord x;
+        CHECK_VALUE(t.Solve(x, b), false);
+        r[0] = -1.0;
+        t.GetRow() = r;
+        CHECK_VALUE(t.Solve(x, b), false);
+        CHECK_VALUE(t.SolveSuperfast(x, b), false);
+    }
+    LOG("* [ToeplitzOperator]\n");
+    {
+        // (M, N, signal length)
+        const size_t sizes[][3] = { {4, 6, 6}, {5, 12, 20}, {7, 9, 3}, {16, 40, 40} };
+        for (size_t hankel = 0; hankel < 2; ++hankel)
+        {
+            for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+            {
+                const size_t M = sizes[i][0];
+                const size_t N = sizes[i][1];
+                const size_t L = sizes[i][2];
+                LOG("    %s: M=%d, N=%d, L=%d\n", hankel ? "Hankel" : "Toeplitz",
+                    static_cast<int>(M), static_cast<int>(N), static_cast<int>(L));
+                mcon::Vectord u(L);
+                u.Initialize(Signal);
+                const mcon::ToeplitzOperator a(u, M, N, hankel != 0);
+                CHECK_VALUE(a.GetRowLength(), M);
+                CHECK_VALUE(a.GetColumnLength(), N);
+                CHECK_VALUE(a.IsHankel(), hankel != 0);
+
+                const mcon::Matrixd dense(a.ToMatrix());
+                bool isMatched = true;
+                for (size_t m = 0; m < M; ++m)
+                {
+                    for (size_t n = 0; n < N; ++n)
+                    {
+                        const ptrdiff_t k = hankel ? n + m : static_cast<ptrdiff_t>(n) - static_cast<ptrdiff_t>(m);
+                        const double expected = (k < 0 || static_cast<size_t>(k) >= L) ? 0.0 : u[static_cast<size_t>(k)];
+                        isMatched &= (dense[m][n] == expected);
+                    }
+                }
+                CHECK_VALUE(isMatched, true);
+
+                mcon::Vectord x(N);
+                x.Initialize(Ar1);
+                const mcon::Vectord y(a.Multiply(x));
+                const mcon::Matrixd ym(dense.Multiply(mcon::Matrixd(x, true)));
+                CHECK_VALUE(y.GetLength(), M);
+                CHECK_VALUE(GetMaximumDifference(mcon::Matrixd(y, true), ym), 0);
+
+                mcon::Vectord z(M);
+                z.Initialize(Ar1);
+                const mcon::Vectord w(a.MultiplyTransposed(z));
+                const mcon::Matrixd wm(dense.Transpose().Multiply(mcon::Matrixd(z, true)));
+                CHECK_VALUE(w.GetLength(), N);
+                CHECK_VALUE(GetMaximumDifference(mcon::Matrixd(w, true), wm), 0);
+
+                const mcon::Matrixd g(a.Gram());
+                CHECK_VALUE(g.GetRowLength(), M);
+                CHECK_VALUE(g.GetColumnLength(), M);
+                CHECK_VALUE(GetMaximumDifference(g, dense.Multiply(dense.Transpose())), 0);
+
+                const mcon::Diagonal D(x);
+                const mcon::Matrixd gw(a.Gram(D));
+                CHECK_VALUE(gw.GetRowLength(), M);
+                CHECK_VALUE(GetMaximumDifference(gw, D.MultiplyGram(dense)), 0);
+                mcon::Vectord ones(N);
+                ones = 1.0;
+                CHECK_VALUE(GetMaximumDifference(a.Gram(mcon::Diagonal(ones)), g), 0);
+            }
+        }
+        mcon::Vectord u(8);
+        u = 1.0;
+        const mcon::ToeplitzOperator a(u, 3, 8);
+        CHECK_VALUE(a.Multiply(u(0, 7)).IsNull(), true);
+        CHECK_VALUE(a.MultiplyTransposed(u).IsNull(), true);
+        CHECK_VALUE(a.Gram(mcon::Diagonal(u(0, 7))).IsNull(), true);
+    }
+}
@@ -0,0 +1,198 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+#include <x86intrin.h>
+
+#include "debug.h"
+#include "mcon.h"
+#include "../Row.h"
+
+namespace {
+
+    // Applies the rotations of the rank-1 modification to the row u of
+    // U and x, u[k] = (u[k] + sign s x[k]) / c, x[k] = c x[k] - s u[k].
+    inline void RotateRow(double* u, double* x, double c, double s, double sign, size_t n)
+    {
+        const __m256d cv = _mm256_set1_pd(c);
+        const __m256d sv = _mm256_set1_pd(s);
+        const __m256d ssv = _mm256_set1_pd(sign * s);
+        const __m256d rcv = _mm256_set1_pd(1.0 / c);
+        size_t k = 0;
+        for ( ; k + 4 <= n; k += 4)
+        {
+            const __m256d xv = _mm256_loadu_pd(x + k);
+            const __m256d uv = _mm256_mul_pd(_mm256_add_pd(_mm256_loadu_pd(u + k), _mm256_mul_pd(ssv, xv)), rcv);
+            _mm256_storeu_pd(u + k, uv);
+            _mm256_storeu_pd(x + k, _mm256_sub_pd(_mm256_mul_pd(cv, xv), _mm256_mul_pd(sv, uv)));
+        }
+        for ( ; k < n; ++k)
+        {
+            u[k] = (u[k] + sign * s * x[k]) / c;
+            x[k] = c * x[k] - s * u[k];
+        }
+    }
+
+    // Rank-1 modification of U^T U by sign x x^T, which overwrites x.
+    bool Modify(mcon::Matrix<double>& U, double* x, double sign)
+    {
+        const size_t n = U.GetRowLength();
+        for (size_t k = 0; k < n; ++k)
+        {
+            double* u = U[k];
+            const double d = u[k];
+            const double r2 = d * d + sign * x[k] * x[k];
+            if ( !(r2 > 0) )
+            {
+                return false;
+            }
+            const double r = sqrt(r2);
+            const double c = r / d;
+            const double s = x[k] / d;
+            u[k] = r;
+            RotateRow(u + k + 1, x + k + 1, c, s, sign, n - k - 1);
+        }
+        return true;
+    }
+
+} // anonymous
+
+namespace mcon {
+
+Cholesky::Cholesky()
+    : m_Factor()
+{
+}
+
+Cholesky::~Cholesky()
+{
+}
+
+bool Cholesky::Factorize(const Matrix<double>& A)
+{
+    m_Factor.Resize(0, 0);
+    const size_t n = A.GetRowLength();
+    if ( A.IsNull() || n != A.GetColumnLength() )
+    {
+        return false;
+    }
+    Matrix<double> U(n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        double* u = U[i];
+        const double* a = A[i];
+        for (size_t j = 0; j < i; ++j)
+        {
+            u[j] = 0;
+        }
+        for (size_t j = i; j < n; ++j)
+        {
+            u[j] = a[j];
+        }
+    }
+    // Right-looking, where the row k is scaled and subtracted from the
+    // trailing rows, so that all the accesses are along the rows.
+    for (size_t k = 0; k < n; ++k)
+    {
+        double* uk = U[k];
+        if ( !(uk[k] > 0) )
+        {
+            return false;
+        }
+        const double d = sqrt(uk[k]);
+        const double rd = 1.0 / d;
+        uk[k] = d;
+        for (size_t j = k + 1; j < n; ++j)
+        {
+            uk[j] *= rd;
+        }
+        for (size_t i = k + 1; i < n; ++i)
+        {
+            AxpyRow(U[i] + i, -uk[i], uk + i, n - i);
+        }
+    }
+    m_Factor = U;
+    return true;
+}
+
+bool Cholesky::Solve(Vector<double>& x, const VectordBase& b) const
+{
+    const size_t n = GetLength();
+    if ( IsNull() || b.GetLength() != n )
+    {
+        return false;
+    }
+    x = b;
+    double* const px = x;
+    // U^T y = b, column oriented so that U is read along the rows.
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double* u = m_Factor[i];
+        px[i] /= u[i];
+        AxpyRow(px + i + 1, -px[i], u + i + 1, n - i - 1);
+    }
+    // U x = y
+    for (size_t i = n; i > 0; --i)
+    {
+        const double* u = m_Factor[i - 1];
+        px[i - 1] = (px[i - 1] - DotRow(u + i, px + i, n - i)) / u[i - 1];
+    }
+    return true;
+}
+
+bool Cholesky::Update(const VectordBase& x)
+{
+    if ( IsNull() || x.GetLength() != GetLength() )
+    {
+        return false;
+    }
+    Vector<double> work(x);
+    // Always succeeds unless the factor has been broken.
+    return Modify(m_Factor, work, 1.0);
+}
+
+bool Cholesky::Downdate(const VectordBase& x)
+{
+    if ( IsNull() || x.GetLength() != GetLength() )
+    {
+        return false;
+    }
+    // The factor is modified on a copy, since the failure is found
+    // only at the row where the diagonal vanishes.
+    Matrix<double> U(m_Factor);
+    Vector<double> work(x);
+    if ( !Modify(U, work, -1.0) )
+    {
+        return false;
+    }
+    m_Factor = U;
+    return true;
+}
+
+Matrix<double> Cholesky::GetU(void) const
+{
+    return m_Factor;
+}
+
+} // namespace mcon {
@@ -0,0 +1,112 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ryosuke Kanata
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <float.h>
+#include <math.h>
+
+#include "debug.h"
+#include "mcon.h"
+
+namespace mcon {
+
+bool ShermanMorrison(Matrix<double>& B, const VectordBase& u, const VectordBase& v)
+{
+    const size_t n = B.GetRowLength();
+    if ( B.IsNull() || n != B.GetColumnLength() || u.GetLength() != n || v.GetLength() != n )
+    {
+        return false;
+    }
+    // B - (B u) (v^T B) / (1 + v^T B u)
+    Vector<double> w(n);
+    Vector<double> z(n);
+    Gemv(w, B, u);
+    Gemv(z, B.T(), v);
+    const double denominator = 1.0 + v.GetDotProduct(w);
+    if ( !(fabs(denominator) > DBL_EPSILON * (1.0 + fabs(v.GetDotProduct(w)))) )
+    {
+        return false;
+    }
+    return Ger(B, -1.0 / denominator, w, z);
+}
+
+bool Woodbury(Matrix<double>& B, const Matrix<double>& U, const Matrix<double>& V)
+{
+    const size_t n = B.GetRowLength();
+    const size_t k = U.GetRowLength();
+    if ( B.IsNull() || n != B.GetColumnLength()
+        || U.IsNull() || U.GetColumnLength() != n
+        || V.GetRowLength() != k || V.GetColumnLength() != n )
+    {
+        return false;
+    }
+    // With P = B U^T and Q = V B (stored by rows, P^T and Q),
+    // B - P (I + V B U^T)^(-1) Q.
+    Matrix<double> Pt(k, n);
+    Matrix<double> Q(k, n);
+    const TransposedMatrixd Bt = B.T();
+    for (size_t r = 0; r < k; ++r)
+    {
+        Gemv(Pt[r], B, U[r]);
+        Gemv(Q[r], Bt, V[r]);
+    }
+    Matrix<double> S(k, k);
+    for (size_t r = 0; r < k; ++r)
+    {
+        for (size_t s = 0; s < k; ++s)
+        {
+            S[r][s] = ((r == s) ? 1.0 : 0.0) + V[r].GetDotProduct(Pt[s]);
+        }
+    }
+    Lu lu;
+    if ( !lu.Factorize(S) )
+    {
+        return false;
+    }
+    // The columns of S^(-1) Q, solved one by one since k is small.
+    Matrix<double> T(k, n);
+    Vector<double> column(k);
+    Vector<double> solution(k);
+    for (size_t j = 0; j < n; ++j)
+    {
+        for (size_t r = 0; r < k; ++r)
+        {
+            column[r] = Q[r][j];
+        }
+        if ( !lu.Solve(solution, column) )
+        {
+            return false;
+        }
+        for (size_t r = 0; r < k; ++r)
+        {
+            T[r][j] = solution[r];
+        }
+    }
+    for (size_t r = 0; r < k; ++r)
+    {
+        Ger(B, -1.0, Pt[r], T[r]);
+    }
+    return true;
+}
+
+} // namespace mcon {
@@ -0,0 +1,10 @@
+#include "mcon.h"
+
+extern void test_Update(void);
+
+int main(void)
+{
+    test_Update();
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+
+#include <algorithm>
+#include <math.h>
+
+#include "mcon.h"
+#include "../TestHelper.h"
+
+namespace {
+
+// A^T A + I, which is symmetric positive definite.
+mcon::Matrixd MakeSpd(size_t rows, size_t n)
+{
+    mcon::Matrixd A(rows, n);
+    A.Initialize(Element);
+    mcon::Matrixd S(A.T().Multiply(A));
+    for (size_t i = 0; i < n; ++i)
+    {
+        S[i][i] += 1.0;
+    }
+    return S;
+}
+
+} // anonymous
+
+void test_Update(void)
+{
+    LOG("* [Cholesky]\n");
+    {
+        mcon::Cholesky cholesky;
+        CHECK_VALUE(cholesky.IsNull(), true);
+        mcon::Matrixd A(2, 3);
+        A = 1.0;
+        CHECK_VALUE(cholesky.Factorize(A), false);
+        A.Resize(2, 2);
+        A[0][0] = 1; A[0][1] = 2;
+        A[1][0] = 2; A[1][1] = 1;
+        CHECK_VALUE(cholesky.Factorize(A), false);
+        CHECK_VALUE(cholesky.IsNull(), true);
+
+        const size_t lengths[] = {1, 3, 8, 33};
+        for (size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+        {
+            const size_t n = lengths[i];
+            LOG("    n=%d\n", static_cast<int>(n));
+            const mcon::Matrixd S(MakeSpd(n + 5, n));
+            bool status = cholesky.Factorize(S);
+            CHECK_VALUE(status, true);
+            CHECK_VALUE(cholesky.GetLength(), n);
+            const mcon::Matrixd U(cholesky.GetU());
+            CHECK_VALUE(GetDifference(U.T().Multiply(U), S), 0);
+            bool isUpper = true;
+            for (size_t r = 0; r < n; ++r)
+            {
+                for (size_t c = 0; c < r; ++c)
+                {
+                    isUpper &= (0 == U[r][c]);
+                }
+            }
+            CHECK_VALUE(isUpper, true);
+
+            mcon::Vectord b(n);
+            b.Initialize(Signal);
+            b += 1.0;
+            mcon::Vectord x;
+            status = cholesky.Solve(x, b);
+            CHECK_VALUE(status, true);
+            mcon::Vectord r(b);
+            mcon::Gemv(r, S, x, 1.0, -1.0);
+            CHECK_VALUE(r.GetNorm() / b.GetNorm(), 0);
+        }
+    }
+    LOG("* [Update/Downdate]\n");
+    {
+        const size_t n = 24;
+        mcon::Matrixd S(MakeSpd(n + 8, n));
+        mcon::Cholesky cholesky;
+        cholesky.Factorize(S);
+
+        mcon::Vectord x(n);
+        x.Initialize(Signal);
+        bool status = cholesky.Update(x);
+        CHECK_VALUE(status, true);
+        mcon::Syr(S, 1.0, x);
+        mcon::Cholesky direct;
+        direct.Factorize(S);
+        CHECK_VALUE(GetDifference(cholesky.GetU(), direct.GetU()), 0);
+
+        status = cholesky.Downdate(x);
+        CHECK_VALUE(status, true);
+        mcon::Syr(S, -1.0, x);
+        direct.Factorize(S);
+        CHECK_VALUE(GetDifference(cholesky.GetU(), direct.GetU()), 0);
+
+        // Not positive definite, where the factor is kept.
+        const mcon::Matrixd U(cholesky.GetU());
+        mcon::Vectord y(x * 100.0);
+        status = cholesky.Downdate(y);
+        CHECK_VALUE(status, false);
+        CHECK_VALUE(GetDifference(cholesky.GetU(), U), 0);
+
+        mcon::Vectord z(n + 1);
+        CHECK_VALUE(cholesky.Update(z), false);
+        CHECK_VALUE(cholesky.Downdate(z), false);
+    }
+    LOG("* [Sliding window]\n");
+    {
+        // The normal matrix of the rows [t, t + W) of A, advanced by an
+        // update with the new row and a downdate with the old one.
+        const size_t n = 16;
+        const size_t W = 40;
+        const size_t steps = 50;
+        mcon::Matrixd A(W + steps, n);
+        A.Initialize(Element);
+        mcon::Matrixd S(n, n);
+        S = 0.0;
+        for (size_t t = 0; t < W; ++t)
+        {
+            mcon::Syr(S, 1.0, A[t]);
+        }
+        mcon::Cholesky cholesky;
+        bool status = cholesky.Factorize(S);
+        for (size_t t = 0; t < steps; ++t)
+        {
+            status &= cholesky.Update(A[t + W]);
+            status &= cholesky.Downdate(A[t]);
+            mcon::Syr(S, 1.0, A[t + W]);
+            mcon::Syr(S, -1.0, A[t]);
+        }
+        CHECK_VALUE(status, true);
+        const mcon::Matrixd U(cholesky.GetU());
+        CHECK_VALUE(GetDifference(U.T().Multiply(U), S), 0);
+    }
+    LOG("* [ShermanMorrison]\n");
+    {
+        const size_t n = 20;
+        mcon::Matrixd A(n, n);
+        A.Initialize(Element);
+        for (size_t i = 0; i < n; ++i)
+        {
+            A[i][i] += n;
+        }
+        mcon::Matrixd B(A.Inverse());
+        mcon::Vectord u(n);
+        mcon::Vectord v(n);
+        u.Initialize(Signal);
+        for (size_t i = 0; i < n; ++i)
+        {
+            v[i] = cos(0.3 * i);
+        }
+        bool status = mcon::ShermanMorrison(B, u, v);
+        CHECK_VALUE(status, true);
+        mcon::Ger(A, 1.0, u, v);
+        CHECK_VALUE(GetDifference(B, A.Inverse()), 0);
+
+        // A + u v^T is singular if v^T A^(-1) u = -1.
+        mcon::Matrixd I(n, n);
+        I = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            I[i][i] = 1.0;
+        }
+        mcon::Vectord e(n);
+        e = 0.0;
+        e[0] = -1.0;
+        mcon::Vectord f(n);
+        f = 0.0;
+        f[0] = 1.0;
+        const mcon::Matrixd J(I);
+        status = mcon::ShermanMorrison(I, e, f);
+        CHECK_VALUE(status, false);
+        CHECK_VALUE(GetDifference(I, J), 0);
+
+        mcon::Vectord w(n + 1);
+        CHECK_VALUE(mcon::ShermanMorrison(B, w, v), false);
+    }
+    LOG("* [Woodbury]\n");
+    {
+        const size_t n = 30;
+        const size_t ranks[] = {1, 3, 7};
+        for (size_t i = 0; i < sizeof(ranks)/sizeof(ranks[0]); ++i)
+        {
+            const size_t k = ranks[i];
+            LOG("    k=%d\n", static_cast<int>(k));
+            mcon::Matrixd A(n, n);
+            A.Initialize(Element);
+            for (size_t r = 0; r < n; ++r)
+            {
+                A[r][r] += n;
+            }
+            mcon::Matrixd B(A.Inverse());
+            mcon::Matrixd U(k, n);
+            mcon::Matrixd V(k, n);
+            for (size_t r = 0; r < k; ++r)
+            {
+                for (size_t c = 0; c < n; ++c)
+                {
+                    U[r][c] = sin(0.7 * (r + 1) * c);
+                    V[r][c] = cos(0.2 * (r + 2) * c) * (r % 2 ? -1.0 : 1.0);
+                }
+            }
+            bool status = mcon::Woodbury(B, U, V);
+            CHECK_VALUE(status, true);
+            A += U.T().Multiply(V);
+            CHECK_VALUE(GetDifference(B, A.Inverse()), 0);
+        }
+        mcon::Matrixd B(n, n);
+        mcon::Matrixd U(2, n);
+        mcon::Matrixd V(3, n);
+        CHECK_VALUE(mcon::Woodbury(B, U, V), false);
+    }
+}